@@ -0,0 +1,416 @@
+// Microbenchmarks for the hot CPU kernels of the game
+// Built by the bench premake target. The game source is included directly so the kernels run
+// against the real world state (buildings, fences, roads, plants and animals) without exporting
+// main.c internals. Every kernel is warmed up while its batch size is calibrated, then timed over
+// BENCH_SAMPLES batches; the median ns/op, the fastest batch and the throughput are written as
+// JSON (--output, default bench_results.json in resources/) so runs can be diffed across commits.
+// The GPU-backed kernels (mesh uploads, cloud draws) need a GL context: a hidden window is
+// opened, run under Xvfb on machines without a display.
+
+#define FARM_BENCH
+
+#include <time.h>
+
+#include "main.c"
+
+#define BENCH_OUTPUT_FILE "bench_results.json"
+#define BENCH_SEED 1234u
+#define BENCH_SAMPLES 15                 // Timed batches per benchmark, the median is reported
+#define BENCH_MIN_BATCH_TIME 0.01        // Seconds, batches are doubled until they take this long
+#define BENCH_MAX_ITERATIONS (1 << 24)
+#define BENCH_MAX_RESULTS 64
+#define BENCH_QUERY_COUNT 4096           // Power of two, query positions cycled by the lookup kernels
+#define BENCH_FARM_EXTENT 100.0f         // Half size of the farm area entities and queries are placed in
+#define BENCH_MAX_ANIMALS 10000          // Pool sizes, room for the 10k entity runs
+#define BENCH_MAX_PLANTS 12000
+#define BENCH_HERD_SIZE 100000           // Walking animals of the standalone herd timed by BenchHerdKernels()
+
+// Kernel timed by RunBenchmark(), runs the operation iterations times
+typedef void (*BenchKernel)(int iterations);
+
+typedef struct {
+    char name[48];
+    char variant[16];                    // Model or other kernel input, may be empty
+    int entities;                        // Population the kernel runs against, 0 when it has none
+    double itemsPerOp;                   // Vertices, plants, clouds... processed by one operation
+    int iterations;                      // Operations per timed batch
+    double nsPerOp;                      // Median batch
+    double nsPerOpMin;                   // Fastest batch
+} BenchResult;
+
+static BenchResult results[BENCH_MAX_RESULTS] = { 0 };
+static int resultCount = 0;
+static volatile double benchSink = 0.0;  // Kernel outputs, keeps the calls from being optimized out
+
+static Vector3 queryPositions[BENCH_QUERY_COUNT] = { 0 };
+static Model benchModel = { 0 };
+static ModelAnimation benchAnimation = { 0 };
+static int benchFrame = 0;
+static CustomRoad *benchRoad = NULL;
+static Camera benchCamera = { 0 };
+static Herd benchHerd = { 0 };
+
+//----------------------------------------------------------------------------------
+// Harness
+//----------------------------------------------------------------------------------
+
+// Get a wall clock time in seconds
+static double GetBenchTime(void) {
+    struct timespec ts = { 0 };
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec*1e-9;
+}
+
+static int CompareDoubles(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Calibrate (doubles as the cache warmup), time the batches and store the result
+static void RunBenchmark(const char *name, const char *variant, int entities, double itemsPerOp, BenchKernel kernel) {
+    if (resultCount >= BENCH_MAX_RESULTS) return;
+
+    int iterations = 1;
+    for (;;) {
+        double start = GetBenchTime();
+        kernel(iterations);
+        if ((GetBenchTime() - start >= BENCH_MIN_BATCH_TIME) || (iterations >= BENCH_MAX_ITERATIONS)) break;
+        iterations *= 2;
+    }
+
+    double samples[BENCH_SAMPLES] = { 0 };
+    for (int s = 0; s < BENCH_SAMPLES; s++) {
+        double start = GetBenchTime();
+        kernel(iterations);
+        samples[s] = (GetBenchTime() - start)*1e9/iterations;
+    }
+    qsort(samples, BENCH_SAMPLES, sizeof(double), CompareDoubles);
+
+    BenchResult *result = &results[resultCount++];
+    snprintf(result->name, sizeof(result->name), "%s", name);
+    snprintf(result->variant, sizeof(result->variant), "%s", variant);
+    result->entities = entities;
+    result->itemsPerOp = itemsPerOp;
+    result->iterations = iterations;
+    result->nsPerOp = samples[BENCH_SAMPLES/2];
+    result->nsPerOpMin = samples[0];
+}
+
+// Write every result as JSON
+static bool ExportBenchResults(const char *fileName) {
+    FILE *file = fopen(fileName, "w");
+    if (file == NULL) {
+        TraceLog(LOG_WARNING, "BENCH: [%s] Failed to open file for writing", fileName);
+        return false;
+    }
+
+    fprintf(file, "{\n  \"seed\": %u,\n  \"samples\": %d,\n  \"benchmarks\": [\n", BENCH_SEED, BENCH_SAMPLES);
+    for (int i = 0; i < resultCount; i++) {
+        const BenchResult *result = &results[i];
+        fprintf(file, "    { \"name\": \"%s\", \"variant\": \"%s\", \"entities\": %d, \"iterations\": %d, "
+                "\"nsPerOp\": %.2f, \"nsPerOpMin\": %.2f, \"opsPerSec\": %.1f, \"itemsPerOp\": %.0f, \"itemsPerSec\": %.1f }%s\n",
+                result->name, result->variant, result->entities, result->iterations, result->nsPerOp, result->nsPerOpMin,
+                1e9/result->nsPerOp, result->itemsPerOp, result->itemsPerOp*1e9/result->nsPerOp, (i < resultCount - 1) ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+
+    fclose(file);
+    TraceLog(LOG_INFO, "BENCH: [%s] Wrote %d results", fileName, resultCount);
+    return true;
+}
+
+// Print the results as a table (stdout, the log backend would rate limit the lines)
+static void PrintBenchResults(void) {
+    printf("\n%-24s %-8s %8s %14s %16s\n", "benchmark", "variant", "entities", "ns/op", "items/s");
+    for (int i = 0; i < resultCount; i++) {
+        const BenchResult *result = &results[i];
+        printf("%-24s %-8s %8d %14.1f %16.1f\n", result->name, result->variant, result->entities, result->nsPerOp,
+               result->itemsPerOp*1e9/result->nsPerOp);
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Populations
+//----------------------------------------------------------------------------------
+
+// Random position on the farm, drawn from the seeded raylib generator
+static Vector3 GetBenchPosition(void) {
+    return (Vector3){ GetRandomValue(-(int)BENCH_FARM_EXTENT*100, (int)BENCH_FARM_EXTENT*100)/100.0f, 0.0f,
+                      GetRandomValue(-(int)BENCH_FARM_EXTENT*100, (int)BENCH_FARM_EXTENT*100)/100.0f };
+}
+
+// Replace the plants with count trees spread over the farm and register them as colliders
+static void SetBenchTrees(int count) {
+    plantCount = 0;
+    for (int i = 0; i < count; i++) SpawnPlant(PLANT_TREE, GetBenchPosition(), GetRandomValue(80, 150)/100.0f, (float)GetRandomValue(0, 360));
+    RegisterStaticColliders();
+}
+
+// Fill the standalone herd with walking chickens spread over their enclosure
+static void SetBenchHerd(int count) {
+    BoundingBox pen = GetPenBounds(ANIMAL_CHICKEN, 0.1f);
+    benchHerd = LoadHerd(count);
+    for (int i = 0; i < count; i++) {
+        Vector3 position = { pen.min.x + (pen.max.x - pen.min.x)*GetRandomValue(0, 1000)/1000.0f, 0.0f,
+                             pen.min.z + (pen.max.z - pen.min.z)*GetRandomValue(0, 1000)/1000.0f };
+        int slot = AddHerdAnimal(&benchHerd, position, (unsigned int)i + 1);
+        float angle = GetRandomValue(0, 360)*DEG2RAD;
+        benchHerd.dirX[slot] = sinf(angle);
+        benchHerd.dirZ[slot] = cosf(angle);
+        benchHerd.speed[slot] = 0.006f;
+        benchHerd.moving[slot] = 1.0f;
+    }
+}
+
+// Replace the animals with count animals of every species spread over the farm
+static void SetBenchAnimals(int count) {
+    UnloadAnimalResources();
+    for (int i = 0; i < count; i++) SpawnAnimal((AnimalType)(i%ANIMAL_COUNT), GetBenchPosition(), FIXED_TERRAIN_SIZE);
+}
+
+// Put every plant back, ClearPlantsNearRoads() deactivates the ones it removes
+static void ReactivatePlants(void) {
+    for (int i = 0; i < plantCount; i++) plants[i].active = true;
+}
+
+// Free the baked cloud meshes, BuildCloudChunks() allocates a new set every call
+static void ReleaseCloudChunks(void) {
+    for (int i = 0; i < cloudChunkCount; i++) UnloadMesh(cloudChunks[i].mesh);
+    if (cloudChunks != NULL) MemFree(cloudChunks);
+    cloudChunks = NULL;
+    cloudChunkCount = 0;
+}
+
+//----------------------------------------------------------------------------------
+// Kernels
+//----------------------------------------------------------------------------------
+
+// CPU skinning of every mesh plus the vertex buffer upload
+static void BenchUpdateModelAnimation(int iterations) {
+    for (int i = 0; i < iterations; i++) {
+        UpdateModelAnimation(benchModel, benchAnimation, benchFrame);
+        benchFrame = (benchFrame + 1)%benchAnimation.frameCount;
+    }
+}
+
+// CPU skinning with the vertices split over the job pool
+static void BenchUpdateModelAnimationParallel(int iterations) {
+    for (int i = 0; i < iterations; i++) {
+        UpdateModelAnimationParallel(benchModel, benchAnimation, benchFrame);
+        benchFrame = (benchFrame + 1)%benchAnimation.frameCount;
+    }
+}
+
+static void BenchIsCollisionWithBuilding(int iterations) {
+    int hits = 0;
+    for (int i = 0; i < iterations; i++) hits += IsCollisionWithBuilding(queryPositions[i & (BENCH_QUERY_COUNT - 1)], 1.0f, NULL);
+    benchSink += hits;
+}
+
+static void BenchIsCollisionWithAnimal(int iterations) {
+    int hits = 0;
+    for (int i = 0; i < iterations; i++) hits += IsCollisionWithAnimal(queryPositions[i & (BENCH_QUERY_COUNT - 1)], 1.0f, NULL);
+    benchSink += hits;
+}
+
+// The batch kernels of one animal step over the standalone herd (no decisions or collision queries)
+static void BenchHerdKernels(int iterations) {
+    BoundingBox pen = GetPenBounds(ANIMAL_CHICKEN, 0.1f);
+    int bounced = 0;
+    for (int i = 0; i < iterations; i++) {
+        SaveHerdState(&benchHerd);
+        AdvanceHerdTimers(&benchHerd, 0, benchHerd.count, SIMULATION_TIMESTEP);
+        MoveHerd(&benchHerd, 0, benchHerd.count);
+        bounced += ClampHerdToRect(&benchHerd, 0, benchHerd.count, pen.min.x, pen.max.x, pen.min.z, pen.max.z);
+        AdvanceHerdAnimation(&benchHerd, 0, benchHerd.count, 30, 60);
+    }
+    benchSink += bounced;
+}
+
+// One simulation step of every animal: decisions, movement, collisions and grid updates
+static void BenchUpdateAnimals(int iterations) {
+    for (int i = 0; i < iterations; i++) UpdateAnimals(SIMULATION_TIMESTEP);
+}
+
+static void BenchIsPositionOnRoad(int iterations) {
+    int hits = 0;
+    for (int i = 0; i < iterations; i++) hits += IsPositionOnRoad(queryPositions[i & (BENCH_QUERY_COUNT - 1)], roadWidth);
+    benchSink += hits;
+}
+
+static void BenchGetRandomPlantPosition(int iterations) {
+    float sum = 0.0f;
+    for (int i = 0; i < iterations; i++) sum += GetRandomPlantPosition(FIXED_TERRAIN_SIZE).x;
+    benchSink += sum;
+}
+
+// One pass over the startup plants (reactivating them is part of the measured operation)
+static void BenchClearPlantsNearRoads(int iterations) {
+    for (int i = 0; i < iterations; i++) {
+        ReactivatePlants();
+        ClearPlantsNearRoads(3.0f);
+    }
+}
+
+// Rebuild the ribbon mesh of one road (mesh generation, upload and road grid update)
+static void BenchGenerateRoadSegments(int iterations) {
+    for (int i = 0; i < iterations; i++) GenerateRoadSegments(benchRoad, roadWidth, roadTexture);
+}
+
+// Cloud placement (and the shared cloud texture)
+static void BenchInitClouds(int iterations) {
+    for (int i = 0; i < iterations; i++) {
+        InitClouds(FIXED_TERRAIN_SIZE);
+        UnloadTexture(cloudTextures[0]);
+    }
+}
+
+// Cloud batching: bucketing clouds into chunks, merging their boxes and uploading the chunk meshes
+static void BenchBuildCloudChunks(int iterations) {
+    for (int i = 0; i < iterations; i++) {
+        BuildCloudChunks();
+        ReleaseCloudChunks();
+    }
+}
+
+// Per-frame cloud culling and draw submission (GL calls included, GPU time not)
+static void BenchDrawClouds(int iterations) {
+    BeginDrawing();
+    ClearBackground(SKYBLUE);
+    BeginMode3D(benchCamera);
+    Frustum frustum = GetCameraFrustum(benchCamera);
+    for (int i = 0; i < iterations; i++) DrawClouds(benchCamera, &frustum);
+    EndMode3D();
+    EndDrawing();
+}
+
+//----------------------------------------------------------------------------------
+// Main
+//----------------------------------------------------------------------------------
+
+// Total vertices of a model
+static int GetModelVertexCount(Model model) {
+    int count = 0;
+    for (int m = 0; m < model.meshCount; m++) count += model.meshes[m].vertexCount;
+    return count;
+}
+
+int main(int argc, char *argv[])
+{
+    InitLogBackend();
+
+    // --output <file>: JSON results file, relative to resources/
+    // --threads N: job pool workers besides the main thread (default: one per extra core)
+    const char *outputFile = BENCH_OUTPUT_FILE;
+    int jobWorkers = -1;
+    for (int i = 1; i < argc; i++) {
+        if ((strcmp(argv[i], "--output") == 0) && (i + 1 < argc)) outputFile = argv[++i];
+        else if ((strcmp(argv[i], "--threads") == 0) && (i + 1 < argc)) jobWorkers = atoi(argv[++i]);
+        else TraceLog(LOG_WARNING, "Unknown command line argument: %s", argv[i]);
+    }
+
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(640, 360, "VR Farming Simulator - bench");
+    if (!IsWindowReady()) {
+        TraceLog(LOG_ERROR, "BENCH: No GL context available (on machines without a display run under Xvfb)");
+        CloseLogBackend();
+        return 1;
+    }
+    SetRandomSeed(BENCH_SEED);
+    SearchAndSetResourceDir("resources");
+    InitAssetLoader(1);
+    InitJobSystem(jobWorkers);
+
+    // The game's static world: buildings, fences and roads
+    InitEntityPools(BENCH_MAX_ANIMALS, BENCH_MAX_PLANTS, MAX_CLOUDS);
+    InitCollisionGrids();
+    SetupBuildings();
+    SetupCustomRoads();
+    RegisterStaticColliders();
+    for (int i = 0; i < BENCH_QUERY_COUNT; i++) queryPositions[i] = GetBenchPosition();
+
+    benchCamera.position = (Vector3){ 0.0f, HUMAN_HEIGHT, 0.0f };
+    benchCamera.target = (Vector3){ 0.0f, HUMAN_HEIGHT + 0.3f, 1.0f };
+    benchCamera.up = (Vector3){ 0.0f, 1.0f, 0.0f };
+    benchCamera.fovy = 60.0f;
+    benchCamera.projection = CAMERA_PERSPECTIVE;
+
+    // Kernels log from their own code (road and plant passes), keep only warnings while timing
+    SetTraceLogLevel(LOG_WARNING);
+
+    // Animated models
+    const char *animatedModels[][2] = { { "chicken", "animals/walking_chicken.glb" }, { "cow", "animals/walking_cow.glb" } };
+    for (int m = 0; m < 2; m++) {
+        int animCount = 0;
+        benchModel = LoadModelAsset(animatedModels[m][1]);
+        ModelAnimation *anims = LoadModelAnimationsAsset(animatedModels[m][1], &animCount);
+        if ((animCount > 0) && (anims[0].frameCount > 0)) {
+            benchAnimation = anims[0];
+            benchFrame = 0;
+            RunBenchmark("UpdateModelAnimation", animatedModels[m][0], 0, GetModelVertexCount(benchModel), BenchUpdateModelAnimation);
+            RunBenchmark("UpdateModelAnimationParallel", animatedModels[m][0], 0, GetModelVertexCount(benchModel), BenchUpdateModelAnimationParallel);
+        }
+        else TraceLog(LOG_WARNING, "BENCH: [%s] No animation, UpdateModelAnimation skipped", animatedModels[m][1]);
+        if (anims != NULL) UnloadModelAnimations(anims, animCount);
+        UnloadModel(benchModel);
+    }
+
+    // Collision queries against growing populations
+    const int populations[] = { 100, 1000, 10000 };
+    for (int p = 0; p < 3; p++) {
+        SetBenchTrees(populations[p]);
+        RunBenchmark("IsCollisionWithBuilding", "trees", populations[p], 1, BenchIsCollisionWithBuilding);
+    }
+    for (int p = 0; p < 3; p++) {
+        SetBenchAnimals(populations[p]);
+        RunBenchmark("IsCollisionWithAnimal", "", populations[p], 1, BenchIsCollisionWithAnimal);
+    }
+
+    // Animal simulation steps, the penned species crowd into their enclosures over the first steps
+    for (int p = 0; p < 3; p++) {
+        SetBenchAnimals(populations[p]);
+        RunBenchmark("UpdateAnimals", "", populations[p], populations[p], BenchUpdateAnimals);
+    }
+    SetBenchAnimals(0);
+    SetBenchHerd(BENCH_HERD_SIZE);
+    RunBenchmark("HerdKernels", "", BENCH_HERD_SIZE, BENCH_HERD_SIZE, BenchHerdKernels);
+    UnloadHerd(&benchHerd);
+
+    // Road and plant placement, against the startup plants
+    SetBenchTrees(0);
+    SpawnInitialPlants();
+    RegisterStaticColliders();
+    RunBenchmark("IsPositionOnRoad", "", totalCustomRoadsCount, 1, BenchIsPositionOnRoad);
+    RunBenchmark("GetRandomPlantPosition", "", 0, 1, BenchGetRandomPlantPosition);
+    RunBenchmark("ClearPlantsNearRoads", "", plantCount, plantCount, BenchClearPlantsNearRoads);
+
+    // The longest road
+    for (int i = 0; i < totalCustomRoadsCount; i++) {
+        if ((benchRoad == NULL) || (allCustomRoads[i].numPoints > benchRoad->numPoints)) benchRoad = &allCustomRoads[i];
+    }
+    if (benchRoad != NULL) RunBenchmark("GenerateRoadSegments", "", 0, benchRoad->numPoints, BenchGenerateRoadSegments);
+
+    // Clouds
+    RunBenchmark("InitClouds", "", 0, MAX_CLOUDS, BenchInitClouds);
+    InitClouds(FIXED_TERRAIN_SIZE);
+    RunBenchmark("BuildCloudChunks", "", 0, MAX_CLOUDS, BenchBuildCloudChunks);
+    InitCloudRenderer();
+    RunBenchmark("DrawClouds", "", 0, cloudChunkCount, BenchDrawClouds);
+
+    SetTraceLogLevel(LOG_INFO);
+    ExportBenchResults(outputFile);
+
+    UnloadClouds();
+    UnloadAnimalResources();
+    UnloadCollisionGrids();
+    UnloadEntityPools();
+    UnloadRoadGrid();
+    UnloadJobSystem();
+    UnloadAssetLoader();
+    CloseWindow();
+    CloseLogBackend();
+
+    PrintBenchResults();
+    return 0;
+}
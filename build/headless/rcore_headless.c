@@ -0,0 +1,89 @@
+// rcore null platform for the headless simulation target (see premake5.lua)
+// Built from raylib's platforms/rcore_template.c list of platform functions: there is no window,
+// input or GL context, InitWindow() fails and nothing may touch the GPU. What the simulation
+// uses from rcore (random values, timing, file and text helpers, TraceLog) works as usual.
+// The raylib_headless library compiles this file instead of rcore.c, without any PLATFORM_* define.
+
+#include <time.h>
+
+#include "rcore.c"
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition: Window and Graphics Device
+//----------------------------------------------------------------------------------
+bool WindowShouldClose(void) { return true; }
+void ToggleFullscreen(void) { }
+void ToggleBorderlessWindowed(void) { }
+void MaximizeWindow(void) { }
+void MinimizeWindow(void) { }
+void RestoreWindow(void) { }
+void SetWindowState(unsigned int flags) { (void)flags; }
+void ClearWindowState(unsigned int flags) { (void)flags; }
+void SetWindowIcon(Image image) { (void)image; }
+void SetWindowIcons(Image *images, int count) { (void)images; (void)count; }
+void SetWindowTitle(const char *title) { CORE.Window.title = title; }
+void SetWindowPosition(int x, int y) { (void)x; (void)y; }
+void SetWindowMonitor(int monitor) { (void)monitor; }
+void SetWindowMinSize(int width, int height) { (void)width; (void)height; }
+void SetWindowMaxSize(int width, int height) { (void)width; (void)height; }
+void SetWindowSize(int width, int height) { (void)width; (void)height; }
+void SetWindowOpacity(float opacity) { (void)opacity; }
+void SetWindowFocused(void) { }
+void *GetWindowHandle(void) { return NULL; }
+int GetMonitorCount(void) { return 0; }
+int GetCurrentMonitor(void) { return 0; }
+Vector2 GetMonitorPosition(int monitor) { (void)monitor; return (Vector2){ 0 }; }
+int GetMonitorWidth(int monitor) { (void)monitor; return 0; }
+int GetMonitorHeight(int monitor) { (void)monitor; return 0; }
+int GetMonitorPhysicalWidth(int monitor) { (void)monitor; return 0; }
+int GetMonitorPhysicalHeight(int monitor) { (void)monitor; return 0; }
+int GetMonitorRefreshRate(int monitor) { (void)monitor; return 0; }
+const char *GetMonitorName(int monitor) { (void)monitor; return ""; }
+Vector2 GetWindowPosition(void) { return (Vector2){ 0 }; }
+Vector2 GetWindowScaleDPI(void) { return (Vector2){ 1.0f, 1.0f }; }
+void SetClipboardText(const char *text) { (void)text; }
+const char *GetClipboardText(void) { return NULL; }
+Image GetClipboardImage(void) { return (Image){ 0 }; }
+void ShowCursor(void) { CORE.Input.Mouse.cursorHidden = false; }
+void HideCursor(void) { CORE.Input.Mouse.cursorHidden = true; }
+void EnableCursor(void) { CORE.Input.Mouse.cursorHidden = false; }
+void DisableCursor(void) { CORE.Input.Mouse.cursorHidden = true; }
+void SwapScreenBuffer(void) { }
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition: Misc
+//----------------------------------------------------------------------------------
+
+// Get elapsed time in seconds since the first call (monotonic wall clock)
+double GetTime(void) {
+    static double baseTime = -1.0;
+    struct timespec ts = { 0 };
+    timespec_get(&ts, TIME_UTC);
+    double now = (double)ts.tv_sec + (double)ts.tv_nsec*1e-9;
+    if (baseTime < 0.0) baseTime = now;
+    return now - baseTime;
+}
+
+void OpenURL(const char *url) { (void)url; }
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition: Inputs
+//----------------------------------------------------------------------------------
+int SetGamepadMappings(const char *mappings) { (void)mappings; return 0; }
+void SetGamepadVibration(int gamepad, float leftMotor, float rightMotor, float duration) { (void)gamepad; (void)leftMotor; (void)rightMotor; (void)duration; }
+void SetMousePosition(int x, int y) { CORE.Input.Mouse.currentPosition = (Vector2){ (float)x, (float)y }; }
+void SetMouseCursor(int cursor) { CORE.Input.Mouse.cursor = cursor; }
+const char *GetKeyName(int key) { (void)key; return ""; }
+void PollInputEvents(void) { }
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+
+// No display or graphics device, InitWindow() reports the failure and leaves CORE.Window.ready false
+int InitPlatform(void) {
+    TRACELOG(LOG_WARNING, "PLATFORM: Headless build, no window or graphics device available");
+    return -1;
+}
+
+void ClosePlatform(void) { }
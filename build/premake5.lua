@@ -121,6 +121,11 @@ workspace (workspaceName)
         defines { "NDEBUG" }
         optimize "On"
 
+    -- The herd kernels are written for the auto-vectorizer, GCC runs it at -O2 in its cheapest mode
+    -- only (none before GCC 12), which leaves their loops scalar
+    filter { "configurations:Release or Release_RGFW", "files:../src/herd.c", "toolset:gcc" }
+        buildoptions { "-ftree-vectorize", "-fvect-cost-model=dynamic" }
+
     filter { "platforms:x64" }
         architecture "x86_64"
 
@@ -188,6 +193,9 @@ if (downloadRaylib) then
             links {"winmm", "gdi32", "opengl32"}
             libdirs {"../bin/%{cfg.buildcfg}"}
 
+        filter {"system:windows", "action:gmake*"}
+            links {"pthread"}
+
         filter "system:linux"
             links {"pthread", "m", "dl", "rt", "X11"}
 
@@ -227,3 +235,123 @@ if (downloadRaylib) then
             compileas "Objective-C"
 
         filter{}
+
+
+    -- Headless simulation (FARM_HEADLESS): animals, human, hunger/production and the economy at a
+    -- fixed timestep, without a window, GL context or audio device, so it runs on build servers.
+    -- Links raylib on a null platform (headless/rcore_headless.c), no PLATFORM_* define.
+    project (workspaceName .. "_headless")
+        kind "ConsoleApp"
+        location "build_files/"
+        targetdir "../bin/%{cfg.buildcfg}"
+
+        vpaths 
+        {
+            ["Header Files/*"] = { "../include/**.h", "../src/**.h"},
+            ["Source Files/*"] = {"../src/**.c"},
+        }
+        files {"../src/**.c", "../src/**.h", "../include/**.h"}
+
+        includedirs { "../src" }
+        includedirs { "../include" }
+        includedirs {raylib_dir .. "/src" }
+
+        defines {"FARM_HEADLESS", "GRAPHICS_API_OPENGL_33"}
+        links {"raylib_headless"}
+
+        cdialect "C17"
+        flags { "ShadowedVariables"}
+
+        filter "action:vs*"
+            defines{"_WINSOCK_DEPRECATED_NO_WARNINGS", "_CRT_SECURE_NO_WARNINGS"}
+            dependson {"raylib_headless"}
+            links {"raylib_headless.lib"}
+            characterset ("Unicode")
+
+        filter "system:windows"
+            defines{"_WIN32"}
+            links {"winmm"}
+            libdirs {"../bin/%{cfg.buildcfg}"}
+
+        filter {"system:windows", "action:gmake*"}
+            links {"pthread"}
+
+        filter "system:linux"
+            links {"pthread", "m", "dl", "rt"}
+
+        filter "system:macosx"
+            links {"CoreFoundation.framework", "CoreAudio.framework", "AudioToolbox.framework"}
+
+        filter{}
+
+    project "raylib_headless"
+        kind "StaticLib"
+        location "build_files/"
+
+        language "C"
+        targetdir "../bin/%{cfg.buildcfg}"
+
+        defines {"GRAPHICS_API_OPENGL_33"}
+
+        filter "action:vs*"
+            defines{"_WINSOCK_DEPRECATED_NO_WARNINGS", "_CRT_SECURE_NO_WARNINGS"}
+            characterset ("Unicode")
+        filter "system:linux"
+            defines {"_GNU_SOURCE"}
+        filter{}
+
+        includedirs {raylib_dir .. "/src" }
+        files {raylib_dir .. "/src/*.h", raylib_dir .. "/src/*.c", "headless/rcore_headless.c"}
+
+        -- rcore_headless.c includes rcore.c itself, rglfw.c is the GLFW window backend
+        removefiles {raylib_dir .. "/src/rcore.c", raylib_dir .. "/src/rcore_*.c", raylib_dir .. "/src/rglfw.c"}
+
+    -- Microbenchmarks of the hot CPU kernels (bench/bench.c includes src/main.c for its internals),
+    -- results go to bench_results.json. Opens a hidden window for the GL-backed kernels.
+    project "bench"
+        kind "ConsoleApp"
+        location "build_files/"
+        targetdir "../bin/%{cfg.buildcfg}"
+
+        vpaths 
+        {
+            ["Header Files/*"] = { "../include/**.h", "../src/**.h"},
+            ["Source Files/*"] = {"../bench/**.c", "../src/**.c"},
+        }
+        files {"../bench/**.c", "../src/**.c", "../src/**.h", "../include/**.h"}
+        removefiles {"../src/main.c"}
+
+        includedirs { "../src" }
+        includedirs { "../include" }
+        includedirs {raylib_dir .. "/src" }
+        includedirs {raylib_dir .."/src/external" }
+        includedirs { raylib_dir .."/src/external/glfw/include" }
+
+        links {"raylib"}
+
+        cdialect "C17"
+        optimize "Speed"      -- Timings of unoptimized code are meaningless, Debug keeps its symbols
+        platform_defines()
+
+        filter "action:vs*"
+            defines{"_WINSOCK_DEPRECATED_NO_WARNINGS", "_CRT_SECURE_NO_WARNINGS"}
+            dependson {"raylib"}
+            links {"raylib.lib"}
+            characterset ("Unicode")
+            buildoptions { "/Zc:__cplusplus" }
+
+        filter "system:windows"
+            defines{"_WIN32"}
+            links {"winmm", "gdi32", "opengl32"}
+            libdirs {"../bin/%{cfg.buildcfg}"}
+
+        filter {"system:windows", "action:gmake*"}
+            links {"pthread"}
+
+        filter "system:linux"
+            links {"pthread", "m", "dl", "rt", "X11"}
+
+        filter "system:macosx"
+            links {"OpenGL.framework", "Cocoa.framework", "IOKit.framework", "CoreFoundation.framework", "CoreAudio.framework", "CoreVideo.framework", "AudioToolbox.framework"}
+
+        filter{}
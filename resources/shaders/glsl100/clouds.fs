@@ -0,0 +1,11 @@
+#version 100
+
+precision mediump float;
+
+// Input uniform values
+uniform vec4 colDiffuse;
+
+void main()
+{
+    gl_FragColor = colDiffuse;
+}
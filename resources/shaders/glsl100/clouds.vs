@@ -0,0 +1,13 @@
+#version 100
+
+// Input vertex attributes
+attribute vec3 vertexPosition;
+
+// Input uniform values
+uniform mat4 mvp;
+uniform vec3 windOffset;    // Wind drift of the chunk, applied here so the baked vertices never change
+
+void main()
+{
+    gl_Position = mvp*vec4(vertexPosition + windOffset, 1.0);
+}
@@ -0,0 +1,28 @@
+#version 100
+
+precision mediump float;
+
+// Input vertex attributes (from vertex shader)
+varying vec2 fragTexCoord;
+varying vec4 fragColor;
+varying vec3 fragPosition;
+
+// Input uniform values
+uniform sampler2D texture0;
+uniform vec4 colDiffuse;
+uniform vec3 viewPos;
+uniform float fogDensity;
+uniform vec4 fogColor;
+
+void main()
+{
+    vec4 texelColor = texture2D(texture0, fragTexCoord);
+
+    vec4 color = texelColor*colDiffuse*fragColor;
+
+    // Exponential squared distance fog, the same term in every world shader
+    float fogDistance = length(viewPos - fragPosition)*fogDensity;
+    float fogFactor = clamp(exp(-fogDistance*fogDistance), 0.0, 1.0);
+
+    gl_FragColor = vec4(mix(fogColor.rgb, color.rgb, fogFactor), color.a);
+}
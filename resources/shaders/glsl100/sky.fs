@@ -0,0 +1,22 @@
+#version 100
+
+precision mediump float;
+
+// Input vertex attributes (from vertex shader)
+varying vec3 fragDirection;
+
+// Input uniform values
+uniform vec3 zenithColor;
+uniform vec3 horizonColor;
+uniform vec3 groundColor;   // Below the horizon, only seen past the terrain edge
+
+void main()
+{
+    float height = normalize(fragDirection).y;
+
+    // Sky brightens towards the horizon, the ground side fades out quickly below it
+    vec3 sky = mix(horizonColor, zenithColor, sqrt(max(height, 0.0)));
+    vec3 color = mix(sky, groundColor, clamp(-height*8.0, 0.0, 1.0));
+
+    gl_FragColor = vec4(color, 1.0);
+}
@@ -0,0 +1,41 @@
+#version 100
+
+precision mediump float;
+
+// Input vertex attributes (from vertex shader)
+varying vec2 fragTexCoord;
+varying vec4 fragColor;
+varying vec3 fragPosition;
+varying float fragFade;
+
+// Input uniform values
+uniform sampler2D texture0;
+uniform vec4 colDiffuse;
+uniform vec3 viewPos;
+uniform float fogDensity;
+uniform vec4 fogColor;
+
+// Screen space dither threshold in [0, 1) (interleaved gradient noise)
+float GetDither(vec2 position)
+{
+    return fract(52.9829189*fract(dot(position, vec2(0.06711056, 0.00583715))));
+}
+
+void main()
+{
+    // Cross-fade with the impostor: the mesh drops the pixels below the fade
+    if (GetDither(gl_FragCoord.xy) < fragFade) discard;
+
+    vec4 texelColor = texture2D(texture0, fragTexCoord);
+
+    // Alpha cutout for leaf cards, instances are drawn unsorted
+    if (texelColor.a*colDiffuse.a < 0.1) discard;
+
+    vec4 color = texelColor*colDiffuse*fragColor;
+
+    // Exponential squared distance fog, the same term in every world shader
+    float fogDistance = length(viewPos - fragPosition)*fogDensity;
+    float fogFactor = clamp(exp(-fogDistance*fogDistance), 0.0, 1.0);
+
+    gl_FragColor = vec4(mix(fogColor.rgb, color.rgb, fogFactor), color.a);
+}
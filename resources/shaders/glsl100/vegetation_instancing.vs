@@ -0,0 +1,31 @@
+#version 100
+
+// Input vertex attributes
+attribute vec3 vertexPosition;
+attribute vec2 vertexTexCoord;
+attribute vec4 vertexColor;
+
+// Per-instance world transform, the bottom row holds the impostor cross-fade in x (see DrawPlants())
+attribute mat4 instanceTransform;
+
+// Input uniform values
+uniform mat4 mvp;
+
+// Output vertex attributes (to fragment shader)
+varying vec2 fragTexCoord;
+varying vec4 fragColor;
+varying vec3 fragPosition;    // World position, for the fog
+varying float fragFade;       // Share of the pixels handed over to the impostor
+
+void main()
+{
+    mat4 transform = instanceTransform;
+    fragFade = transform[0][3];
+    transform[0][3] = 0.0;
+
+    fragTexCoord = vertexTexCoord;
+    fragColor = vertexColor;
+    fragPosition = vec3(transform*vec4(vertexPosition, 1.0)); // Instance transforms are world transforms
+
+    gl_Position = mvp*transform*vec4(vertexPosition, 1.0);
+}
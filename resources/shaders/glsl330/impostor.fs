@@ -0,0 +1,41 @@
+#version 330
+
+// Input vertex attributes (from vertex shader)
+in vec2 fragTexCoord;
+in vec3 fragPosition;
+in float fragFade;
+
+// Input uniform values
+uniform sampler2D texture0;
+uniform vec4 colDiffuse;
+uniform vec3 viewPos;
+uniform float fogDensity;
+uniform vec4 fogColor;
+
+// Output fragment color
+out vec4 finalColor;
+
+// Screen space dither threshold in [0, 1) (interleaved gradient noise)
+float GetDither(vec2 position)
+{
+    return fract(52.9829189*fract(dot(position, vec2(0.06711056, 0.00583715))));
+}
+
+void main()
+{
+    // Cross-fade with the mesh: the impostor keeps the pixels the mesh dropped
+    if (GetDither(gl_FragCoord.xy) >= fragFade) discard;
+
+    vec4 texelColor = texture(texture0, fragTexCoord);
+
+    // Alpha cutout, the atlas is cleared transparent around the captured views
+    if (texelColor.a*colDiffuse.a < 0.1) discard;
+
+    vec4 color = texelColor*colDiffuse;
+
+    // Exponential squared distance fog, the same term in every world shader
+    float fogDistance = length(viewPos - fragPosition)*fogDensity;
+    float fogFactor = clamp(exp(-fogDistance*fogDistance), 0.0, 1.0);
+
+    finalColor = vec4(mix(fogColor.rgb, color.rgb, fogFactor), color.a);
+}
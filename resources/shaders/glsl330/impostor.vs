@@ -0,0 +1,32 @@
+#version 330
+
+// Input vertex attributes
+in vec3 vertexPosition;
+in vec2 vertexTexCoord;
+
+// Per-instance world transform of the billboard, the bottom row holds the cross-fade in x and
+// the atlas view in y (see GetImpostorTransform())
+in mat4 instanceTransform;
+
+// Input uniform values
+uniform mat4 mvp;
+uniform float viewCount;  // Views side by side in the atlas
+
+// Output vertex attributes (to fragment shader)
+out vec2 fragTexCoord;
+out vec3 fragPosition;    // World position, for the fog
+out float fragFade;       // Share of the pixels drawn by the impostor
+
+void main()
+{
+    mat4 transform = instanceTransform;
+    fragFade = transform[0][3];
+    float view = transform[1][3];
+    transform[0][3] = 0.0;
+    transform[1][3] = 0.0;
+
+    fragTexCoord = vec2((view + vertexTexCoord.x)/viewCount, vertexTexCoord.y);
+    fragPosition = vec3(transform*vec4(vertexPosition, 1.0)); // Instance transforms are world transforms
+
+    gl_Position = mvp*transform*vec4(vertexPosition, 1.0);
+}
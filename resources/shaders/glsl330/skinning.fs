@@ -0,0 +1,29 @@
+#version 330
+
+// Input vertex attributes (from vertex shader)
+in vec2 fragTexCoord;
+in vec4 fragColor;
+in vec3 fragPosition;
+
+// Input uniform values
+uniform sampler2D texture0;
+uniform vec4 colDiffuse;
+uniform vec3 viewPos;
+uniform float fogDensity;
+uniform vec4 fogColor;
+
+// Output fragment color
+out vec4 finalColor;
+
+void main()
+{
+    vec4 texelColor = texture(texture0, fragTexCoord);
+
+    vec4 color = texelColor*colDiffuse*fragColor;
+
+    // Exponential squared distance fog, the same term in every world shader
+    float fogDistance = length(viewPos - fragPosition)*fogDensity;
+    float fogFactor = clamp(exp(-fogDistance*fogDistance), 0.0, 1.0);
+
+    finalColor = vec4(mix(fogColor.rgb, color.rgb, fogFactor), color.a);
+}
@@ -0,0 +1,16 @@
+#version 330
+
+// Input vertex attributes
+in vec3 vertexPosition;
+
+// Input uniform values
+uniform mat4 mvp;
+
+// Output vertex attributes (to fragment shader)
+out vec3 fragDirection;     // View direction, the dome is centered on the camera
+
+void main()
+{
+    fragDirection = vertexPosition;
+    gl_Position = mvp*vec4(vertexPosition, 1.0);
+}
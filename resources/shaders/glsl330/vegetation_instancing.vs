@@ -0,0 +1,31 @@
+#version 330
+
+// Input vertex attributes
+in vec3 vertexPosition;
+in vec2 vertexTexCoord;
+in vec4 vertexColor;
+
+// Per-instance world transform, the bottom row holds the impostor cross-fade in x (see DrawPlants())
+in mat4 instanceTransform;
+
+// Input uniform values
+uniform mat4 mvp;
+
+// Output vertex attributes (to fragment shader)
+out vec2 fragTexCoord;
+out vec4 fragColor;
+out vec3 fragPosition;    // World position, for the fog
+out float fragFade;       // Share of the pixels handed over to the impostor
+
+void main()
+{
+    mat4 transform = instanceTransform;
+    fragFade = transform[0][3];
+    transform[0][3] = 0.0;
+
+    fragTexCoord = vertexTexCoord;
+    fragColor = vertexColor;
+    fragPosition = vec3(transform*vec4(vertexPosition, 1.0)); // Instance transforms are world transforms
+
+    gl_Position = mvp*transform*vec4(vertexPosition, 1.0);
+}
@@ -0,0 +1,486 @@
+#include "asset_loader.h"
+#include "model_cache.h"
+#include "trace_capture.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// Web builds have no worker threads, UpdateAssetLoader() does the CPU work itself
+#if defined(PLATFORM_WEB)
+    #define ASSET_LOADER_THREADS 0
+#else
+    #define ASSET_LOADER_THREADS 1
+    #if defined(_MSC_VER)
+        #include <threads.h>
+    #else
+        #include <pthread.h>
+    #endif
+#endif
+
+#define MAX_ASSET_REQUESTS 64
+#define MAX_ASSET_WORKERS 8
+#define MAX_ASSET_FILENAME_LENGTH 256
+
+typedef enum {
+    ASSET_STATE_QUEUED = 0,  // Waiting for a worker
+    ASSET_STATE_LOADING,     // CPU work in progress on a worker
+    ASSET_STATE_DECODED,     // CPU work done, waiting for the main thread
+    ASSET_STATE_READY,       // Finished, can be taken by the game
+    ASSET_STATE_FAILED       // CPU work failed, Load*Asset() falls back to the synchronous load
+} AssetState;
+
+typedef struct {
+    char fileName[MAX_ASSET_FILENAME_LENGTH];
+    AssetType type;
+    AssetState state;
+
+    unsigned char *fileData;     // Raw file, served to LoadModel() through the file data callback
+    int fileDataSize;
+    Image image;                 // ASSET_TEXTURE, until uploaded
+    Wave wave;                   // ASSET_SOUND, kept until the loader is unloaded
+
+    Texture2D texture;
+    Model model;
+    ModelAnimation *anims;
+    int animCount;
+    bool assetTaken;             // Texture or model taken by the game
+    bool animsTaken;
+} AssetRequest;
+
+static AssetRequest requests[MAX_ASSET_REQUESTS] = { 0 };
+static int requestCount = 0;
+
+#if ASSET_LOADER_THREADS
+#if defined(_MSC_VER)
+static thrd_t workers[MAX_ASSET_WORKERS];
+static mtx_t loaderMutex;
+static cnd_t loaderWork;
+static bool loaderSyncCreated = false;  // Created once and never destroyed, like the static pthread objects below
+#define LockLoader() mtx_lock(&loaderMutex)
+#define UnlockLoader() mtx_unlock(&loaderMutex)
+#define WaitForWork() cnd_wait(&loaderWork, &loaderMutex)
+#define SignalWork() cnd_broadcast(&loaderWork)
+#else
+static pthread_t workers[MAX_ASSET_WORKERS];
+static pthread_mutex_t loaderMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t loaderWork = PTHREAD_COND_INITIALIZER;
+#define LockLoader() pthread_mutex_lock(&loaderMutex)
+#define UnlockLoader() pthread_mutex_unlock(&loaderMutex)
+#define WaitForWork() pthread_cond_wait(&loaderWork, &loaderMutex)
+#define SignalWork() pthread_cond_broadcast(&loaderWork)
+#endif
+static int workerCount = 0;
+static bool loaderStopping = false;
+#else
+#define LockLoader()
+#define UnlockLoader()
+#define SignalWork()
+#endif
+
+// Read a whole file from disk (thread safe, does not go through the raylib file data callback)
+static unsigned char *ReadFileBytes(const char *fileName, int *dataSize) {
+    unsigned char *data = NULL;
+    *dataSize = 0;
+
+    FILE *file = fopen(fileName, "rb");
+    if (file == NULL) return NULL;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    if (size > 0) {
+        data = (unsigned char *)MemAlloc((unsigned int)size);
+        if ((data != NULL) && (fread(data, 1, (size_t)size, file) == (size_t)size)) *dataSize = (int)size;
+        else {
+            MemFree(data);
+            data = NULL;
+        }
+    }
+
+    fclose(file);
+    return data;
+}
+
+// File data callback: serve the files already read by the workers from memory.
+// raylib frees the returned buffer with UnloadFileData(), so a copy is returned.
+static unsigned char *LoadAssetFileData(const char *fileName, int *dataSize) {
+    unsigned char *data = NULL;
+    *dataSize = 0;
+
+    LockLoader();
+    for (int i = 0; i < requestCount; i++) {
+        if ((requests[i].fileData == NULL) || (strcmp(requests[i].fileName, fileName) != 0)) continue;
+
+        data = (unsigned char *)MemAlloc(requests[i].fileDataSize);
+        if (data != NULL) {
+            memcpy(data, requests[i].fileData, requests[i].fileDataSize);
+            *dataSize = requests[i].fileDataSize;
+        }
+        break;
+    }
+    UnlockLoader();
+
+    if (data == NULL) data = ReadFileBytes(fileName, dataSize);
+    if (data == NULL) TraceLog(LOG_WARNING, "FILEIO: [%s] Failed to open file", fileName);
+
+    return data;
+}
+
+// Find the request of a file, -1 if it was never requested
+static int FindRequest(const char *fileName) {
+    for (int i = 0; i < requestCount; i++) {
+        if (strcmp(requests[i].fileName, fileName) == 0) return i;
+    }
+    return -1;
+}
+
+// CPU side of loading an asset (runs on a worker)
+static void ProcessRequest(AssetRequest *request) {
+    double startTime = GetTime();
+    int dataSize = 0;
+    unsigned char *data = ReadFileBytes(request->fileName, &dataSize);
+    const char *fileType = GetFileExtension(request->fileName);
+
+    Image image = { 0 };
+    Wave wave = { 0 };
+    ModelAnimation *anims = NULL;
+    int animCount = 0;
+    bool success = (data != NULL);
+
+    if (success) {
+        switch (request->type) {
+            case ASSET_TEXTURE:
+                image = LoadImageFromMemory(fileType, data, dataSize);
+                success = (image.data != NULL);
+                MemFree(data);
+                data = NULL;
+                break;
+            case ASSET_SOUND:
+                wave = LoadWaveFromMemory(fileType, data, dataSize);
+                success = (wave.data != NULL);
+                MemFree(data);
+                data = NULL;
+                break;
+            case ASSET_ANIMATED_MODEL:
+                // Publish the file first, LoadModelAnimations() reads it back through the callback
+                LockLoader();
+                request->fileData = data;
+                request->fileDataSize = dataSize;
+                UnlockLoader();
+                anims = LoadModelAnimationsCached(request->fileName, &animCount);
+                break;
+            default: break;
+        }
+    }
+
+    LockLoader();
+    request->fileData = data;
+    request->fileDataSize = dataSize;
+    request->image = image;
+    request->wave = wave;
+    request->anims = anims;
+    request->animCount = animCount;
+    if (!success) request->state = ASSET_STATE_FAILED;
+    else request->state = (request->type == ASSET_SOUND) ? ASSET_STATE_READY : ASSET_STATE_DECODED;
+    UnlockLoader();
+
+    TraceSpan(request->fileName, "load", startTime, GetTime());
+}
+
+// GPU side of loading an asset (runs on the main thread)
+static void FinishRequest(AssetRequest *request) {
+    double startTime = GetTime();
+
+    switch (request->type) {
+        case ASSET_TEXTURE:
+            request->texture = LoadTextureFromImage(request->image);
+            UnloadImage(request->image);
+            request->image = (Image){ 0 };
+            break;
+        case ASSET_MODEL:
+        case ASSET_ANIMATED_MODEL:
+            // On a cache miss glTF parsing and embedded image decoding happen here too, raylib only exposes them together with the upload
+            request->model = LoadModelCached(request->fileName);
+            break;
+        default: break;
+    }
+
+    LockLoader();
+    MemFree(request->fileData);
+    request->fileData = NULL;
+    request->fileDataSize = 0;
+    request->state = ASSET_STATE_READY;
+    UnlockLoader();
+
+    TraceSpan(request->fileName, "upload", startTime, GetTime());
+}
+
+#if ASSET_LOADER_THREADS
+// Worker loop: take queued requests until the loader is unloaded
+static void RunAssetWorker(void) {
+    SetTraceThreadName("Asset worker");
+
+    for (;;) {
+        LockLoader();
+        int index = -1;
+        for (;;) {
+            for (int i = 0; i < requestCount; i++) {
+                if (requests[i].state == ASSET_STATE_QUEUED) {
+                    index = i;
+                    break;
+                }
+            }
+            if ((index != -1) || loaderStopping) break;
+            WaitForWork();
+        }
+
+        if (index == -1) {
+            UnlockLoader();
+            return;
+        }
+
+        requests[index].state = ASSET_STATE_LOADING;
+        UnlockLoader();
+
+        ProcessRequest(&requests[index]);
+    }
+}
+
+#if defined(_MSC_VER)
+static int AssetWorkerMain(void *arg) { (void)arg; RunAssetWorker(); return 0; }
+#else
+static void *AssetWorkerMain(void *arg) { (void)arg; RunAssetWorker(); return NULL; }
+#endif
+#endif
+
+// Start the worker threads (no threads on web, work is done in UpdateAssetLoader)
+void InitAssetLoader(int count) {
+    SetLoadFileDataCallback(LoadAssetFileData);
+
+#if ASSET_LOADER_THREADS
+#if defined(_MSC_VER)
+    if (!loaderSyncCreated) {
+        mtx_init(&loaderMutex, mtx_plain);
+        cnd_init(&loaderWork);
+        loaderSyncCreated = true;
+    }
+#endif
+    loaderStopping = false;
+    if (count < 1) count = 1;
+    if (count > MAX_ASSET_WORKERS) count = MAX_ASSET_WORKERS;
+
+    for (workerCount = 0; workerCount < count; workerCount++) {
+#if defined(_MSC_VER)
+        bool started = (thrd_create(&workers[workerCount], AssetWorkerMain, NULL) == thrd_success);
+#else
+        bool started = (pthread_create(&workers[workerCount], NULL, AssetWorkerMain, NULL) == 0);
+#endif
+        if (!started) {
+            TraceLog(LOG_WARNING, "ASSETS: Failed to start worker %d", workerCount);
+            break;
+        }
+    }
+
+    // Without any worker the requests are processed on the main thread, see UpdateAssetLoader()
+    TraceLog(LOG_INFO, "ASSETS: Background loader started with %d workers", workerCount);
+#else
+    (void)count;
+    TraceLog(LOG_INFO, "ASSETS: Background loader started without workers");
+#endif
+}
+
+// Stop the workers and free everything not taken by the game
+void UnloadAssetLoader(void) {
+#if ASSET_LOADER_THREADS
+    LockLoader();
+    loaderStopping = true;
+    SignalWork();
+    UnlockLoader();
+
+    for (int i = 0; i < workerCount; i++) {
+#if defined(_MSC_VER)
+        thrd_join(workers[i], NULL);
+#else
+        pthread_join(workers[i], NULL);
+#endif
+    }
+    workerCount = 0;
+    // The mutex stays valid, the Load*Asset() fallbacks still lock it for assets loaded after startup
+#endif
+
+    int unusedCount = 0;
+    for (int i = 0; i < requestCount; i++) {
+        AssetRequest *request = &requests[i];
+        if ((request->state == ASSET_STATE_READY) && !request->assetTaken && (request->type != ASSET_SOUND)) {
+            TraceLog(LOG_DEBUG, "ASSETS: [%s] Requested but never used", request->fileName);
+            unusedCount++;
+        }
+
+        if (!request->assetTaken) {
+            if (request->texture.id > 0) UnloadTexture(request->texture);
+            if (request->model.meshCount > 0) UnloadModel(request->model);
+        }
+        if (!request->animsTaken && (request->anims != NULL)) UnloadModelAnimations(request->anims, request->animCount);
+        if (request->image.data != NULL) UnloadImage(request->image);
+        if (request->wave.data != NULL) UnloadWave(request->wave);
+        MemFree(request->fileData);
+    }
+
+    if (unusedCount > 0) TraceLog(LOG_WARNING, "ASSETS: %d requested assets were never used", unusedCount);
+
+    memset(requests, 0, sizeof(requests));
+    requestCount = 0;
+    SetLoadFileDataCallback(NULL);
+}
+
+// Queue an asset for background loading
+void RequestAsset(const char *fileName, AssetType type) {
+    LockLoader();
+    if ((requestCount < MAX_ASSET_REQUESTS) && (FindRequest(fileName) == -1)) {
+        AssetRequest *request = &requests[requestCount];
+        memset(request, 0, sizeof(AssetRequest));
+        snprintf(request->fileName, sizeof(request->fileName), "%s", fileName);
+        request->type = type;
+        request->state = ASSET_STATE_QUEUED;
+        requestCount++;
+        SignalWork();
+    }
+    else if (requestCount == MAX_ASSET_REQUESTS) TraceLog(LOG_WARNING, "ASSETS: [%s] Request queue full, asset will load synchronously", fileName);
+    UnlockLoader();
+}
+
+// Finish decoded assets on the main thread, for about timeBudget seconds
+void UpdateAssetLoader(double timeBudget) {
+    double startTime = GetTime();
+
+    for (int i = 0; i < requestCount; i++) {
+        LockLoader();
+        AssetState state = requests[i].state;
+#if ASSET_LOADER_THREADS
+        bool processHere = (state == ASSET_STATE_QUEUED) && (workerCount == 0);
+#else
+        bool processHere = (state == ASSET_STATE_QUEUED);
+#endif
+        if (processHere) requests[i].state = ASSET_STATE_LOADING;
+        UnlockLoader();
+
+        if (processHere) {
+            ProcessRequest(&requests[i]);
+            LockLoader();
+            state = requests[i].state;
+            UnlockLoader();
+        }
+        if (state == ASSET_STATE_DECODED) FinishRequest(&requests[i]);
+
+        // At least one asset is finished per call, a single large upload may exceed the budget
+        if (processHere || (state == ASSET_STATE_DECODED)) {
+            if ((GetTime() - startTime) >= timeBudget) break;
+        }
+    }
+}
+
+// Get the loaded fraction of the requested assets [0..1]
+float GetAssetLoaderProgress(void) {
+    if (requestCount == 0) return 1.0f;
+
+    float progress = 0.0f;
+    LockLoader();
+    for (int i = 0; i < requestCount; i++) {
+        switch (requests[i].state) {
+            case ASSET_STATE_LOADING: progress += 0.25f; break;
+            case ASSET_STATE_DECODED: progress += 0.5f; break;
+            case ASSET_STATE_READY:
+            case ASSET_STATE_FAILED: progress += 1.0f; break;
+            default: break;
+        }
+    }
+    UnlockLoader();
+
+    return progress/requestCount;
+}
+
+// Check if every requested asset is finished (or failed)
+bool IsAssetLoaderDone(void) {
+    bool done = true;
+    LockLoader();
+    for (int i = 0; (i < requestCount) && done; i++) {
+        done = (requests[i].state == ASSET_STATE_READY) || (requests[i].state == ASSET_STATE_FAILED);
+    }
+    UnlockLoader();
+
+    return done;
+}
+
+#if defined(FARM_HEADLESS)
+// Headless simulation: no GL context or audio device, every asset comes back empty and the
+// game keeps only the positions, scales and collision data of the things it loads
+Texture2D LoadTextureAsset(const char *fileName) { (void)fileName; return (Texture2D){ 0 }; }
+Model LoadModelAsset(const char *fileName) { (void)fileName; return (Model){ 0 }; }
+ModelAnimation *LoadModelAnimationsAsset(const char *fileName, int *animCount) { (void)fileName; *animCount = 0; return NULL; }
+Sound LoadSoundAsset(const char *fileName) { (void)fileName; return (Sound){ 0 }; }
+#else
+// Take a preloaded texture (or LoadTexture())
+Texture2D LoadTextureAsset(const char *fileName) {
+    double startTime = GetTime();
+    LockLoader();
+    int index = FindRequest(fileName);
+    bool ready = (index != -1) && (requests[index].state == ASSET_STATE_READY) && !requests[index].assetTaken && (requests[index].texture.id > 0);
+    if (ready) requests[index].assetTaken = true;
+    UnlockLoader();
+
+    Texture2D texture = ready ? requests[index].texture : LoadTexture(fileName);
+    TraceSpan(fileName, ready ? "take" : "load", startTime, GetTime());
+    return texture;
+}
+
+// Take a preloaded model (or LoadModelCached())
+Model LoadModelAsset(const char *fileName) {
+    double startTime = GetTime();
+    LockLoader();
+    int index = FindRequest(fileName);
+    bool ready = (index != -1) && (requests[index].state == ASSET_STATE_READY) && !requests[index].assetTaken &&
+                 ((requests[index].type == ASSET_MODEL) || (requests[index].type == ASSET_ANIMATED_MODEL));
+    if (ready) requests[index].assetTaken = true;
+    UnlockLoader();
+
+    Model model = ready ? requests[index].model : LoadModelCached(fileName);
+    TraceSpan(fileName, ready ? "take" : "load", startTime, GetTime());
+    return model;
+}
+
+// Take preloaded animations (or LoadModelAnimationsCached())
+ModelAnimation *LoadModelAnimationsAsset(const char *fileName, int *animCount) {
+    double startTime = GetTime();
+    LockLoader();
+    int index = FindRequest(fileName);
+    bool ready = (index != -1) && ((requests[index].state == ASSET_STATE_DECODED) || (requests[index].state == ASSET_STATE_READY)) &&
+                 !requests[index].animsTaken && (requests[index].type == ASSET_ANIMATED_MODEL);
+    if (ready) requests[index].animsTaken = true;
+    UnlockLoader();
+
+    ModelAnimation *anims = NULL;
+    if (ready) {
+        *animCount = requests[index].animCount;
+        anims = requests[index].anims;
+    }
+    else anims = LoadModelAnimationsCached(fileName, animCount);
+
+    TraceSpan(fileName, ready ? "take" : "load", startTime, GetTime());
+    return anims;
+}
+
+// Create a sound from the preloaded audio (or LoadSound()), call after InitAudioDevice()
+Sound LoadSoundAsset(const char *fileName) {
+    double startTime = GetTime();
+    LockLoader();
+    int index = FindRequest(fileName);
+    bool ready = (index != -1) && (requests[index].state == ASSET_STATE_READY) && (requests[index].type == ASSET_SOUND);
+    UnlockLoader();
+
+    // The decoded wave is shared, every call gets its own sound buffer
+    Sound sound = ready ? LoadSoundFromWave(requests[index].wave) : LoadSound(fileName);
+    TraceSpan(fileName, ready ? "take" : "load", startTime, GetTime());
+    return sound;
+}
+#endif
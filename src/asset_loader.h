@@ -0,0 +1,33 @@
+// Background asset loader for the startup assets
+// Worker threads read the files and do the CPU side of loading (image and audio decoding, glTF
+// animation parsing), the main thread finishes each asset (GPU upload) in per-frame time slices
+// so a loading screen can be drawn meanwhile. The game then takes the results with the
+// Load*Asset() functions, which fall back to a synchronous load for assets never requested.
+// Worker, upload and take/load times are recorded as trace spans while a capture runs.
+
+#ifndef ASSET_LOADER_H
+#define ASSET_LOADER_H
+
+#include "raylib.h"
+
+typedef enum {
+    ASSET_TEXTURE,           // Image decoded on a worker, uploaded as a texture
+    ASSET_MODEL,             // File read on a worker, model loaded and uploaded on the main thread
+    ASSET_ANIMATED_MODEL,    // ASSET_MODEL plus its animations parsed on a worker
+    ASSET_SOUND              // Audio decoded on a worker, shared by every LoadSoundAsset() call
+} AssetType;
+
+void InitAssetLoader(int workerCount);                 // Start the worker threads (no threads on web, work is done in UpdateAssetLoader)
+void UnloadAssetLoader(void);                          // Stop the workers and free everything not taken by the game
+void RequestAsset(const char *fileName, AssetType type); // Queue an asset for background loading
+
+void UpdateAssetLoader(double timeBudget);             // Finish decoded assets on the main thread, for about timeBudget seconds
+float GetAssetLoaderProgress(void);                    // Get the loaded fraction of the requested assets [0..1]
+bool IsAssetLoaderDone(void);                          // Check if every requested asset is finished (or failed)
+
+Texture2D LoadTextureAsset(const char *fileName);      // Take a preloaded texture (or LoadTexture())
+Model LoadModelAsset(const char *fileName);            // Take a preloaded model (or LoadModelCached())
+ModelAnimation *LoadModelAnimationsAsset(const char *fileName, int *animCount); // Take preloaded animations (or LoadModelAnimationsCached())
+Sound LoadSoundAsset(const char *fileName);            // Create a sound from the preloaded audio (or LoadSound()), call after InitAudioDevice()
+
+#endif // ASSET_LOADER_H
@@ -0,0 +1,137 @@
+#include "culling.h"
+#include "raymath.h"
+#include "rlgl.h"
+
+#include <math.h>
+
+// Counts gathered since the last ResetCullStats()
+static CullStats cullStats = { 0 };
+
+// Build the view frustum the camera renders with (same projection as BeginMode3D)
+Frustum GetCameraFrustum(Camera camera) {
+    Matrix view = GetCameraMatrix(camera);
+    float aspect = (float)GetScreenWidth()/(float)GetScreenHeight();
+    Matrix projection = MatrixPerspective(camera.fovy*DEG2RAD, aspect, rlGetCullDistanceNear(), rlGetCullDistanceFar());
+    Matrix m = MatrixMultiply(view, projection);
+
+    // Gribb/Hartmann plane extraction from the rows of the clip matrix
+    Vector4 row0 = { m.m0, m.m4, m.m8, m.m12 };
+    Vector4 row1 = { m.m1, m.m5, m.m9, m.m13 };
+    Vector4 row2 = { m.m2, m.m6, m.m10, m.m14 };
+    Vector4 row3 = { m.m3, m.m7, m.m11, m.m15 };
+
+    Frustum frustum = { 0 };
+    frustum.planes[0] = Vector4Add(row3, row0);
+    frustum.planes[1] = Vector4Subtract(row3, row0);
+    frustum.planes[2] = Vector4Add(row3, row1);
+    frustum.planes[3] = Vector4Subtract(row3, row1);
+    frustum.planes[4] = Vector4Add(row3, row2);
+    frustum.planes[5] = Vector4Subtract(row3, row2);
+
+    // Normalize so sphere tests can compare against the radius directly
+    for (int i = 0; i < 6; i++) {
+        float length = sqrtf(frustum.planes[i].x*frustum.planes[i].x + frustum.planes[i].y*frustum.planes[i].y + frustum.planes[i].z*frustum.planes[i].z);
+        if (length > 0.0f) frustum.planes[i] = Vector4Scale(frustum.planes[i], 1.0f/length);
+    }
+
+    return frustum;
+}
+
+// Check if an axis-aligned box is at least partially inside the frustum
+bool FrustumContainsBox(const Frustum *frustum, BoundingBox box) {
+    for (int i = 0; i < 6; i++) {
+        Vector4 plane = frustum->planes[i];
+
+        // Box corner furthest along the plane normal
+        Vector3 corner = {
+            (plane.x >= 0.0f) ? box.max.x : box.min.x,
+            (plane.y >= 0.0f) ? box.max.y : box.min.y,
+            (plane.z >= 0.0f) ? box.max.z : box.min.z
+        };
+
+        if (plane.x*corner.x + plane.y*corner.y + plane.z*corner.z + plane.w < 0.0f) return false;
+    }
+
+    return true;
+}
+
+// Check if a sphere is at least partially inside the frustum
+bool FrustumContainsSphere(const Frustum *frustum, BoundingSphere sphere) {
+    for (int i = 0; i < 6; i++) {
+        Vector4 plane = frustum->planes[i];
+        if (plane.x*sphere.center.x + plane.y*sphere.center.y + plane.z*sphere.center.z + plane.w < -sphere.radius) return false;
+    }
+
+    return true;
+}
+
+// Get the world AABB enclosing a transformed local AABB
+BoundingBox TransformBoundingBox(BoundingBox box, Matrix transform) {
+    BoundingBox result = { 0 };
+
+    for (int i = 0; i < 8; i++) {
+        Vector3 corner = {
+            (i & 1) ? box.max.x : box.min.x,
+            (i & 2) ? box.max.y : box.min.y,
+            (i & 4) ? box.max.z : box.min.z
+        };
+        corner = Vector3Transform(corner, transform);
+
+        if (i == 0) {
+            result.min = corner;
+            result.max = corner;
+        } else {
+            result.min = Vector3Min(result.min, corner);
+            result.max = Vector3Max(result.max, corner);
+        }
+    }
+
+    return result;
+}
+
+// Get the world AABB of a model drawn with DrawModelEx() around the Y axis
+BoundingBox GetModelWorldBounds(Model model, Vector3 position, float rotationAngle, float scale) {
+    Matrix matScale = MatrixScale(scale, scale, scale);
+    Matrix matRotation = MatrixRotate((Vector3){ 0.0f, 1.0f, 0.0f }, rotationAngle*DEG2RAD);
+    Matrix matTranslation = MatrixTranslate(position.x, position.y, position.z);
+    Matrix transform = MatrixMultiply(MatrixMultiply(matScale, matRotation), matTranslation);
+
+    // GetModelBoundingBox() already applies model.transform
+    return TransformBoundingBox(GetModelBoundingBox(model), transform);
+}
+
+// Get the sphere enclosing an AABB
+BoundingSphere GetBoundingSphere(BoundingBox box) {
+    BoundingSphere sphere = { 0 };
+    sphere.center = Vector3Scale(Vector3Add(box.min, box.max), 0.5f);
+    sphere.radius = Vector3Distance(sphere.center, box.max);
+    return sphere;
+}
+
+// Clear the counts, call once per frame before drawing
+void ResetCullStats(void) {
+    cullStats = (CullStats){ 0 };
+}
+
+// Count one drawable as visible or culled
+void RecordCullResult(CullCategory category, bool visible) {
+    if (visible) cullStats.visible[category]++;
+    else cullStats.culled[category]++;
+}
+
+// Get the counts gathered since the last reset
+CullStats GetCullStats(void) {
+    return cullStats;
+}
+
+// Get a display name for a category
+const char *GetCullCategoryName(CullCategory category) {
+    switch (category) {
+        case CULL_TERRAIN: return "Terrain";
+        case CULL_BUILDINGS: return "Buildings";
+        case CULL_PLANTS: return "Plants";
+        case CULL_ANIMALS: return "Animals";
+        case CULL_CLOUDS: return "Clouds";
+        default: return "Unknown";
+    }
+}
@@ -0,0 +1,50 @@
+// View-frustum culling helpers shared by every world draw list
+// Bounds are computed once per drawable (GetModelBoundingBox + object transform) and
+// tested against the frustum planes extracted from the camera every frame.
+
+#ifndef CULLING_H
+#define CULLING_H
+
+#include "raylib.h"
+
+// Planes are stored as (normal.x, normal.y, normal.z, distance), points with dot(normal, p) + distance >= 0 are inside
+typedef struct {
+    Vector4 planes[6];   // Left, right, bottom, top, near, far
+} Frustum;
+
+// World-space bounding sphere
+typedef struct {
+    Vector3 center;
+    float radius;
+} BoundingSphere;
+
+// Draw list categories tracked by the culling statistics
+typedef enum {
+    CULL_TERRAIN,
+    CULL_BUILDINGS,
+    CULL_PLANTS,
+    CULL_ANIMALS,
+    CULL_CLOUDS,
+    CULL_CATEGORY_COUNT
+} CullCategory;
+
+// Per-category visible/culled counts for the current frame
+typedef struct {
+    int visible[CULL_CATEGORY_COUNT];
+    int culled[CULL_CATEGORY_COUNT];
+} CullStats;
+
+Frustum GetCameraFrustum(Camera camera);                            // Build the frustum the camera renders with (same projection as BeginMode3D)
+bool FrustumContainsBox(const Frustum *frustum, BoundingBox box);   // Check if an AABB is at least partially inside the frustum
+bool FrustumContainsSphere(const Frustum *frustum, BoundingSphere sphere); // Check if a sphere is at least partially inside the frustum
+
+BoundingBox TransformBoundingBox(BoundingBox box, Matrix transform); // Get the world AABB enclosing a transformed local AABB
+BoundingBox GetModelWorldBounds(Model model, Vector3 position, float rotationAngle, float scale); // Get the world AABB of a model drawn with DrawModelEx() around the Y axis
+BoundingSphere GetBoundingSphere(BoundingBox box);                  // Get the sphere enclosing an AABB
+
+void ResetCullStats(void);                                          // Clear the counts, call once per frame before drawing
+void RecordCullResult(CullCategory category, bool visible);         // Count one drawable as visible or culled
+CullStats GetCullStats(void);                                       // Get the counts gathered since the last reset
+const char *GetCullCategoryName(CullCategory category);             // Get a display name for a category
+
+#endif // CULLING_H
@@ -0,0 +1,227 @@
+#if !defined(_WIN32)
+    #define _XOPEN_SOURCE 700          // getrusage()
+#endif
+
+#include "flythrough.h"
+#include "render_stats.h"
+#include "raymath.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+    // psapi declarations, windows.h clashes with raylib.h
+    typedef struct {
+        unsigned long cb;
+        unsigned long PageFaultCount;
+        size_t PeakWorkingSetSize;
+        size_t WorkingSetSize;
+        size_t QuotaPeakPagedPoolUsage;
+        size_t QuotaPagedPoolUsage;
+        size_t QuotaPeakNonPagedPoolUsage;
+        size_t QuotaNonPagedPoolUsage;
+        size_t PagefileUsage;
+        size_t PeakPagefileUsage;
+    } ProcessMemoryCounters;
+    __declspec(dllimport) void *__stdcall GetCurrentProcess(void);
+    __declspec(dllimport) int __stdcall K32GetProcessMemoryInfo(void *process, ProcessMemoryCounters *counters, unsigned long size);
+#elif defined(__linux__) || defined(__APPLE__)
+    #include <sys/resource.h>
+#endif
+
+static FlythroughFrame *frames = NULL;
+static int frameCapacity = 0;
+static int frameCount = 0;
+
+// Load a camera path file (count is 0 on failure)
+CameraPath LoadCameraPath(const char *fileName) {
+    CameraPath path = { 0 };
+    char *text = LoadFileText(fileName);
+    if (text == NULL) return path;
+
+    int lineCount = 1;
+    for (const char *c = text; *c != '\0'; c++) if (*c == '\n') lineCount++;
+    path.positions = (Vector3 *)MemAlloc(lineCount*sizeof(Vector3));
+    path.targets = (Vector3 *)MemAlloc(lineCount*sizeof(Vector3));
+
+    char *line = text;
+    while ((line != NULL) && (*line != '\0')) {
+        char *next = strchr(line, '\n');
+        if (next != NULL) *next++ = '\0';
+
+        Vector3 position = { 0 };
+        Vector3 target = { 0 };
+        if ((line[0] != '#') && (sscanf(line, "%f %f %f %f %f %f", &position.x, &position.y, &position.z,
+                                        &target.x, &target.y, &target.z) == 6)) {
+            path.positions[path.count] = position;
+            path.targets[path.count] = target;
+            path.count++;
+        }
+        line = next;
+    }
+    UnloadFileText(text);
+
+    if (path.count < 2) {
+        TraceLog(LOG_WARNING, "FLYTHROUGH: [%s] Camera path needs at least 2 keyframes", fileName);
+        UnloadCameraPath(path);
+        return (CameraPath){ 0 };
+    }
+
+    for (int i = 0; i < path.count - 1; i++) path.length += Vector3Distance(path.positions[i], path.positions[i + 1]);
+
+    TraceLog(LOG_INFO, "FLYTHROUGH: [%s] Camera path loaded, %d keyframes, %.1f units", fileName, path.count, path.length);
+    return path;
+}
+
+// Unload camera path data
+void UnloadCameraPath(CameraPath path) {
+    MemFree(path.positions);
+    MemFree(path.targets);
+}
+
+// Write keyframes as a camera path file
+bool SaveCameraPath(const char *fileName, const Vector3 *positions, const Vector3 *targets, int count) {
+    FILE *file = fopen(fileName, "w");
+    if (file == NULL) {
+        TraceLog(LOG_WARNING, "FLYTHROUGH: [%s] Failed to open file for writing", fileName);
+        return false;
+    }
+
+    fprintf(file, "# Camera path: position.x position.y position.z target.x target.y target.z\n");
+    for (int i = 0; i < count; i++) {
+        fprintf(file, "%.4f %.4f %.4f %.4f %.4f %.4f\n", positions[i].x, positions[i].y, positions[i].z,
+                targets[i].x, targets[i].y, targets[i].z);
+    }
+
+    fclose(file);
+    TraceLog(LOG_INFO, "FLYTHROUGH: [%s] Saved camera path with %d keyframes", fileName, count);
+    return true;
+}
+
+// Interpolate the pose at a distance along the path, clamped to its ends
+void GetCameraPathPose(CameraPath path, float distance, Vector3 *position, Vector3 *target) {
+    if (path.count == 0) return;
+
+    for (int i = 0; i < path.count - 1; i++) {
+        float segmentLength = Vector3Distance(path.positions[i], path.positions[i + 1]);
+        if ((distance <= segmentLength) && (segmentLength > 0.0f)) {
+            float t = (distance > 0.0f) ? distance/segmentLength : 0.0f;
+            *position = Vector3Lerp(path.positions[i], path.positions[i + 1], t);
+            *target = Vector3Lerp(path.targets[i], path.targets[i + 1], t);
+            return;
+        }
+        distance -= segmentLength;
+    }
+
+    *position = path.positions[path.count - 1];
+    *target = path.targets[path.count - 1];
+}
+
+// Allocate the frame records of a run
+void BeginFlythroughReport(int count) {
+    MemFree(frames);
+    frames = (FlythroughFrame *)MemAlloc(count*sizeof(FlythroughFrame));
+    frameCapacity = (frames != NULL) ? count : 0;
+    frameCount = 0;
+}
+
+// Record a measured frame
+void RecordFlythroughFrame(FlythroughFrame frame) {
+    if (frameCount < frameCapacity) frames[frameCount++] = frame;
+}
+
+static int CompareFloats(const void *a, const void *b) {
+    float x = *(const float *)a;
+    float y = *(const float *)b;
+    return (x > y) - (x < y);
+}
+
+// Nearest-rank percentile of sorted values
+static float GetPercentile(const float *sorted, int count, float percent) {
+    int rank = (int)ceilf(percent/100.0f*count);
+    return sorted[(rank > 0) ? rank - 1 : 0];
+}
+
+// Write a string as a JSON string literal
+static void WriteJsonString(FILE *file, const char *text) {
+    fputc('"', file);
+    for (const char *c = text; *c != '\0'; c++) {
+        if ((*c == '"') || (*c == '\\')) fputc('\\', file);
+        if ((unsigned char)*c >= 0x20) fputc(*c, file);
+    }
+    fputc('"', file);
+}
+
+// Write the JSON report and free the records
+bool ExportFlythroughReport(const char *fileName, const char *pathFileName, unsigned int seed, float timestep) {
+    if (frameCount == 0) {
+        TraceLog(LOG_WARNING, "FLYTHROUGH: No frames recorded, report not written");
+        return false;
+    }
+
+    float *sortedTimes = (float *)MemAlloc(frameCount*sizeof(float));
+    double timeSum = 0.0, drawCallSum = 0.0, triangleSum = 0.0;
+    int drawCallMax = 0;
+    long long triangleMax = 0;
+    for (int i = 0; i < frameCount; i++) {
+        sortedTimes[i] = frames[i].frameTime;
+        timeSum += frames[i].frameTime;
+        drawCallSum += frames[i].drawCalls;
+        triangleSum += (double)frames[i].triangles;
+        if (frames[i].drawCalls > drawCallMax) drawCallMax = frames[i].drawCalls;
+        if (frames[i].triangles > triangleMax) triangleMax = frames[i].triangles;
+    }
+    qsort(sortedTimes, frameCount, sizeof(float), CompareFloats);
+
+    float p50 = GetPercentile(sortedTimes, frameCount, 50.0f);
+    float p95 = GetPercentile(sortedTimes, frameCount, 95.0f);
+    float p99 = GetPercentile(sortedTimes, frameCount, 99.0f);
+    float maxTime = sortedTimes[frameCount - 1];
+    MemFree(sortedTimes);
+
+    FILE *file = fopen(fileName, "w");
+    if (file == NULL) TraceLog(LOG_WARNING, "FLYTHROUGH: [%s] Failed to open file for writing", fileName);
+    else {
+        fprintf(file, "{\n  \"path\": ");
+        WriteJsonString(file, pathFileName);
+        fprintf(file, ",\n  \"renderer\": ");
+        WriteJsonString(file, GetRenderDeviceName());
+        fprintf(file, ",\n  \"seed\": %u,\n  \"timestep\": %.6f,\n  \"frames\": %d,\n", seed, timestep, frameCount);
+        fprintf(file, "  \"frameTimeMs\": { \"mean\": %.3f, \"p50\": %.3f, \"p95\": %.3f, \"p99\": %.3f, \"max\": %.3f },\n",
+                timeSum/frameCount, p50, p95, p99, maxTime);
+        fprintf(file, "  \"drawCalls\": { \"mean\": %.1f, \"max\": %d },\n", drawCallSum/frameCount, drawCallMax);
+        fprintf(file, "  \"triangles\": { \"mean\": %.0f, \"max\": %lld },\n", triangleSum/frameCount, triangleMax);
+        fprintf(file, "  \"peakMemoryBytes\": %lld\n}\n", GetPeakMemoryUsage());
+        fclose(file);
+
+        TraceLog(LOG_INFO, "FLYTHROUGH: [%s] %d frames, p50 %.2f ms, p95 %.2f ms, p99 %.2f ms, max %.2f ms",
+                 fileName, frameCount, p50, p95, p99, maxTime);
+    }
+
+    MemFree(frames);
+    frames = NULL;
+    frameCapacity = 0;
+    frameCount = 0;
+    return (file != NULL);
+}
+
+// Get the peak resident memory of the process in bytes (0 if unknown)
+long long GetPeakMemoryUsage(void) {
+#if defined(_WIN32)
+    ProcessMemoryCounters counters = { 0 };
+    counters.cb = sizeof(counters);
+    if (K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return (long long)counters.PeakWorkingSetSize;
+    return 0;
+#elif defined(__linux__) || defined(__APPLE__)
+    struct rusage usage = { 0 };
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+    #if defined(__APPLE__)
+        return (long long)usage.ru_maxrss;           // Bytes
+    #else
+        return (long long)usage.ru_maxrss*1024;      // Kilobytes
+    #endif
+#else
+    return 0;
+#endif
+}
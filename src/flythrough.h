@@ -0,0 +1,38 @@
+// Flythrough benchmark: camera paths and the frame report
+// A camera path is a text file of keyframes ("px py pz tx ty tz" per line, '#' comments) written
+// by the path recorder (R to record, E to export). The benchmark replays it at a constant speed
+// with a fixed timestep and seed, records every frame and writes a JSON report with frame time
+// percentiles, draw calls, triangles and the peak memory of the process.
+
+#ifndef FLYTHROUGH_H
+#define FLYTHROUGH_H
+
+#include "raylib.h"
+
+// Camera keyframes, replayed at a constant speed along the positions
+typedef struct {
+    int count;
+    Vector3 *positions;
+    Vector3 *targets;
+    float length;          // Length of the position polyline
+} CameraPath;
+
+// One rendered benchmark frame
+typedef struct {
+    float frameTime;       // Milliseconds
+    int drawCalls;
+    long long triangles;
+} FlythroughFrame;
+
+CameraPath LoadCameraPath(const char *fileName);      // Load a camera path file (count is 0 on failure)
+void UnloadCameraPath(CameraPath path);               // Unload camera path data
+bool SaveCameraPath(const char *fileName, const Vector3 *positions, const Vector3 *targets, int count); // Write keyframes as a camera path file
+void GetCameraPathPose(CameraPath path, float distance, Vector3 *position, Vector3 *target); // Interpolate the pose at a distance along the path
+
+void BeginFlythroughReport(int frameCount);           // Allocate the frame records of a run
+void RecordFlythroughFrame(FlythroughFrame frame);    // Record a measured frame
+bool ExportFlythroughReport(const char *fileName, const char *pathFileName, unsigned int seed, float timestep); // Write the JSON report and free the records
+
+long long GetPeakMemoryUsage(void);                   // Get the peak resident memory of the process in bytes (0 if unknown)
+
+#endif // FLYTHROUGH_H
@@ -0,0 +1,188 @@
+#include "herd.h"
+
+#include <limits.h>
+#include <string.h>
+
+#define HERD_MAX_ARRAYS 24
+
+// Get every array of a herd with its element size, they are allocated and grown together
+static int GetHerdArrays(Herd *herd, void **arrays[], int sizes[]) {
+    int count = 0;
+#define HERD_ARRAY(field) arrays[count] = (void **)&herd->field; sizes[count] = (int)sizeof(*herd->field); count++
+    HERD_ARRAY(x); HERD_ARRAY(z);
+    HERD_ARRAY(dirX); HERD_ARRAY(dirZ);
+    HERD_ARRAY(speed); HERD_ARRAY(moving);
+    HERD_ARRAY(moveTimer); HERD_ARRAY(moveInterval);
+    HERD_ARRAY(animFrame); HERD_ARRAY(bounced);
+    HERD_ARRAY(rotation); HERD_ARRAY(prevX); HERD_ARRAY(prevZ); HERD_ARRAY(prevRotation);
+    HERD_ARRAY(y); HERD_ARRAY(scale); HERD_ARRAY(gridEntry);
+    HERD_ARRAY(spawnX); HERD_ARRAY(spawnZ); HERD_ARRAY(maxWanderDistance); HERD_ARRAY(randomState);
+    HERD_ARRAY(soundData);
+#undef HERD_ARRAY
+    return count;
+}
+
+// Resize every array of a herd
+static bool ResizeHerd(Herd *herd, int capacity) {
+    void **arrays[HERD_MAX_ARRAYS];
+    int sizes[HERD_MAX_ARRAYS];
+    int arrayCount = GetHerdArrays(herd, arrays, sizes);
+
+    for (int i = 0; i < arrayCount; i++) {
+        void *array = MemRealloc(*arrays[i], (unsigned int)(capacity*sizes[i]));
+        if (array == NULL) {
+            TraceLog(LOG_ERROR, "HERD: Failed to grow herd to %d animals", capacity);
+            return false;
+        }
+        *arrays[i] = array;
+    }
+
+    herd->capacity = capacity;
+    return true;
+}
+
+// Create an empty herd (grows as needed)
+Herd LoadHerd(int capacity) {
+    Herd herd = { 0 };
+    if (capacity < 16) capacity = 16;
+    ResizeHerd(&herd, capacity);
+    return herd;
+}
+
+// Free the herd memory
+void UnloadHerd(Herd *herd) {
+    void **arrays[HERD_MAX_ARRAYS];
+    int sizes[HERD_MAX_ARRAYS];
+    int arrayCount = GetHerdArrays(herd, arrays, sizes);
+    for (int i = 0; i < arrayCount; i++) MemFree(*arrays[i]);
+    *herd = (Herd){ 0 };
+}
+
+// Append an idle animal at a position, returns its slot (-1 on failure).
+// Only the position and the random generator are set, the game fills in the species properties.
+int AddHerdAnimal(Herd *herd, Vector3 position, unsigned int seed) {
+    if ((herd->count == herd->capacity) && !ResizeHerd(herd, (herd->capacity > 0) ? herd->capacity*2 : 16)) return -1;
+
+    int slot = herd->count++;
+    herd->x[slot] = herd->prevX[slot] = herd->spawnX[slot] = position.x;
+    herd->z[slot] = herd->prevZ[slot] = herd->spawnZ[slot] = position.z;
+    herd->y[slot] = position.y;
+    herd->dirX[slot] = 0.0f;
+    herd->dirZ[slot] = 1.0f;
+    herd->speed[slot] = 0.0f;
+    herd->moving[slot] = 0.0f;
+    herd->moveTimer[slot] = 0.0f;
+    herd->moveInterval[slot] = 0.0f;
+    herd->animFrame[slot] = 0;
+    herd->bounced[slot] = 0;
+    herd->rotation[slot] = herd->prevRotation[slot] = 0.0f;
+    herd->scale[slot] = 1.0f;
+    herd->gridEntry[slot] = -1;
+    herd->maxWanderDistance[slot] = 0.0f;
+    herd->randomState[slot] = (seed != 0) ? seed : 0x9E3779B9u; // xorshift never leaves 0
+    herd->soundData[slot] = NULL;
+    return slot;
+}
+
+// Get a random value between min and max (both included) from an animal's own generator
+int GetHerdRandomValue(Herd *herd, int slot, int min, int max) {
+    unsigned int x = herd->randomState[slot];
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    herd->randomState[slot] = x;
+
+    if (min > max) {
+        int tmp = max;
+        max = min;
+        min = tmp;
+    }
+    return min + (int)(x%((unsigned int)(max - min) + 1));
+}
+
+// Copy position and rotation of every animal to the previous step state
+void SaveHerdState(Herd *herd) {
+    memcpy(herd->prevX, herd->x, herd->count*sizeof(float));
+    memcpy(herd->prevZ, herd->z, herd->count*sizeof(float));
+    memcpy(herd->prevRotation, herd->rotation, herd->count*sizeof(float));
+}
+
+// Add the step time to every decision timer
+void AdvanceHerdTimers(Herd *herd, int begin, int end, float deltaTime) {
+    float *restrict moveTimer = herd->moveTimer;
+    for (int i = begin; i < end; i++) moveTimer[i] += deltaTime;
+}
+
+// Step the walking animals along their heading (idle ones move by 0)
+void MoveHerd(Herd *herd, int begin, int end) {
+    float *restrict x = herd->x;
+    float *restrict z = herd->z;
+    const float *restrict dirX = herd->dirX;
+    const float *restrict dirZ = herd->dirZ;
+    const float *restrict speed = herd->speed;
+    const float *restrict moving = herd->moving;
+
+    for (int i = begin; i < end; i++) {
+        float step = speed[i]*moving[i];
+        x[i] += dirX[i]*step;
+        z[i] += dirZ[i]*step;
+    }
+}
+
+// Clamp one coordinate of the walking animals into a range, adds flag to bounced when clamped.
+// A coordinate on the border counts as clamped, so an animal walking along it keeps bouncing off.
+// The axes are clamped in separate loops, a single loop over both is too much control flow for
+// the vectorizer.
+static int ClampHerdAxis(float *restrict v, const float *restrict moving, unsigned char *restrict bounced, int begin, int end,
+                         float minValue, float maxValue, int flag) {
+    int clamped = 0;
+
+    for (int i = begin; i < end; i++) {
+        float value = v[i];
+        float clampedValue = (value < minValue) ? minValue : value;
+        clampedValue = (clampedValue > maxValue) ? maxValue : clampedValue;
+        int walking = (moving[i] > 0.0f);
+        int hit = walking & ((value <= minValue) | (value >= maxValue));
+        v[i] = walking ? clampedValue : value;
+        bounced[i] = (unsigned char)(bounced[i] | hit*flag);
+        clamped += hit;
+    }
+
+    return clamped;
+}
+
+// Clamp the walking animals into a rectangle, sets bounced, returns the number of coordinates clamped
+int ClampHerdToRect(Herd *herd, int begin, int end, float minX, float maxX, float minZ, float maxZ) {
+    if (end <= begin) return 0;
+    memset(herd->bounced + begin, 0, end - begin);
+    return ClampHerdAxis(herd->x, herd->moving, herd->bounced, begin, end, minX, maxX, HERD_BOUNCED_X) +
+           ClampHerdAxis(herd->z, herd->moving, herd->bounced, begin, end, minZ, maxZ, HERD_BOUNCED_Z);
+}
+
+// Clamp the animals into a rectangle
+void ClampHerdPositions(Herd *herd, int begin, int end, float minX, float maxX, float minZ, float maxZ) {
+    float *restrict x = herd->x;
+    float *restrict z = herd->z;
+
+    for (int i = begin; i < end; i++) {
+        float px = (x[i] < minX) ? minX : x[i];
+        float pz = (z[i] < minZ) ? minZ : z[i];
+        x[i] = (px > maxX) ? maxX : px;
+        z[i] = (pz > maxZ) ? maxZ : pz;
+    }
+}
+
+// Advance the frame counters, wrapping on the clip of the movement state (0 frames: no wrap).
+// A walking animal without a walking clip wraps on the idle clip.
+void AdvanceHerdAnimation(Herd *herd, int begin, int end, int walkingFrames, int idleFrames) {
+    int idleLimit = (idleFrames > 0) ? idleFrames : INT_MAX;
+    int walkingLimit = (walkingFrames > 0) ? walkingFrames : idleLimit;
+    int *restrict animFrame = herd->animFrame;
+    const float *restrict moving = herd->moving;
+
+    for (int i = begin; i < end; i++) {
+        int frame = animFrame[i] + 1;
+        int limit = (moving[i] > 0.0f) ? walkingLimit : idleLimit;
+        animFrame[i] = (frame >= limit) ? 0 : frame;
+    }
+}
@@ -0,0 +1,61 @@
+// Structure-of-arrays animal storage
+// A herd holds every animal of one species as parallel arrays, so the per-step loops stream only
+// the fields they use (positions, headings, timers) instead of whole animal records. Animals are
+// appended and never removed one by one, a slot stays valid until the herd is cleared.
+//
+// The kernels below are plain branch-free loops over the arrays, written so the compiler can
+// vectorize them (SSE/AVX on desktop, WASM SIMD on the web) without intrinsics. The game keeps the
+// scalar parts (random decisions, grid queries) and runs them only on the slots that need them.
+// Kernels work on a slot range [begin, end) so a herd can be split into jobs (see job_system.h),
+// every animal draws its random numbers from its own generator so the split doesn't matter.
+
+#ifndef HERD_H
+#define HERD_H
+
+#include "raylib.h"
+
+#define HERD_BOUNCED_X 1   // ClampHerdToRect() flags: the X coordinate was clamped
+#define HERD_BOUNCED_Z 2   // The Z coordinate was clamped
+
+typedef struct {
+    int count;
+    int capacity;
+
+    // Hot: read or written by every simulation step
+    float *x, *z;                 // Position on the ground plane
+    float *dirX, *dirZ;           // Heading
+    float *speed;                 // Units per step
+    float *moving;                // 1.0f while walking, 0.0f while idle
+    float *moveTimer;             // Seconds since the last decision
+    float *moveInterval;          // Seconds until the next decision
+    int *animFrame;               // Frame of the current clip
+    unsigned char *bounced;       // HERD_BOUNCED_* flags of the last ClampHerdToRect()
+
+    // Warm: collision handling and drawing
+    float *rotation;              // Degrees around Y, follows the heading
+    float *prevX, *prevZ;         // State before the last step, drawn interpolated
+    float *prevRotation;
+    float *y;
+    float *scale;
+    int *gridEntry;               // Entry in the animal collision grid
+
+    // Cold: wander decisions and sounds
+    float *spawnX, *spawnZ;       // Original spawn position to return to
+    float *maxWanderDistance;     // Maximum distance from the spawn position
+    unsigned int *randomState;    // Own random generator (xorshift), seeded by AddHerdAnimal()
+    void **soundData;
+} Herd;
+
+Herd LoadHerd(int capacity);                                   // Create an empty herd (grows as needed)
+void UnloadHerd(Herd *herd);                                   // Free the herd memory
+int AddHerdAnimal(Herd *herd, Vector3 position, unsigned int seed); // Append an idle animal at a position, returns its slot (-1 on failure)
+int GetHerdRandomValue(Herd *herd, int slot, int min, int max); // Get a random value between min and max (both included) from an animal's own generator
+
+void SaveHerdState(Herd *herd);                                // Copy position and rotation of every animal to the previous step state
+void AdvanceHerdTimers(Herd *herd, int begin, int end, float deltaTime); // Add the step time to the decision timers
+void MoveHerd(Herd *herd, int begin, int end);                 // Step the walking animals along their heading
+int ClampHerdToRect(Herd *herd, int begin, int end, float minX, float maxX, float minZ, float maxZ); // Clamp the walking animals into a rectangle, sets bounced, returns the number of coordinates clamped
+void ClampHerdPositions(Herd *herd, int begin, int end, float minX, float maxX, float minZ, float maxZ); // Clamp the animals into a rectangle
+void AdvanceHerdAnimation(Herd *herd, int begin, int end, int walkingFrames, int idleFrames); // Advance the frame counters, wrapping on the clip of the movement state (0 frames: no wrap)
+
+#endif // HERD_H
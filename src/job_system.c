@@ -0,0 +1,272 @@
+#include "job_system.h"
+#include "trace_capture.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+// Web builds have no worker threads, RunParallelFor() runs the loops itself
+#if defined(PLATFORM_WEB)
+    #define JOB_THREADS 0
+#else
+    #define JOB_THREADS 1
+    #if defined(_MSC_VER)
+        #include <threads.h>
+    #else
+        #include <pthread.h>
+        #include <unistd.h>
+    #endif
+#endif
+
+#define MAX_QUEUED_JOBS 256      // Batches per thread queue, RunParallelFor() makes the batches larger to fit
+
+#if JOB_THREADS
+#if defined(_MSC_VER)
+typedef thrd_t JobThread;
+typedef mtx_t JobMutex;
+typedef cnd_t JobCondition;
+#define InitMutex(m) mtx_init(m, mtx_plain)
+#define DestroyMutex(m) mtx_destroy(m)
+#define LockMutex(m) mtx_lock(m)
+#define UnlockMutex(m) mtx_unlock(m)
+#define InitCondition(c) cnd_init(c)
+#define DestroyCondition(c) cnd_destroy(c)
+#define WaitCondition(c, m) cnd_wait(c, m)
+#define BroadcastCondition(c) cnd_broadcast(c)
+#else
+typedef pthread_t JobThread;
+typedef pthread_mutex_t JobMutex;
+typedef pthread_cond_t JobCondition;
+#define InitMutex(m) pthread_mutex_init(m, NULL)
+#define DestroyMutex(m) pthread_mutex_destroy(m)
+#define LockMutex(m) pthread_mutex_lock(m)
+#define UnlockMutex(m) pthread_mutex_unlock(m)
+#define InitCondition(c) pthread_cond_init(c, NULL)
+#define DestroyCondition(c) pthread_cond_destroy(c)
+#define WaitCondition(c, m) pthread_cond_wait(c, m)
+#define BroadcastCondition(c) pthread_cond_broadcast(c)
+#endif
+
+// One batch of a loop
+typedef struct {
+    JobFunc func;
+    void *data;
+    int begin;
+    int end;
+} Job;
+
+// Batches dealt to one thread: the owner takes from the tail, thieves from the head
+typedef struct {
+    Job jobs[MAX_QUEUED_JOBS];
+    int head;
+    int tail;
+    JobMutex mutex;
+} JobQueue;
+
+static JobThread workers[MAX_JOB_WORKERS];
+static char workerNames[MAX_JOB_WORKERS][32];     // Trace thread names, must outlive the workers
+static JobQueue queues[MAX_JOB_WORKERS + 1];      // Queue 0 belongs to the thread calling RunParallelFor()
+static int workerCount = 0;
+
+static JobMutex poolMutex;                        // Guards everything below
+static JobCondition workAvailable;                // A loop was started (or the pool is stopping)
+static JobCondition workDone;                     // The last batch of a loop finished
+static unsigned int loopGeneration = 0;           // Loops started so far, workers wake up when it changes
+static int pendingJobs = 0;                       // Batches of the current loop not finished yet
+static bool poolStopping = false;
+
+// Take a batch: the newest of the own queue, else the oldest of another thread's queue
+static bool TakeJob(int thread, Job *job) {
+    int threadCount = workerCount + 1;
+
+    for (int i = 0; i < threadCount; i++) {
+        JobQueue *queue = &queues[(thread + i)%threadCount];
+        bool found = false;
+
+        LockMutex(&queue->mutex);
+        if (queue->tail > queue->head) {
+            *job = (i == 0) ? queue->jobs[--queue->tail] : queue->jobs[queue->head++];
+            found = true;
+        }
+        UnlockMutex(&queue->mutex);
+
+        if (found) return true;
+    }
+
+    return false;
+}
+
+// Run batches until every queue is empty, then count them as done
+static void RunJobs(int thread) {
+    double startTime = GetTime();
+    int done = 0;
+    Job job = { 0 };
+
+    while (TakeJob(thread, &job)) {
+        job.func(job.data, job.begin, job.end);
+        done++;
+    }
+    if (done == 0) return;
+
+    TraceSpan("Jobs", "jobs", startTime, GetTime());
+
+    LockMutex(&poolMutex);
+    pendingJobs -= done;
+    if (pendingJobs == 0) BroadcastCondition(&workDone);
+    UnlockMutex(&poolMutex);
+}
+
+// Worker loop: run the batches of every loop started until the pool is unloaded
+static void RunJobWorker(int thread) {
+    SetTraceThreadName(workerNames[thread - 1]);
+    unsigned int seenGeneration = 0;
+
+    for (;;) {
+        LockMutex(&poolMutex);
+        while ((loopGeneration == seenGeneration) && !poolStopping) WaitCondition(&workAvailable, &poolMutex);
+        seenGeneration = loopGeneration;
+        bool stopping = poolStopping;
+        UnlockMutex(&poolMutex);
+
+        if (stopping) return;
+        RunJobs(thread);
+    }
+}
+
+#if defined(_MSC_VER)
+static int JobWorkerMain(void *arg) { RunJobWorker((int)(size_t)arg); return 0; }
+#else
+static void *JobWorkerMain(void *arg) { RunJobWorker((int)(size_t)arg); return NULL; }
+#endif
+
+// Get the number of logical cores
+static int GetCoreCount(void) {
+#if defined(_WIN32)
+    const char *cores = getenv("NUMBER_OF_PROCESSORS");
+    return (cores != NULL) ? atoi(cores) : 1;
+#else
+    return (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+}
+#endif
+
+// Start the worker threads (-1: one per extra core, 0: no workers)
+void InitJobSystem(int count) {
+#if JOB_THREADS
+    if (count < 0) count = GetCoreCount() - 1;
+    if (count < 0) count = 0;
+    if (count > MAX_JOB_WORKERS) count = MAX_JOB_WORKERS;
+
+    InitMutex(&poolMutex);
+    InitCondition(&workAvailable);
+    InitCondition(&workDone);
+    for (int i = 0; i <= MAX_JOB_WORKERS; i++) InitMutex(&queues[i].mutex);
+    loopGeneration = 0;
+    pendingJobs = 0;
+    poolStopping = false;
+
+    for (workerCount = 0; workerCount < count; workerCount++) {
+        snprintf(workerNames[workerCount], sizeof(workerNames[workerCount]), "Job worker %d", workerCount + 1);
+        void *arg = (void *)(size_t)(workerCount + 1);
+#if defined(_MSC_VER)
+        bool started = (thrd_create(&workers[workerCount], JobWorkerMain, arg) == thrd_success);
+#else
+        bool started = (pthread_create(&workers[workerCount], NULL, JobWorkerMain, arg) == 0);
+#endif
+        if (!started) {
+            TraceLog(LOG_WARNING, "JOBS: Failed to start worker %d", workerCount + 1);
+            break;
+        }
+    }
+
+    TraceLog(LOG_INFO, "JOBS: Job pool started with %d workers", workerCount);
+#else
+    (void)count;
+    TraceLog(LOG_INFO, "JOBS: Job pool started without workers, loops run on the main thread");
+#endif
+}
+
+// Stop the worker threads
+void UnloadJobSystem(void) {
+#if JOB_THREADS
+    LockMutex(&poolMutex);
+    poolStopping = true;
+    BroadcastCondition(&workAvailable);
+    UnlockMutex(&poolMutex);
+
+    for (int i = 0; i < workerCount; i++) {
+#if defined(_MSC_VER)
+        thrd_join(workers[i], NULL);
+#else
+        pthread_join(workers[i], NULL);
+#endif
+    }
+    workerCount = 0;
+
+    for (int i = 0; i <= MAX_JOB_WORKERS; i++) DestroyMutex(&queues[i].mutex);
+    DestroyCondition(&workDone);
+    DestroyCondition(&workAvailable);
+    DestroyMutex(&poolMutex);
+#endif
+}
+
+// Get the threads running jobs, the workers plus the calling thread
+int GetJobThreadCount(void) {
+#if JOB_THREADS
+    return workerCount + 1;
+#else
+    return 1;
+#endif
+}
+
+// Run func over [0, count) in batches of batchSize on every thread, returns when all are done.
+// Each thread gets a contiguous run of batches so it mostly walks adjacent memory until it steals.
+void RunParallelFor(int count, int batchSize, JobFunc func, void *data) {
+    if (count <= 0) return;
+    if (batchSize < 1) batchSize = 1;
+
+#if JOB_THREADS
+    int threadCount = workerCount + 1;
+    int batchCount = (count + batchSize - 1)/batchSize;
+    if ((workerCount == 0) || (batchCount == 1)) {
+        func(data, 0, count);
+        return;
+    }
+    if (batchCount > threadCount*MAX_QUEUED_JOBS) {
+        batchSize = (count + threadCount*MAX_QUEUED_JOBS - 1)/(threadCount*MAX_QUEUED_JOBS);
+        batchCount = (count + batchSize - 1)/batchSize;
+    }
+
+    // Count the batches before queueing them, a worker still scanning the queues may take one right away
+    LockMutex(&poolMutex);
+    pendingJobs = batchCount;
+    UnlockMutex(&poolMutex);
+
+    for (int t = 0; t < threadCount; t++) {
+        JobQueue *queue = &queues[t];
+        int firstBatch = t*batchCount/threadCount;
+        int lastBatch = (t + 1)*batchCount/threadCount;
+
+        LockMutex(&queue->mutex);
+        queue->head = 0;
+        queue->tail = 0;
+        for (int b = firstBatch; b < lastBatch; b++) {
+            int end = (b + 1)*batchSize;
+            queue->jobs[queue->tail++] = (Job){ func, data, b*batchSize, (end < count) ? end : count };
+        }
+        UnlockMutex(&queue->mutex);
+    }
+
+    LockMutex(&poolMutex);
+    loopGeneration++;
+    BroadcastCondition(&workAvailable);
+    UnlockMutex(&poolMutex);
+
+    RunJobs(0);
+
+    LockMutex(&poolMutex);
+    while (pendingJobs > 0) WaitCondition(&workDone, &poolMutex);
+    UnlockMutex(&poolMutex);
+#else
+    func(data, 0, count);
+#endif
+}
@@ -0,0 +1,23 @@
+// Work-stealing job pool for data-parallel loops
+// RunParallelFor() cuts a loop into batches and deals them to per-thread queues, the workers and
+// the calling thread run their own queue and steal from the others when it runs dry, then the
+// call returns once every batch is done. Jobs must only write the items of their own batch, so
+// the result doesn't depend on the thread count or on which thread ran which batch.
+// Loops are started from the main thread only (no nesting). Web builds have no worker threads,
+// the loops run on the calling thread.
+
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include "raylib.h"
+
+#define MAX_JOB_WORKERS 15
+
+typedef void (*JobFunc)(void *data, int begin, int end);  // Runs the items [begin, end) of a loop
+
+void InitJobSystem(int workerCount);                        // Start the worker threads (-1: one per extra core, 0: no workers)
+void UnloadJobSystem(void);                                 // Stop the worker threads
+int GetJobThreadCount(void);                                // Get the threads running jobs, the workers plus the calling thread
+void RunParallelFor(int count, int batchSize, JobFunc func, void *data); // Run func over [0, count) in batches on every thread, returns when all are done
+
+#endif // JOB_SYSTEM_H
@@ -0,0 +1,368 @@
+#if !defined(_WIN32)
+    #define _POSIX_C_SOURCE 200809L     // nanosleep()
+#endif
+
+#include "log_backend.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Web builds have no writer thread, messages go through the same filtering synchronously
+#if defined(PLATFORM_WEB)
+    #define LOG_BACKEND_THREADS 0
+#else
+    #define LOG_BACKEND_THREADS 1
+    #if defined(_MSC_VER)
+        #include <threads.h>
+        #include <intrin.h>
+    #else
+        #include <pthread.h>
+    #endif
+#endif
+
+#define LOG_MESSAGE_LENGTH 256
+#define LOG_RING_SIZE 1024           // Power of two
+#define LOG_SITE_COUNT 512           // Power of two, call sites tracked for rate limiting
+#define LOG_WRITER_SLEEP_MS 2        // Writer poll interval when the ring is empty
+#define LOG_REPEAT_FLUSH_TIME 1.0    // Seconds between "(repeated N times)" lines of a call site
+#define LOG_SITE_HOT_WINDOWS 3       // Consecutive full rate limit windows before a call site is limited
+
+// Queued message, sequence implements the bounded MPMC queue (Vyukov)
+typedef struct {
+    volatile unsigned long sequence;
+    int level;
+    const char *site;                // Format string of the TraceLog() call
+    double time;
+    char text[LOG_MESSAGE_LENGTH];
+} LogEntry;
+
+// Writer side state of a call site
+typedef struct {
+    const char *site;
+    int level;
+    bool hasLast;                    // lastText holds the last written message
+    unsigned int lastHash;
+    char lastText[LOG_MESSAGE_LENGTH];
+    int repeats;                     // Identical messages not written yet
+    double repeatStart;
+    double windowStart;              // Rate limit window
+    int windowCount;
+    int fullWindows;                 // Consecutive windows that reached LOG_SITE_RATE_LIMIT, the site is hot from LOG_SITE_HOT_WINDOWS on
+    int suppressed;                  // Messages dropped by the rate limit
+    int suppressedLevel;
+    char suppressedText[LOG_MESSAGE_LENGTH]; // Last message dropped
+} LogSite;
+
+static LogEntry ring[LOG_RING_SIZE];
+static volatile unsigned long enqueuePos = 0;
+static unsigned long dequeuePos = 0;          // Writer only
+static volatile unsigned long droppedCount = 0;
+
+static LogSite sites[LOG_SITE_COUNT];
+
+#if LOG_BACKEND_THREADS
+static volatile unsigned long writerStopping = 0;
+#if defined(_MSC_VER)
+static thrd_t writerThread;
+#else
+static pthread_t writerThread;
+#endif
+static bool writerRunning = false;
+#endif
+
+//----------------------------------------------------------------------------------
+// Atomics
+//----------------------------------------------------------------------------------
+#if defined(_MSC_VER)
+static unsigned long AtomicLoad(volatile unsigned long *ptr) { return (unsigned long)_InterlockedOr((volatile long *)ptr, 0); }
+static void AtomicStore(volatile unsigned long *ptr, unsigned long value) { _InterlockedExchange((volatile long *)ptr, (long)value); }
+static bool AtomicCompareExchange(volatile unsigned long *ptr, unsigned long expected, unsigned long desired) {
+    return (_InterlockedCompareExchange((volatile long *)ptr, (long)desired, (long)expected) == (long)expected);
+}
+static void AtomicIncrement(volatile unsigned long *ptr) { _InterlockedIncrement((volatile long *)ptr); }
+static unsigned long AtomicExchange(volatile unsigned long *ptr, unsigned long value) { return (unsigned long)_InterlockedExchange((volatile long *)ptr, (long)value); }
+#else
+static unsigned long AtomicLoad(volatile unsigned long *ptr) { return __atomic_load_n(ptr, __ATOMIC_ACQUIRE); }
+static void AtomicStore(volatile unsigned long *ptr, unsigned long value) { __atomic_store_n(ptr, value, __ATOMIC_RELEASE); }
+static bool AtomicCompareExchange(volatile unsigned long *ptr, unsigned long expected, unsigned long desired) {
+    return __atomic_compare_exchange_n(ptr, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+static void AtomicIncrement(volatile unsigned long *ptr) { __atomic_add_fetch(ptr, 1, __ATOMIC_RELAXED); }
+static unsigned long AtomicExchange(volatile unsigned long *ptr, unsigned long value) { return __atomic_exchange_n(ptr, value, __ATOMIC_ACQ_REL); }
+#endif
+
+//----------------------------------------------------------------------------------
+// Output
+//----------------------------------------------------------------------------------
+// Wall clock in seconds (GetTime() is not available before InitWindow())
+static double GetLogTime(void) {
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (double)now.tv_sec + (double)now.tv_nsec*1e-9;
+}
+
+static const char *GetLevelPrefix(int level) {
+    switch (level) {
+        case LOG_TRACE: return "TRACE: ";
+        case LOG_DEBUG: return "DEBUG: ";
+        case LOG_INFO: return "INFO: ";
+        case LOG_WARNING: return "WARNING: ";
+        case LOG_ERROR: return "ERROR: ";
+        case LOG_FATAL: return "FATAL: ";
+        default: return "";
+    }
+}
+
+static void WriteLine(int level, const char *text, const char *suffix) {
+    fputs(GetLevelPrefix(level), stdout);
+    fputs(text, stdout);
+    fputs(suffix, stdout);
+    fputc('\n', stdout);
+}
+
+static unsigned int HashText(const char *text) {
+    unsigned int hash = 2166136261u;
+    for (; *text != '\0'; text++) hash = (hash ^ (unsigned char)*text)*16777619u;
+    return hash;
+}
+
+// Find (or add) the state of a call site, NULL if the table is full
+static LogSite *GetLogSite(const char *site) {
+    unsigned int slot = (unsigned int)(((size_t)site >> 3)*2654435761u) & (LOG_SITE_COUNT - 1);
+    for (int probe = 0; probe < LOG_SITE_COUNT; probe++) {
+        LogSite *entry = &sites[(slot + probe) & (LOG_SITE_COUNT - 1)];
+        if (entry->site == site) return entry;
+        if (entry->site == NULL) {
+            entry->site = site;
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+// Write the pending "(repeated N times)" line of a call site
+static void FlushRepeats(LogSite *site) {
+    if (site->repeats == 0) return;
+
+    char suffix[64];
+    snprintf(suffix, sizeof(suffix), " (repeated %d times)", site->repeats);
+    WriteLine(site->level, site->lastText, suffix);
+    site->repeats = 0;
+}
+
+// Write the pending "(N similar messages suppressed)" line of a call site with the last message dropped
+static void FlushSuppressed(LogSite *site) {
+    if (site->suppressed == 0) return;
+
+    char suffix[64];
+    snprintf(suffix, sizeof(suffix), " (%d similar messages suppressed)", site->suppressed);
+    WriteLine(site->suppressedLevel, site->suppressedText, suffix);
+    site->suppressed = 0;
+}
+
+// Apply deduplication and rate limiting to one message, then write it.
+// Only hot call sites are rate limited, the ones writing more than LOG_SITE_RATE_LIMIT lines a second
+// for LOG_SITE_HOT_WINDOWS seconds in a row (per-frame messages), one-off bursts like the startup
+// load loops are written in full. Errors are never limited.
+static void ProcessEntry(const LogEntry *entry) {
+    LogSite *site = GetLogSite(entry->site);
+    if ((site == NULL) || (entry->level >= LOG_ERROR)) {
+        WriteLine(entry->level, entry->text, "");
+        return;
+    }
+
+    unsigned int hash = HashText(entry->text);
+    if (site->hasLast && (hash == site->lastHash) && (strcmp(site->lastText, entry->text) == 0)) {
+        if (site->repeats == 0) site->repeatStart = entry->time;
+        site->repeats++;
+        return;
+    }
+    FlushRepeats(site);
+
+    if ((entry->time - site->windowStart) >= 1.0) {
+        bool consecutive = ((entry->time - site->windowStart) < 2.0);
+        site->fullWindows = (consecutive && (site->windowCount >= LOG_SITE_RATE_LIMIT)) ? site->fullWindows + 1 : 0;
+        site->windowStart = entry->time;
+        site->windowCount = 0;
+    }
+    site->windowCount++;
+    if ((site->windowCount > LOG_SITE_RATE_LIMIT) && (site->fullWindows >= LOG_SITE_HOT_WINDOWS)) {
+        site->suppressed++;
+        site->suppressedLevel = entry->level;
+        memcpy(site->suppressedText, entry->text, LOG_MESSAGE_LENGTH);
+        return;
+    }
+
+    char suffix[64] = "";
+    if (site->suppressed > 0) snprintf(suffix, sizeof(suffix), " (%d similar messages suppressed)", site->suppressed);
+    WriteLine(entry->level, entry->text, suffix);
+
+    site->level = entry->level;
+    site->hasLast = true;
+    site->lastHash = hash;
+    memcpy(site->lastText, entry->text, LOG_MESSAGE_LENGTH);
+    site->suppressed = 0;
+}
+
+// Write the repeat counts that have been pending for a while and the suppressed counts of the
+// expired rate limit windows (or all of them), a site that goes quiet doesn't lose its counts
+static void FlushPendingCounts(double time, bool all) {
+    for (int i = 0; i < LOG_SITE_COUNT; i++) {
+        if ((sites[i].repeats > 0) && (all || ((time - sites[i].repeatStart) >= LOG_REPEAT_FLUSH_TIME))) FlushRepeats(&sites[i]);
+        if ((sites[i].suppressed > 0) && (all || ((time - sites[i].windowStart) >= 1.0))) FlushSuppressed(&sites[i]);
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Queue
+//----------------------------------------------------------------------------------
+// Push a message, false if the ring is full (any thread)
+static bool PushEntry(int level, const char *site, const char *text) {
+    unsigned long pos = AtomicLoad(&enqueuePos);
+    LogEntry *entry = NULL;
+
+    for (;;) {
+        entry = &ring[pos & (LOG_RING_SIZE - 1)];
+        long diff = (long)(AtomicLoad(&entry->sequence) - pos);
+        if (diff == 0) {
+            if (AtomicCompareExchange(&enqueuePos, pos, pos + 1)) break;
+        }
+        else if (diff < 0) return false;
+        pos = AtomicLoad(&enqueuePos);
+    }
+
+    entry->level = level;
+    entry->site = site;
+    entry->time = GetLogTime();
+    memcpy(entry->text, text, LOG_MESSAGE_LENGTH);
+    AtomicStore(&entry->sequence, pos + 1);
+    return true;
+}
+
+// Pop and process every queued message (writer only), returns the number processed
+static int DrainEntries(void) {
+    int count = 0;
+    for (;;) {
+        LogEntry *entry = &ring[dequeuePos & (LOG_RING_SIZE - 1)];
+        if (AtomicLoad(&entry->sequence) != dequeuePos + 1) break;
+
+        ProcessEntry(entry);
+        AtomicStore(&entry->sequence, dequeuePos + LOG_RING_SIZE);
+        dequeuePos++;
+        count++;
+    }
+
+    unsigned long dropped = AtomicExchange(&droppedCount, 0);
+    if (dropped > 0) {
+        char text[LOG_MESSAGE_LENGTH];
+        snprintf(text, sizeof(text), "LOG: %lu messages dropped, ring buffer full", dropped);
+        WriteLine(LOG_WARNING, text, "");
+    }
+
+    return count;
+}
+
+static void StopLogWriter(void);
+
+static void TraceLogAsync(int logLevel, const char *text, va_list args) {
+    char message[LOG_MESSAGE_LENGTH];
+    vsnprintf(message, sizeof(message), text, args);
+
+    // raylib exits right after a fatal message, it can not wait for the writer: the messages queued
+    // before it are written here, then the fatal line
+    if (logLevel == LOG_FATAL) {
+        StopLogWriter();
+        fprintf(stderr, "%s%s\n", GetLevelPrefix(logLevel), message);
+        return;
+    }
+
+#if LOG_BACKEND_THREADS
+    if (!PushEntry(logLevel, text, message)) AtomicIncrement(&droppedCount);
+#else
+    if (PushEntry(logLevel, text, message)) DrainEntries();
+    FlushPendingCounts(GetLogTime(), false);
+#endif
+}
+
+#if LOG_BACKEND_THREADS
+static void RunLogWriter(void) {
+    while (!AtomicLoad(&writerStopping)) {
+        int count = DrainEntries();
+        FlushPendingCounts(GetLogTime(), false);
+        fflush(stdout);
+
+        if (count == 0) {
+#if defined(_MSC_VER)
+            thrd_sleep(&(struct timespec){ .tv_nsec = LOG_WRITER_SLEEP_MS*1000000L }, NULL);
+#else
+            nanosleep(&(struct timespec){ .tv_nsec = LOG_WRITER_SLEEP_MS*1000000L }, NULL);
+#endif
+        }
+    }
+}
+
+#if defined(_MSC_VER)
+static int LogWriterMain(void *arg) { (void)arg; RunLogWriter(); return 0; }
+#else
+static void *LogWriterMain(void *arg) { (void)arg; RunLogWriter(); return NULL; }
+#endif
+#endif
+
+// Install the callback and start the writer thread
+void InitLogBackend(void) {
+    for (unsigned long i = 0; i < LOG_RING_SIZE; i++) ring[i].sequence = i;
+    enqueuePos = 0;
+    dequeuePos = 0;
+    memset(sites, 0, sizeof(sites));
+
+#if LOG_BACKEND_THREADS
+    writerStopping = 0;
+#if defined(_MSC_VER)
+    writerRunning = (thrd_create(&writerThread, LogWriterMain, NULL) == thrd_success);
+#else
+    writerRunning = (pthread_create(&writerThread, NULL, LogWriterMain, NULL) == 0);
+#endif
+    if (!writerRunning) {
+        TraceLog(LOG_WARNING, "LOG: Failed to start the writer thread, keeping synchronous logging");
+        return;
+    }
+#endif
+
+    SetTraceLogCallback(TraceLogAsync);
+
+    // Compiled-in debug messages are shown, Release builds never reach them
+    if (LOG_MIN_LEVEL < LOG_INFO) SetTraceLogLevel(LOG_DEBUG);
+}
+
+// Stop the writer thread and write every queued message and pending count on the calling thread
+static void StopLogWriter(void) {
+#if LOG_BACKEND_THREADS
+    if (!writerRunning) return;
+
+    AtomicStore(&writerStopping, 1);
+#if defined(_MSC_VER)
+    thrd_join(writerThread, NULL);
+#else
+    pthread_join(writerThread, NULL);
+#endif
+    writerRunning = false;
+#endif
+
+    // Messages pushed while the writer was stopping
+    DrainEntries();
+    FlushPendingCounts(0.0, true);
+    fflush(stdout);
+}
+
+// Write the queued messages, stop the writer and restore raylib's logging
+void CloseLogBackend(void) {
+#if LOG_BACKEND_THREADS
+    if (!writerRunning) return;
+#endif
+
+    SetTraceLogCallback(NULL);
+    StopLogWriter();
+}
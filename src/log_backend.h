@@ -0,0 +1,30 @@
+// Asynchronous TraceLog backend
+// Installed with SetTraceLogCallback(): callers only format the message and push it into a
+// lock-free ring buffer, a background writer thread does the console output. The writer
+// rate limits every call site (TraceLog format string) and folds identical consecutive
+// messages of a call site into "(repeated N times)" lines.
+// Include this header after every other header: it wraps TraceLog() so calls below
+// LOG_MIN_LEVEL are compiled out entirely (Release builds drop LOG_DEBUG and below).
+
+#ifndef LOG_BACKEND_H
+#define LOG_BACKEND_H
+
+#include "raylib.h"
+
+#ifndef LOG_MIN_LEVEL
+    #if defined(NDEBUG)
+        #define LOG_MIN_LEVEL LOG_INFO
+    #else
+        #define LOG_MIN_LEVEL LOG_ALL
+    #endif
+#endif
+
+#define LOG_SITE_RATE_LIMIT 5    // Lines per second written for a hot call site (see log_backend.c), the rest are counted
+
+void InitLogBackend(void);       // Install the callback and start the writer thread
+void CloseLogBackend(void);      // Write the queued messages, stop the writer and restore raylib's logging
+
+// The level is a constant at every call site, so filtered calls (and their arguments) disappear
+#define TraceLog(logLevel, ...) do { if ((logLevel) >= LOG_MIN_LEVEL) TraceLog(logLevel, __VA_ARGS__); } while (0)
+
+#endif // LOG_BACKEND_H
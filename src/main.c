@@ -3,6 +3,18 @@
 #include "resource_dir.h"
 #include "raymath.h"    // For Vector3Distance
 #include "rlgl.h"       // For rl* functions
+#include "culling.h"    // Frustum culling for the world draw lists
+#include "spatial_hash.h" // XZ spatial hash for collision queries
+#include "road_grid.h"    // Segment-binned grid for road distance queries
+#include "asset_loader.h" // Background loading of the startup assets
+#include "profiler.h"     // CPU zone timings, overlay and CSV dump
+#include "trace_capture.h" // Chrome trace capture of zones, loads and game events
+#include "render_stats.h"  // Draw call and triangle counters
+#include "flythrough.h"    // Camera path replay and benchmark report
+#include "scenario.h"      // Stress scenario counts and ramps
+#include "herd.h"          // Structure-of-arrays animal storage and movement kernels
+#include "job_system.h"    // Work-stealing job pool for the entity updates
+#include "mesh_lod.h"      // Simplified model levels picked by screen size
 #include "math.h"
 #include <stdlib.h>
 #include <stdio.h>
@@ -10,28 +22,53 @@
 // Forward declaration for DrawTextRec (with tint) to enable word-wrapped text
 void DrawTextRec(Font font, const char *text, Rectangle rec, float fontSize, float spacing, bool wordWrap, Color tint);
 #include <string.h>  // For bool type
+#include "log_backend.h" // Async TraceLog backend, must stay the last include (wraps TraceLog)
 #define MAX_COLUMNS 20
-#define MAX_ANIMALS 100
+#define MAX_ANIMALS 100 // Default animal pool size, scenarios asking for more grow it (see InitEntityPools)
 #define MAX_BUILDINGS 120  // Increased for more fence segments and future expansion
-#define MAX_CLOUDS 5000   // Increased number of clouds
-#define MAX_PLANTS 3000 // Maximum number of plants (increased from 1000 to 2000)
+#define MAX_CLOUDS 5000   // Default number of clouds, set by the "clouds" scenario key
+#define MAX_PLANTS 3000 // Default plant pool size, scenarios asking for more grow it
 #define MAX_CLOUD_TYPES 1 // Number of different cloud types/textures
 #define CLOUD_LAYER_HEIGHT 120.0f  // Height for all clouds
 #define CLOUD_COVERAGE_RADIUS 1500.0f // Expanded cloud coverage for more distant clouds
 #define CLOUD_MIN_SIZE 2.0f  // Smaller minimum cloud size
 #define CLOUD_MAX_SIZE 8.0f // Smaller maximum cloud size
 #define CLOUD_VIEW_DISTANCE 800.0f // Increased view distance for clouds
+#define CLOUD_CHUNK_SIZE 250.0f    // World size (XZ) of each baked cloud chunk
+#define CLOUD_CHUNK_MAX_BOXES 8000 // Boxes per chunk mesh (8 vertices each, must fit 16-bit indices)
+#define CLOUD_WIND_SPEED 1.5f      // Cloud drift speed in units per second
 #define FIXED_TERRAIN_SIZE 512.0f      // Total terrain size
 #define TERRAIN_CHUNKS_PER_SIDE 5      // 5x5 grid of terrain chunks
 #define CHUNK_SIZE (FIXED_TERRAIN_SIZE / TERRAIN_CHUNKS_PER_SIDE)  // Size of each terrain chunk
 #define MAX_TERRAIN_CHUNKS (TERRAIN_CHUNKS_PER_SIDE * TERRAIN_CHUNKS_PER_SIDE)  // Total number of chunks
-#define CAMERA_MOVE_SPEED 0.11f // Reduced for walking simulator feel
+#define TERRAIN_LOD_COUNT 4            // Chunk resolutions 128, 64, 32 and 16 quads per side
+#define TERRAIN_LOD_BASE_RESOLUTION 128 // Quads per side of the full resolution level
+#define TERRAIN_LOD_RING_SIZE (CHUNK_SIZE * 0.5f) // Camera distance covered by each LOD ring
+#define CAMERA_MOVE_SPEED 6.6f  // Walking speed in units per second (reduced for walking simulator feel)
+#define SIMULATION_TIMESTEP (1.0f/60.0f) // Fixed update step, animal speeds and animation rates are per step
+#define SIMULATION_MAX_STEPS 250         // Steps per frame at most, beyond that the farm falls behind instead of stalling the frame
 #define HUMAN_HEIGHT 1.75f     // Average human height in meters
-#define FOG_DENSITY 0.02f      // Fog density for distance effect
+#define FOG_DENSITY 0.012f     // Fog density for distance effect (exponential squared)
 #define FOG_COLOR (Color){ 200, 225, 255, 255 }  // Light blue fog
-#define SKY_COLOR (Color){ 135, 206, 235, 255 }  // Light blue sky color
+#define FOG_OPAQUE_DISTANCE (2.355f/FOG_DENSITY) // Distance where the fog term drops below 1/256, sqrt(ln(256))/density
+#define SKY_COLOR (Color){ 135, 206, 235, 255 }  // Light blue sky color, background when the sky shader is unavailable
+#define SKY_ZENITH_COLOR (Color){ 80, 145, 220, 255 }   // Sky dome straight up
+#define SKY_HORIZON_COLOR FOG_COLOR                     // Sky dome at the horizon, matches the fog
+#define SKY_GROUND_COLOR FOG_COLOR                      // Sky dome below the horizon, where the culled terrain ends
+#define SKY_DOME_RADIUS 500.0f  // Inside the far clip plane, the dome is drawn without depth writes so any size works
+#define IMPOSTOR_VIEW_COUNT 8           // Captured views around the Y axis per impostor atlas
+#define IMPOSTOR_CELL_SIZE 256          // Pixels per side of one view in the atlas
+#define IMPOSTOR_DEFAULT_DISTANCE 45.0f // Camera distance where trees and bushes turn into billboards (--impostor-distance)
+#define IMPOSTOR_FADE_BAND 6.0f         // Width of the dithered cross-fade around the impostor distance
 #define DIALOG_DISPLAY_TIME 8.0f  // Time to display dialog message in seconds
 
+// Shaders are loaded from resources/shaders/glsl<version>/
+#if defined(PLATFORM_DESKTOP)
+    #define GLSL_VERSION 330
+#else   // PLATFORM_WEB, PLATFORM_ANDROID
+    #define GLSL_VERSION 100
+#endif
+
 // Chicken enclosure constants
 #define ENCLOSURE_CENTER_2 (Vector3){ -45.0f, 0.0f, -3.0f }
 #define ENCLOSURE_WIDTH_2 15.0f
@@ -146,6 +183,23 @@ typedef enum {
 } ActiveMenu;
 
 ActiveMenu currentMenu = MENU_NONE;
+ActiveMenu tracedMenu = MENU_NONE; // Last menu reported to the trace capture
+
+// Get a display name for a menu (trace markers)
+const char *GetMenuName(ActiveMenu menu) {
+    switch (menu) {
+        case MENU_NONE: return "None";
+        case MENU_BARN: return "Barn";
+        case MENU_BANK: return "Bank";
+        case MENU_FEED_CHICKENS: return "Feed chickens";
+        case MENU_FEED_PIGS: return "Feed pigs";
+        case MENU_FEED_COWS: return "Feed cows";
+        case MENU_COLLECT_CHICKENS: return "Collect chickens";
+        case MENU_COLLECT_PIGS: return "Collect pigs";
+        case MENU_COLLECT_COWS: return "Collect cows";
+        default: return "Unknown";
+    }
+}
 int menuSelectedItem = 0; // For navigating menu options
 
 // Flags for showing interaction prompts
@@ -162,7 +216,7 @@ bool IsNearBuilding(Vector3 playerPos, Vector3 buildingPos, float interactionRad
     bool isNear = distSq < (interactionRadius * interactionRadius);
     
     if (isNear) {
-        TraceLog(LOG_INFO, "Player is near building at (%.2f, %.2f, %.2f). Distance: %.2f, Radius: %.2f", 
+        TraceLog(LOG_DEBUG, "Player is near building at (%.2f, %.2f, %.2f). Distance: %.2f, Radius: %.2f", 
                  buildingPos.x, buildingPos.y, buildingPos.z, sqrtf(distSq), interactionRadius);
     }
     
@@ -217,10 +271,10 @@ typedef enum {
     PLANT_TYPE_COUNT
 } PlantType;
 
-// Plant structure
+// Plant structure - a compact instance record, the model itself is shared per PlantType
 typedef struct {
     PlantType type;
-    Model model; // This will now refer to one of the globally loaded models
+    Matrix transform;    // World transform (model transform * scale * rotation * translation), built once at spawn
     Vector3 position;
     float scale;
     float rotationAngle;
@@ -229,16 +283,22 @@ typedef struct {
 
 // Function prototypes
 bool IsCollisionWithBuilding(Vector3 position, float radius, int* buildingIndex);
-bool IsCollisionWithAnimal(Vector3 position, float radius, int* animalIndex);
+bool IsCollisionWithAnimal(Vector3 position, float radius, int* animalId);
+void InitCollisionGrids(void);
+void RegisterStaticColliders(void);
+void UnloadCollisionGrids(void);
 bool IsPositionOnRoad(Vector3 position, float roadWidth); // New function prototype
 void InitPlant(Plant* plant, PlantType type, Vector3 position, float scale, float rotation);
 void SpawnPlant(PlantType type, Vector3 position, float scale, float rotation);
 Vector3 GetRandomPlantPosition(float terrainSize);
-void DrawPlants(Camera camera); // Modified to accept Camera
+void DrawPlants(Camera camera, const Frustum *frustum); // Modified to accept Camera
 void UnloadPlantResources(void);
 void ClearPlantsNearRoads(float clearExtraRadius); // Function to clear plants blocking roads
 bool IsNearBankOrOnRoadToBank(Vector3 position); // Check if player is near bank or on road to bank
-void UpdateCameraCustom(Camera *camera, int mode); // Forward declaration
+void UpdateCameraCustom(Camera *camera, int mode, float deltaTime); // Forward declaration
+ModelLods* AcquireModelLods(Model model, const char *name); // Shared simplified levels of a model, see the Model LOD Registry
+void ReleaseModelLods(Model model);
+void AttachAnimalSound(AnimalType type, int slot); // Give an animal its sound, see LoadAnimalSounds()
 
 // Human character states
 typedef enum {
@@ -260,8 +320,13 @@ typedef struct {
     int walkingAnimCount;
     int idleAnimCount;
     int lookingAnimCount;
+    ModelLods *walkingLods;  // Simplified levels of the models (NULL: full detail only)
+    ModelLods *idleLods;
+    ModelLods *lookingLods;
     int animFrameCounter;
     Vector3 position;
+    Vector3 prevPosition;    // Position before the last simulation step, drawn interpolated
+    float prevRotationAngle;
     Vector3 targetPosition;
     Vector3 direction;
     float speed;
@@ -286,55 +351,177 @@ Model globalGrassModel;
 Model globalFlowerModel;
 Model globalFlowerModel_type2;
 Model globalBushWithFlowersModel; // Added for the new bush with flowers type
+ModelLods *plantLods[PLANT_TYPE_COUNT] = { 0 }; // Simplified levels of the plant models (NULL: full detail only)
 // --- End Global Models for Plants ---
 
+// --- Distance Fog ---
+// Exponential squared fog shared by the world shaders: fog.vs/fs for terrain, roads, buildings and
+// CPU skinned models, and the same fog term in the vegetation instancing and skinning shaders.
+// Past FOG_OPAQUE_DISTANCE everything has the fog color, which the sky dome has at and below the
+// horizon, so the draw lists cull beyond it without visible pop-in.
+#define MAX_FOG_SHADERS 8
+
+Shader fogShader = { 0 };
+bool fogEnabled = false;                     // False draws unfogged with no distance limit
+Shader fogShaders[MAX_FOG_SHADERS] = { 0 };  // Every shader with the fog uniforms, see RegisterFogShader()
+int fogViewPosLocs[MAX_FOG_SHADERS] = { 0 };
+int fogShaderCount = 0;
+Vector3 fogViewPosition = { 0 };             // Camera position of the frame, set by UpdateFog()
+// --- End Distance Fog ---
+
+// --- Instanced Vegetation Renderer ---
+// Plants are grouped by PlantType into one instance transform buffer per type, built once
+// after spawning/clearing, and every mesh of the shared model is drawn with DrawMeshInstanced.
+typedef struct {
+    Model *model;            // Shared model for this plant type
+    ModelLods *lods;         // Simplified levels of the model (NULL: full detail only)
+    Material *materials;     // Copies of the model materials using the instancing shader (maps are shared)
+    Matrix *transforms;      // Transforms of every active plant of this type
+    Vector3 *positions;      // Instance positions, used for the per-frame distance filter
+    BoundingSphere *spheres; // Instance world bounds, used for frustum culling
+    float *scales;           // Instance scales and rotations (degrees), to orient the impostor billboards
+    float *rotations;
+    Matrix *visible;         // Scratch buffer for the instances that pass the per-frame filter, count entries per LOD level
+    Matrix *impostorVisible; // Scratch buffer for the instances drawn as impostors
+    int count;
+    float maxDrawDistance;   // 0.0f means the type is always drawn
+} VegetationBatch;
+
+VegetationBatch vegetationBatches[PLANT_TYPE_COUNT] = { 0 };
+Shader vegetationShader = { 0 };
+bool vegetationInstancingEnabled = false; // False falls back to one DrawMesh per plant
+
+// Distant trees and bushes are drawn as camera-facing billboards textured from an atlas of views
+// captured around the model at load time. Around impostorDistance the mesh and the billboard
+// cross-fade with a screen-space dither, each pixel is drawn by exactly one of them. The per-instance
+// fade and atlas view ride in the unused bottom row of the instance transforms (see DrawPlants()).
+typedef struct {
+    RenderTexture2D atlas;   // IMPOSTOR_VIEW_COUNT views side by side, view v seen from angle v*360/count
+    Mesh quad;               // Billboard in model units, facing +Z
+    Material material;       // Impostor shader with the atlas texture
+    bool ready;
+} Impostor;
+
+Impostor impostors[PLANT_TYPE_COUNT] = { 0 };  // Kept across vegetation batch rebuilds
+Shader impostorShader = { 0 };
+float impostorDistance = IMPOSTOR_DEFAULT_DISTANCE;
+// --- End Instanced Vegetation Renderer ---
+
+// --- GPU Skinning ---
+// Skinned models whose materials use skinningShader only have their bone matrices updated per frame
+// (UpdateModelAnimationBones), the vertices are transformed in the vertex shader.
+// Everything else keeps the CPU path (UpdateModelAnimation) that re-uploads the vertex buffers.
+#define SUPPORT_GPU_SKINNING     // Comment if raylib is built without RL_SUPPORT_MESH_GPU_SKINNING (no bone VBOs)
+#define MAX_SKINNING_BONES 128   // Must match the boneMatrices array size in skinning.vs
+
+// Mesh vertex buffer slots used by raylib for bone data (see rlgl.h)
+#define SKINNING_VBO_BONEIDS 7
+#define SKINNING_VBO_BONEWEIGHTS 8
+
+Shader skinningShader = { 0 };
+bool gpuSkinningEnabled = false; // False when the shader or the boneIds/boneWeights attributes are unavailable
+// --- End GPU Skinning ---
+
 // Building structure
 typedef struct {
     Model model;
     Vector3 position;
     float scale;
     float rotationAngle;
+    BoundingBox bounds;  // Cached world bounds, see UpdateBuildingBounds()
+    ModelLods *lods;     // Simplified levels of the model, shared by the buildings using it (NULL: full detail only)
 } Building;
 
+// Terrain chunk edges, set in TerrainChunk.edgeMask when the neighbour on that side is one LOD coarser
+typedef enum {
+    TERRAIN_EDGE_NEG_Z = 1,
+    TERRAIN_EDGE_POS_X = 2,
+    TERRAIN_EDGE_POS_Z = 4,
+    TERRAIN_EDGE_NEG_X = 8
+} TerrainEdge;
+
 // Terrain chunk structure
 typedef struct {
-    Model model;
     Vector2 position;    // Grid position (in chunk coordinates)
     Vector3 worldPos;    // World position
+    BoundingBox bounds;  // Cached world bounds
+    int lodLevel;        // Current LOD level, 0 is full resolution
+    int edgeMask;        // TerrainEdge flags of the edges stitched to a coarser neighbour
     bool active;
 } TerrainChunk;
 
 // Animal types enum
 
 
-// Animal struct to store per-animal data
+// Per-species animal assets, loaded once and shared by every animal of that type
 typedef struct {
-    AnimalType type;
     Model walkingModel;
     Model idleModel;
     ModelAnimation* walkingAnim;
     ModelAnimation* idleAnim;
     int walkingAnimCount;
     int idleAnimCount;
-    int animFrameCounter;
-    
-    Vector3 position;
-    Vector3 spawnPosition;   // Original spawn position to return to
-    Vector3 direction;
-    float scale;
-    float speed;
-    float rotationAngle;
-    float moveTimer;
-    float moveInterval;
-    float maxWanderDistance; // Maximum distance from spawn point
-    bool isMoving;
-    bool active;
-    void* soundData; // Added sound data pointer
-} Animal;
-
-// Global array of animals
-Animal animals[MAX_ANIMALS];
+    ModelLods *walkingLods;  // Simplified levels of the models (NULL: full detail only)
+    ModelLods *idleLods;
+    float boundsRadius;      // Radius around the animal position enclosing both models at scale 1
+    int refCount;            // Number of animals using these assets, unloaded when it drops to 0
+} AnimalAssets;
+
+// Animal state, one structure-of-arrays herd per species (see herd.h).
+// An animal id packs its species and herd slot, the collision grid and the player collision use it.
+#define ANIMAL_ID_TYPE_BITS 3   // Bits of the species in an animal id, ANIMAL_COUNT must fit
+
+Herd herds[ANIMAL_COUNT] = { 0 };   // Allocated by InitEntityPools()
+int maxAnimals = 0;                 // Animals of all herds together the game may spawn
 int animalCount = 0;
+
+// Get the id of the animal in a herd slot
+int GetAnimalId(AnimalType type, int slot) {
+    return (slot << ANIMAL_ID_TYPE_BITS) | (int)type;
+}
+
+// Get the species of an animal id
+AnimalType GetAnimalType(int id) {
+    return (AnimalType)(id & ((1 << ANIMAL_ID_TYPE_BITS) - 1));
+}
+
+// Get the herd slot of an animal id
+int GetAnimalSlot(int id) {
+    return id >> ANIMAL_ID_TYPE_BITS;
+}
+
+// Get the position of an animal id
+Vector3 GetAnimalPosition(int id) {
+    Herd *herd = &herds[GetAnimalType(id)];
+    int slot = GetAnimalSlot(id);
+    return (Vector3){ herd->x[slot], herd->y[slot], herd->z[slot] };
+}
+
+// --- Collision Grids ---
+// XZ spatial hashes answering the collision queries from neighbouring cells only.
+// Buildings and trees are registered once as circles (RegisterStaticColliders), animals as points
+// that are moved after every update.
+#define COLLISION_CELL_SIZE 8.0f
+#define MAX_ANIMAL_COLLISION_RADIUS 1.8f // Largest radius used by IsCollisionWithAnimal()
+#define COLLISION_QUERY_IDS 256          // Candidates a collision query keeps on the stack, crowded cells go to the heap
+#define PEN_MAX_DENSITY 2.0f             // Animals per square unit an enclosure takes at most
+
+SpatialHash buildingGrid = { 0 };
+SpatialHash treeGrid = { 0 };
+SpatialHash animalGrid = { 0 };
+float maxAnimalScale = 0.0f; // Largest scale of any spawned animal, bounds the animal-animal query
+
+// Query a collision grid into buffer, or into a heap buffer when the cells hold more ids than it
+// has room for. *ids is set to the result, free it with MemFree() when it isn't buffer.
+int QueryCollisionGrid(const SpatialHash *grid, Vector3 position, float radius, int *buffer, int bufferSize, int **ids) {
+    *ids = buffer;
+    int count = SpatialHashQuery(grid, position, radius, buffer, bufferSize);
+    if (count <= bufferSize) return count;
+
+    *ids = (int *)MemAlloc(count*sizeof(int));
+    return SpatialHashQuery(grid, position, radius, *ids, count);
+}
+// --- End Collision Grids ---
 int animalCountByType[ANIMAL_COUNT] = {0};
 
 // Global human character
@@ -343,8 +530,52 @@ Human human;
 // Global array of buildings
 Building buildings[MAX_BUILDINGS];
 
-// Global array of plants
-Plant plants[MAX_PLANTS];
+// --- Static World Batching ---
+// Buildings and fences never move, so once they are placed their meshes are pre-transformed to world
+// space and merged into one vertex buffer per distinct material (BuildStaticWorld), each drawn with a
+// single DrawMesh and culled by its merged bounds. raylib meshes have 16-bit indices, a material with
+// more than STATIC_BATCH_MAX_VERTICES vertices is split over several batches, and a single building
+// mesh above that limit is left out of the batches and drawn on its own with its building transform.
+// Every batch is also merged from the simplified levels of its buildings (see mesh_lod.h) and drawn at
+// the level its nearest building would get, so no building in it is drawn coarser than on its own.
+#define MAX_STATIC_MATERIALS 64
+#define MAX_STATIC_BATCHES 96
+#define MAX_STATIC_LOOSE_PIECES 32
+#define STATIC_BATCH_MAX_VERTICES 65535
+
+typedef struct {
+    Mesh levels[MAX_MODEL_LODS]; // Merged world space geometry of each level, levels[0] is full detail
+    int levelCount;
+    float pieceRadius;       // Largest bounding radius of the buildings merged in
+    BoundingBox bounds;
+    int materialIndex;       // Entry in staticMaterials
+} StaticBatch;
+
+// One mesh of a building, the unit merged into a batch
+typedef struct {
+    int building;
+    int mesh;
+} StaticPiece;
+
+// A building mesh too large for a batch, drawn unbatched
+typedef struct {
+    StaticPiece piece;
+    int materialIndex;       // Entry in staticMaterials
+} StaticLoosePiece;
+
+Material staticMaterials[MAX_STATIC_MATERIALS] = { 0 };  // Copies of the building materials (maps and shader stay owned by the models)
+int staticMaterialCount = 0;
+StaticBatch staticBatches[MAX_STATIC_BATCHES] = { 0 };
+int staticBatchCount = 0;
+StaticLoosePiece staticLoosePieces[MAX_STATIC_LOOSE_PIECES] = { 0 };
+int staticLoosePieceCount = 0;
+bool staticBuildingShown[MAX_BUILDINGS] = { 0 };         // Buildings merged into the batches, see UpdateStaticWorld()
+bool staticWorldBuilt = false;                            // False draws every building with DrawModelEx
+// --- End Static World Batching ---
+
+// Global pool of plants, allocated by InitEntityPools()
+Plant *plants = NULL;
+int maxPlants = 0;
 int plantCount = 0;
 
 // Moved road-related global variables and definitions
@@ -355,7 +586,12 @@ float roadRotationAngle;
 float roadLength;
 float roadWidth = 4.0f; 
 
-#define MAX_CUSTOM_ROADS 10
+// Road query grid (see road_grid.h): queries up to this distance from a road centerline
+// are answered from a single cell, larger ones fall back to checking every segment
+#define ROAD_GRID_CELL_SIZE 8.0f
+#define ROAD_GRID_MAX_QUERY_DISTANCE 10.0f
+
+#define MAX_CUSTOM_ROADS 32 // The road grid tells at most 32 roads apart (CountRoadsNearPoint)
 
 typedef struct {
     Vector3 points[MAX_PATH_POINTS];
@@ -371,6 +607,18 @@ typedef struct {
 CustomRoad allCustomRoads[MAX_CUSTOM_ROADS];
 int totalCustomRoadsCount = 0; // How many roads are currently defined
 
+// Returns the globally loaded model shared by all plants of a type
+Model *GetPlantModel(PlantType type) {
+    switch(type) {
+        case PLANT_TREE: return &globalTreeModel;
+        case PLANT_GRASS: return &globalGrassModel;
+        case PLANT_FLOWER: return &globalFlowerModel;
+        case PLANT_FLOWER_TYPE2: return &globalFlowerModel_type2;
+        case PLANT_BUSH_WITH_FLOWERS: return &globalBushWithFlowersModel;
+        default: return NULL;
+    }
+}
+
 // Function to initialize a new plant
 void InitPlant(Plant* plant, PlantType type, Vector3 position, float scale, float rotation) {
     plant->type = type;
@@ -379,39 +627,25 @@ void InitPlant(Plant* plant, PlantType type, Vector3 position, float scale, floa
     plant->rotationAngle = rotation;
     plant->active = true;
 
-    // Assign pre-loaded global model based on type
-    switch(type) {
-        case PLANT_TREE:
-            plant->model = globalTreeModel;
-            break;
-        case PLANT_GRASS:
-            plant->model = globalGrassModel;
-            break;
-        case PLANT_FLOWER:
-            plant->model = globalFlowerModel;
-            break;
-        case PLANT_FLOWER_TYPE2:
-            plant->model = globalFlowerModel_type2;
-            break;
-        case PLANT_BUSH_WITH_FLOWERS: // Added case for new bush with flowers type
-            plant->model = globalBushWithFlowersModel;
-            break;
-        default:
-            plant->active = false; // Invalid type
-            TraceLog(LOG_WARNING, "Attempted to initialize invalid plant type.");
-            // Assign a default or empty model to avoid issues if model is not loaded
-            // For safety, ensure global models are loaded before this is called.
-            // If a type is invalid, plant->model might remain uninitialized if not handled.
-            // Consider assigning a known invalid/empty model or checking plant->active before drawing.
-            break;
+    Model *model = GetPlantModel(type);
+    if (model == NULL) {
+        plant->active = false; // Invalid type
+        plant->transform = MatrixIdentity();
+        TraceLog(LOG_WARNING, "Attempted to initialize invalid plant type.");
+        return;
     }
-    // No need to check plant->model.meshCount here if we ensure global models are loaded correctly.
-    // The active flag will prevent drawing if the type was invalid.
+
+    // Same transform DrawModelEx() would build every frame, computed once here
+    Matrix matScale = MatrixScale(scale, scale, scale);
+    Matrix matRotation = MatrixRotate((Vector3){0.0f, 1.0f, 0.0f}, rotation*DEG2RAD);
+    Matrix matTranslation = MatrixTranslate(position.x, position.y, position.z);
+    Matrix matTransform = MatrixMultiply(MatrixMultiply(matScale, matRotation), matTranslation);
+    plant->transform = MatrixMultiply(model->transform, matTransform);
 }
 
 // Function to spawn a plant of specified type
 void SpawnPlant(PlantType type, Vector3 position, float scale, float rotation) {
-    if (plantCount >= MAX_PLANTS) {
+    if (plantCount >= maxPlants) {
         TraceLog(LOG_WARNING, "Cannot spawn more plants - maximum limit reached.");
         return;
     }
@@ -442,7 +676,7 @@ Vector3 GetRandomPlantPosition(float terrainSize) { // terrainSize argument is k
 
         bool collisionWithBuilding = false;
         for (int i = 0; i < MAX_BUILDINGS; i++) {
-            if (buildings[i].model.meshCount == 0) continue; // Skip uninitialized buildings
+            if (buildings[i].scale == 0.0f) continue; // Skip unused slots (as RegisterStaticColliders, headless buildings have no meshes)
             if (i == 5) continue; // Skip chicken coop collision
 
             float exclusionRadiusForPlant;
@@ -481,23 +715,373 @@ Vector3 GetRandomPlantPosition(float terrainSize) { // terrainSize argument is k
     return position;
 }
 
-// Draw all active plants
-void DrawPlants(Camera camera) { // Modified to accept Camera
-    float maxDrawDistanceFlowerType2 = 40.0f; // Max distance to draw flower type 2
-    float maxDrawDistanceBushWithFlowers = 50.0f; // Max distance to draw bush with flowers
+// Set the fog parameters of a shader with the fog uniforms, UpdateFog() keeps its view position current
+void RegisterFogShader(Shader shader) {
+    // Without the fog shader the others stay unfogged too (fogDensity keeps its default of 0)
+    int viewPosLoc = GetShaderLocation(shader, "viewPos");
+    if (!fogEnabled || (viewPosLoc == -1) || (fogShaderCount == MAX_FOG_SHADERS)) return;
+
+    float density = FOG_DENSITY;
+    Vector4 color = ColorNormalize(FOG_COLOR);
+    SetShaderValue(shader, GetShaderLocation(shader, "fogDensity"), &density, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(shader, GetShaderLocation(shader, "fogColor"), &color, SHADER_UNIFORM_VEC4);
+
+    fogShaders[fogShaderCount] = shader;
+    fogViewPosLocs[fogShaderCount] = viewPosLoc;
+    fogShaderCount++;
+}
+
+// Load the fog shader, the fog is disabled (no distance limits) if it can't be used
+void InitFog(void) {
+    fogShader = LoadShader(TextFormat("shaders/glsl%i/fog.vs", GLSL_VERSION),
+                           TextFormat("shaders/glsl%i/fog.fs", GLSL_VERSION));
+    fogEnabled = (fogShader.id != rlGetShaderIdDefault()) && (fogShader.locs[SHADER_LOC_MATRIX_MODEL] != -1);
+    if (!fogEnabled) {
+        TraceLog(LOG_WARNING, "Fog shader unavailable, the world is drawn without fog or distance limits");
+        return;
+    }
+    RegisterFogShader(fogShader);
+    TraceLog(LOG_INFO, "Fog enabled, draw distance %.0f units", FOG_OPAQUE_DISTANCE);
+}
+
+// Switch the materials of a model that use the default shader to the fog shader
+void ApplyFogShader(Model *model) {
+    if (!fogEnabled) return;
+    for (int i = 0; i < model->materialCount; i++) {
+        if (model->materials[i].shader.id == rlGetShaderIdDefault()) model->materials[i].shader = fogShader;
+    }
+}
+
+// Set the view position of every fog shader, once per frame before drawing
+void UpdateFog(Camera camera) {
+    fogViewPosition = camera.position;
+    for (int i = 0; i < fogShaderCount; i++) {
+        SetShaderValue(fogShaders[i], fogViewPosLocs[i], &camera.position, SHADER_UNIFORM_VEC3);
+    }
+}
+
+// Check if any point of a box is nearer than the fog opaque distance (always true without fog)
+bool IsBoxInFogRange(BoundingBox box) {
+    if (!fogEnabled) return true;
+    Vector3 closest = Vector3Clamp(fogViewPosition, box.min, box.max);
+    return Vector3DistanceSqr(fogViewPosition, closest) < FOG_OPAQUE_DISTANCE*FOG_OPAQUE_DISTANCE;
+}
+
+// Check if any point of a sphere is nearer than the fog opaque distance (always true without fog)
+bool IsSphereInFogRange(BoundingSphere sphere) {
+    if (!fogEnabled) return true;
+    float range = FOG_OPAQUE_DISTANCE + sphere.radius;
+    return Vector3DistanceSqr(fogViewPosition, sphere.center) < range*range;
+}
+
+// Unload the fog shader (the other fog shaders belong to their renderers)
+void UnloadFog(void) {
+    if (fogShader.id != rlGetShaderIdDefault()) UnloadShader(fogShader);
+    fogShaderCount = 0;
+    fogEnabled = false;
+}
+
+// Load the instancing shader used by the vegetation renderer
+void InitVegetationRenderer(void) {
+    vegetationShader = LoadShader(TextFormat("shaders/glsl%i/vegetation_instancing.vs", GLSL_VERSION),
+                                  TextFormat("shaders/glsl%i/vegetation_instancing.fs", GLSL_VERSION));
+
+    // LoadShader() falls back to the default shader on failure, which has no instanceTransform attribute
+    vegetationInstancingEnabled = (vegetationShader.id != rlGetShaderIdDefault()) &&
+                                  (vegetationShader.locs[SHADER_LOC_VERTEX_INSTANCE_TX] != -1);
+    if (!vegetationInstancingEnabled) {
+        TraceLog(LOG_WARNING, "Vegetation instancing shader unavailable, falling back to per-plant draws");
+    } else {
+        RegisterFogShader(vegetationShader);
+    }
+}
+
+// Capture a plant model from IMPOSTOR_VIEW_COUNT angles around the Y axis into an atlas and build
+// the billboard for it. The views are orthographic and centered on the model bounds, so the
+// billboard covers the same space as the model at any angle.
+Impostor LoadImpostor(Model model) {
+    Impostor impostor = { 0 };
+    BoundingBox bounds = GetModelBoundingBox(model);
+    float radiusX = fmaxf(fabsf(bounds.min.x), fabsf(bounds.max.x));
+    float radiusZ = fmaxf(fabsf(bounds.min.z), fabsf(bounds.max.z));
+    float size = 1.05f*fmaxf(2.0f*sqrtf(radiusX*radiusX + radiusZ*radiusZ), bounds.max.y - bounds.min.y); // Margin keeps the mipmaps of neighbour views apart
+    float centerY = 0.5f*(bounds.min.y + bounds.max.y);
+    if (size <= 0.0f) return impostor;
+
+    impostor.atlas = LoadRenderTexture(IMPOSTOR_VIEW_COUNT*IMPOSTOR_CELL_SIZE, IMPOSTOR_CELL_SIZE);
+    if (impostor.atlas.id == 0) return impostor;
+
+    // The model is drawn with the vegetation shader for its alpha cutout, instanced once at the
+    // model transform, unfogged (the billboard gets the fog where it stands)
+    float density = 0.0f;
+    int densityLoc = GetShaderLocation(vegetationShader, "fogDensity");
+    SetShaderValue(vegetationShader, densityLoc, &density, SHADER_UNIFORM_FLOAT);
+
+    BeginTextureMode(impostor.atlas);
+    ClearBackground(BLANK);
+    rlEnableDepthTest();
+    for (int v = 0; v < IMPOSTOR_VIEW_COUNT; v++) {
+        // BeginMode3D() would take the aspect of the whole atlas, each view sets up its own cell
+        float angle = v*2.0f*PI/IMPOSTOR_VIEW_COUNT;
+        Vector3 target = { 0.0f, centerY, 0.0f };
+        Vector3 eye = { sinf(angle)*2.0f*size, centerY, cosf(angle)*2.0f*size };
+
+        rlDrawRenderBatchActive();
+        rlViewport(v*IMPOSTOR_CELL_SIZE, 0, IMPOSTOR_CELL_SIZE, IMPOSTOR_CELL_SIZE);
+        rlMatrixMode(RL_PROJECTION);
+        rlPushMatrix();
+        rlLoadIdentity();
+        rlOrtho(-0.5*size, 0.5*size, -0.5*size, 0.5*size, 0.01, 4.0*size);
+        rlMatrixMode(RL_MODELVIEW);
+        rlLoadIdentity();
+        rlMultMatrixf(MatrixToFloat(MatrixLookAt(eye, target, (Vector3){ 0.0f, 1.0f, 0.0f })));
+
+        for (int m = 0; m < model.meshCount; m++) {
+            Material material = model.materials[model.meshMaterial[m]];
+            material.shader = vegetationShader;
+            DrawMeshInstanced(model.meshes[m], material, &model.transform, 1);
+        }
+
+        rlDrawRenderBatchActive();
+        rlMatrixMode(RL_PROJECTION);
+        rlPopMatrix();
+        rlMatrixMode(RL_MODELVIEW);
+        rlLoadIdentity();
+    }
+    EndTextureMode();
+
+    density = fogEnabled ? FOG_DENSITY : 0.0f;
+    SetShaderValue(vegetationShader, densityLoc, &density, SHADER_UNIFORM_FLOAT);
+
+    GenTextureMipmaps(&impostor.atlas.texture);
+    SetTextureFilter(impostor.atlas.texture, TEXTURE_FILTER_TRILINEAR);
+    SetTextureWrap(impostor.atlas.texture, TEXTURE_WRAP_CLAMP);
+
+    // Quad centered on the model bounds, render texture rows start at the bottom so v runs upwards
+    Mesh quad = { 0 };
+    quad.vertexCount = 4;
+    quad.triangleCount = 2;
+    quad.vertices = (float *)MemAlloc(4*3*sizeof(float));
+    quad.texcoords = (float *)MemAlloc(4*2*sizeof(float));
+    quad.normals = (float *)MemAlloc(4*3*sizeof(float));
+    quad.indices = (unsigned short *)MemAlloc(6*sizeof(unsigned short));
+    const float corners[4][2] = { { -0.5f, -0.5f }, { 0.5f, -0.5f }, { 0.5f, 0.5f }, { -0.5f, 0.5f } };
+    for (int i = 0; i < 4; i++) {
+        quad.vertices[i*3 + 0] = corners[i][0]*size;
+        quad.vertices[i*3 + 1] = centerY + corners[i][1]*size;
+        quad.vertices[i*3 + 2] = 0.0f;
+        quad.texcoords[i*2 + 0] = corners[i][0] + 0.5f;
+        quad.texcoords[i*2 + 1] = corners[i][1] + 0.5f;
+        quad.normals[i*3 + 0] = 0.0f;
+        quad.normals[i*3 + 1] = 0.0f;
+        quad.normals[i*3 + 2] = 1.0f;
+    }
+    const unsigned short quadIndices[6] = { 0, 1, 2, 0, 2, 3 };
+    memcpy(quad.indices, quadIndices, sizeof(quadIndices));
+    UploadMesh(&quad, false);
+
+    impostor.quad = quad;
+    impostor.material = LoadMaterialDefault();
+    impostor.material.shader = impostorShader;
+    impostor.material.maps[MATERIAL_MAP_DIFFUSE].texture = impostor.atlas.texture;
+    impostor.ready = true;
+    return impostor;
+}
+
+// Load the impostor shader and capture the tree and bush impostors, needs the vegetation instancing
+// shader (without it trees and bushes are always drawn as meshes)
+void InitImpostors(void) {
+    if (!vegetationInstancingEnabled) return;
+
+    impostorShader = LoadShader(TextFormat("shaders/glsl%i/impostor.vs", GLSL_VERSION),
+                                TextFormat("shaders/glsl%i/impostor.fs", GLSL_VERSION));
+    if ((impostorShader.id == rlGetShaderIdDefault()) || (impostorShader.locs[SHADER_LOC_VERTEX_INSTANCE_TX] == -1)) {
+        TraceLog(LOG_WARNING, "Impostor shader unavailable, trees and bushes are drawn as meshes at any distance");
+        return;
+    }
+    float viewCount = (float)IMPOSTOR_VIEW_COUNT;
+    SetShaderValue(impostorShader, GetShaderLocation(impostorShader, "viewCount"), &viewCount, SHADER_UNIFORM_FLOAT);
+    RegisterFogShader(impostorShader);
+
+    const PlantType impostorTypes[] = { PLANT_TREE, PLANT_BUSH_WITH_FLOWERS };
+    for (int i = 0; i < (int)(sizeof(impostorTypes)/sizeof(impostorTypes[0])); i++) {
+        Model *model = GetPlantModel(impostorTypes[i]);
+        if ((model == NULL) || (model->meshCount == 0)) continue;
+        impostors[impostorTypes[i]] = LoadImpostor(*model);
+    }
+
+    TraceLog(LOG_INFO, "Impostors ready, trees and bushes turn into billboards at %.0f units", impostorDistance);
+}
+
+// Get the share of an instance drawn by its impostor at a camera distance: 0 beyond the near side
+// of the fade band (mesh only), 1 beyond the far side (impostor only)
+float GetImpostorFade(float distance) {
+    float fade = (distance - (impostorDistance - 0.5f*IMPOSTOR_FADE_BAND))/IMPOSTOR_FADE_BAND;
+    return Clamp(fade, 0.0f, 1.0f);
+}
+
+// Get the instance transform of an impostor billboard turned towards the camera, with the fade and
+// the nearest captured view in the bottom row (read and cleared by impostor.vs)
+Matrix GetImpostorTransform(Vector3 position, float scale, float rotationAngle, Vector3 viewPosition, float fade) {
+    float yaw = atan2f(viewPosition.x - position.x, viewPosition.z - position.z);
+
+    // Views are captured in model space, the plant rotation turns them by rotationAngle
+    float viewStep = 360.0f/IMPOSTOR_VIEW_COUNT;
+    int view = (int)roundf((yaw*RAD2DEG - rotationAngle)/viewStep)%IMPOSTOR_VIEW_COUNT;
+    if (view < 0) view += IMPOSTOR_VIEW_COUNT;
+
+    Matrix transform = MatrixMultiply(MatrixMultiply(MatrixScale(scale, scale, scale), MatrixRotateY(yaw)),
+                                      MatrixTranslate(position.x, position.y, position.z));
+    transform.m3 = fade;
+    transform.m7 = (float)view;
+    return transform;
+}
+
+// Unload every impostor and the impostor shader
+void UnloadImpostors(void) {
+    for (int t = 0; t < PLANT_TYPE_COUNT; t++) {
+        if (!impostors[t].ready) continue;
+        UnloadRenderTexture(impostors[t].atlas);
+        UnloadMesh(impostors[t].quad);
+        MemFree(impostors[t].material.maps);  // The atlas texture is unloaded with its render texture
+        impostors[t] = (Impostor){ 0 };
+    }
+    if ((impostorShader.id != 0) && (impostorShader.id != rlGetShaderIdDefault())) UnloadShader(impostorShader);
+    impostorShader = (Shader){ 0 };
+}
+
+// Free the instance buffers of every vegetation batch
+void UnloadVegetationBatches(void) {
+    for (int t = 0; t < PLANT_TYPE_COUNT; t++) {
+        VegetationBatch *batch = &vegetationBatches[t];
+        // Material copies share their maps/textures with the model, only the array is ours
+        if (batch->materials != NULL) MemFree(batch->materials);
+        if (batch->transforms != NULL) MemFree(batch->transforms);
+        if (batch->positions != NULL) MemFree(batch->positions);
+        if (batch->spheres != NULL) MemFree(batch->spheres);
+        if (batch->scales != NULL) MemFree(batch->scales);
+        if (batch->rotations != NULL) MemFree(batch->rotations);
+        if (batch->visible != NULL) MemFree(batch->visible);
+        if (batch->impostorVisible != NULL) MemFree(batch->impostorVisible);
+        *batch = (VegetationBatch){ 0 };
+    }
+}
+
+// Group the active plants by type into instance buffers.
+// Must be called again whenever plants are spawned or deactivated (e.g. after ClearPlantsNearRoads).
+void BuildVegetationBatches(void) {
+    UnloadVegetationBatches();
 
+    int countByType[PLANT_TYPE_COUNT] = { 0 };
     for (int i = 0; i < plantCount; i++) {
-        if (plants[i].active) {
-            if (plants[i].type == PLANT_FLOWER_TYPE2) {
-                if (Vector3DistanceSqr(camera.position, plants[i].position) < maxDrawDistanceFlowerType2 * maxDrawDistanceFlowerType2) {
-                    DrawModelEx(plants[i].model, plants[i].position, (Vector3){0.0f, 1.0f, 0.0f}, plants[i].rotationAngle, (Vector3){plants[i].scale, plants[i].scale, plants[i].scale}, WHITE);
-                }
-            } else if (plants[i].type == PLANT_BUSH_WITH_FLOWERS) {
-                 if (Vector3DistanceSqr(camera.position, plants[i].position) < maxDrawDistanceBushWithFlowers * maxDrawDistanceBushWithFlowers) {
-                    DrawModelEx(plants[i].model, plants[i].position, (Vector3){0.0f, 1.0f, 0.0f}, plants[i].rotationAngle, (Vector3){plants[i].scale, plants[i].scale, plants[i].scale}, WHITE);
+        if (plants[i].active) countByType[plants[i].type]++;
+    }
+
+    int drawCalls = 0;
+    int instanceTotal = 0;
+    for (int t = 0; t < PLANT_TYPE_COUNT; t++) {
+        VegetationBatch *batch = &vegetationBatches[t];
+        batch->model = GetPlantModel((PlantType)t);
+        batch->lods = plantLods[t];
+        batch->maxDrawDistance = (t == PLANT_FLOWER_TYPE2) ? 40.0f :         // Max distance to draw flower type 2
+                                 ((t == PLANT_BUSH_WITH_FLOWERS) && !impostors[t].ready) ? 50.0f : 0.0f; // Bushes without impostor stop at 50
+        if (batch->model == NULL || batch->model->meshCount == 0 || countByType[t] == 0) continue;
+
+        batch->transforms = (Matrix *)MemAlloc(countByType[t]*sizeof(Matrix));
+        batch->positions = (Vector3 *)MemAlloc(countByType[t]*sizeof(Vector3));
+        batch->spheres = (BoundingSphere *)MemAlloc(countByType[t]*sizeof(BoundingSphere));
+        batch->scales = (float *)MemAlloc(countByType[t]*sizeof(float));
+        batch->rotations = (float *)MemAlloc(countByType[t]*sizeof(float));
+        int levelCount = (batch->lods != NULL) ? batch->lods->levelCount : 1;
+        batch->visible = (Matrix *)MemAlloc(countByType[t]*levelCount*sizeof(Matrix));
+        if (impostors[t].ready) batch->impostorVisible = (Matrix *)MemAlloc(countByType[t]*sizeof(Matrix));
+
+        batch->materials = (Material *)MemAlloc(batch->model->materialCount*sizeof(Material));
+        for (int m = 0; m < batch->model->materialCount; m++) {
+            batch->materials[m] = batch->model->materials[m];
+            if (vegetationInstancingEnabled) batch->materials[m].shader = vegetationShader;
+            else if (fogEnabled) batch->materials[m].shader = fogShader;
+        }
+
+        drawCalls += batch->model->meshCount;
+    }
+
+    for (int i = 0; i < plantCount; i++) {
+        if (!plants[i].active) continue;
+        VegetationBatch *batch = &vegetationBatches[plants[i].type];
+        if (batch->transforms == NULL) continue;
+        batch->transforms[batch->count] = plants[i].transform;
+        batch->positions[batch->count] = plants[i].position;
+        batch->scales[batch->count] = plants[i].scale;
+        batch->rotations[batch->count] = plants[i].rotationAngle;
+        batch->spheres[batch->count] = GetBoundingSphere(GetModelWorldBounds(*batch->model, plants[i].position, plants[i].rotationAngle, plants[i].scale));
+        batch->count++;
+        instanceTotal++;
+    }
+
+    TraceLog(LOG_INFO, "Vegetation batches built: %d plants in %d instanced draw calls", instanceTotal, drawCalls);
+}
+
+// Draw all active plants, one instanced draw per mesh and LOD level of each plant type.
+// Instances outside the frustum (or beyond the per-type draw distance or the fog) are filtered out first,
+// types with an impostor split the rest into mesh and billboard instances by distance, and the mesh
+// instances are binned by the level their size on screen gets.
+void DrawPlants(Camera camera, const Frustum *frustum) { // Modified to accept Camera
+    for (int t = 0; t < PLANT_TYPE_COUNT; t++) {
+        VegetationBatch *batch = &vegetationBatches[t];
+        if (batch->count == 0) continue;
+
+        Impostor *impostor = &impostors[t];
+        ModelLods *lods = batch->lods;
+        int levelCount = (lods != NULL) ? lods->levelCount : 1;
+        float maxDistSq = batch->maxDrawDistance*batch->maxDrawDistance;
+        int instanceCounts[MAX_MODEL_LODS] = { 0 };
+        int impostorCount = 0;
+        for (int i = 0; i < batch->count; i++) {
+            float distSq = Vector3DistanceSqr(camera.position, batch->positions[i]);
+            bool visible = (batch->maxDrawDistance <= 0.0f) || (distSq < maxDistSq);
+            if (visible) visible = IsSphereInFogRange(batch->spheres[i]) && FrustumContainsSphere(frustum, batch->spheres[i]);
+            RecordCullResult(CULL_PLANTS, visible);
+            if (!visible) continue;
+
+            // Level instances are stored from visible + level*count
+            float distance = sqrtf(distSq);
+            int level = (lods != NULL) ? GetLodLevel(levelCount, lods->radius*batch->scales[i], distance, camera.fovy) : 0;
+            Matrix *levelVisible = batch->visible + level*batch->count;
+
+            if (!impostor->ready) {
+                levelVisible[instanceCounts[level]++] = batch->transforms[i];
+                continue;
+            }
+
+            // The fade goes to the shaders in the bottom row of the transforms, always 0 in an affine one
+            float fade = GetImpostorFade(distance);
+            if (fade < 1.0f) {
+                Matrix transform = batch->transforms[i];
+                transform.m3 = fade;
+                levelVisible[instanceCounts[level]++] = transform;
+            }
+            if (fade > 0.0f) {
+                batch->impostorVisible[impostorCount++] = GetImpostorTransform(batch->positions[i], batch->scales[i],
+                                                                               batch->rotations[i], camera.position, fade);
+            }
+        }
+        if (impostorCount > 0) DrawMeshInstanced(impostor->quad, impostor->material, batch->impostorVisible, impostorCount);
+
+        for (int level = 0; level < levelCount; level++) {
+            int instanceCount = instanceCounts[level];
+            if (instanceCount == 0) continue;
+            RecordModelLodDraw(lods, level, instanceCount);
+
+            Model model = GetModelLod(*batch->model, lods, level);
+            Matrix *levelVisible = batch->visible + level*batch->count;
+            for (int m = 0; m < model.meshCount; m++) {
+                Material material = batch->materials[model.meshMaterial[m]];
+                if (vegetationInstancingEnabled) {
+                    DrawMeshInstanced(model.meshes[m], material, levelVisible, instanceCount);
+                } else {
+                    for (int i = 0; i < instanceCount; i++) DrawMesh(model.meshes[m], material, levelVisible[i]);
                 }
-            }else {
-                DrawModelEx(plants[i].model, plants[i].position, (Vector3){0.0f, 1.0f, 0.0f}, plants[i].rotationAngle, (Vector3){plants[i].scale, plants[i].scale, plants[i].scale}, WHITE);
             }
         }
     }
@@ -505,7 +1089,18 @@ void DrawPlants(Camera camera) { // Modified to accept Camera
 
 // Unload all plant resources
 void UnloadPlantResources(void) {
+    UnloadVegetationBatches();
+    UnloadImpostors();
+    // The shader may have loaded without the instance transform attribute, unload it anyway
+    if ((vegetationShader.id != 0) && (vegetationShader.id != rlGetShaderIdDefault())) UnloadShader(vegetationShader);
+    vegetationShader = (Shader){ 0 };
+    vegetationInstancingEnabled = false;
+
     // Unload the globally loaded plant models
+    for (int t = 0; t < PLANT_TYPE_COUNT; t++) {
+        ReleaseModelLods(*GetPlantModel((PlantType)t));
+        plantLods[t] = NULL;
+    }
     if (globalTreeModel.meshCount > 0) UnloadModel(globalTreeModel);
     if (globalGrassModel.meshCount > 0) UnloadModel(globalGrassModel);
     if (globalFlowerModel.meshCount > 0) UnloadModel(globalFlowerModel);
@@ -527,41 +1122,15 @@ void ClearPlantsNearRoads(float clearExtraRadius) {
     for (int i = 0; i < plantCount; i++) {
         if (!plants[i].active) continue;
         
-        // For each road
-        for (int roadIndex = 0; roadIndex < totalCustomRoadsCount; roadIndex++) {
-            if (!allCustomRoads[roadIndex].isActive || allCustomRoads[roadIndex].numPoints < 2) continue;
-            
-            // Check each segment of this road
-            for (int segmentIndex = 0; segmentIndex < allCustomRoads[roadIndex].numPoints - 1; segmentIndex++) {
-                Vector3 p1 = allCustomRoads[roadIndex].points[segmentIndex];
-                Vector3 p2 = allCustomRoads[roadIndex].points[segmentIndex + 1];
-                
-                // Project plant position onto the road segment
-                Vector3 segmentVec = Vector3Subtract(p2, p1);
-                Vector3 plantVec = Vector3Subtract(plants[i].position, p1);
-                
-                float segmentLengthSq = Vector3LengthSqr(segmentVec);
-                if (segmentLengthSq == 0.0f) continue; // Avoid division by zero
-                
-                float t = Vector3DotProduct(plantVec, segmentVec) / segmentLengthSq;
-                t = Clamp(t, 0.0f, 1.0f); // Ensure projection is on the segment
-                
-                Vector3 closestPoint = Vector3Add(p1, Vector3Scale(segmentVec, t));
-                
-                // Check if plant is too close to the road
-                // Use a larger radius for taller/larger plants like trees
-                float plantSize = (plants[i].type == PLANT_TREE) ? plants[i].scale * 1.7f : plants[i].scale;
-                float clearRadius = (roadWidth / 2.0f) + clearExtraRadius + plantSize;
-                
-                if (Vector3Distance(plants[i].position, closestPoint) < clearRadius) {
-                    // Plant is too close to road - deactivate it
-                    plants[i].active = false;
-                    removedCount++;
-                    break; // No need to check other segments for this plant
-                }
-            }
-            
-            if (!plants[i].active) break; // Skip to next plant if already marked for removal
+        // Check if plant is too close to any road
+        // Use a larger radius for taller/larger plants like trees
+        float plantSize = (plants[i].type == PLANT_TREE) ? plants[i].scale * 1.7f : plants[i].scale;
+        float clearRadius = (roadWidth / 2.0f) + clearExtraRadius + plantSize;
+
+        if (QueryRoadGrid(plants[i].position, clearRadius, -1).roadId != -1) {
+            // Plant is too close to road - deactivate it
+            plants[i].active = false;
+            removedCount++;
         }
     }
     
@@ -588,41 +1157,23 @@ void ClearPlantsNearRoads(float clearExtraRadius) {
 // Global array of terrain chunks
 TerrainChunk terrainChunks[MAX_TERRAIN_CHUNKS];
 
+// Terrain LOD meshes, shared by every chunk (all chunks are the same flat plane).
+// One mesh per level and stitched edge combination, the coarsest level is never stitched.
+Mesh terrainLodMeshes[TERRAIN_LOD_COUNT][16] = { 0 };
+Material terrainMaterial = { 0 };
+int terrainTrianglesDrawn = 0;   // Terrain triangles submitted last frame
+int terrainVerticesDrawn = 0;    // Terrain vertices submitted last frame
+
 // New function to check if a position is on any road
 bool IsPositionOnRoad(Vector3 position, float rWidth) {
-    for (int i = 0; i < totalCustomRoadsCount; i++) {
-        if (allCustomRoads[i].isActive && allCustomRoads[i].numPoints >= 2) {
-            // For ribbon-style roads (single mesh), we check against the original points
-            // This is a simplification; true collision with a mesh is more complex.
-            // We'll check distance to line segments formed by the road points.
-            for (int j = 0; j < allCustomRoads[i].numPoints - 1; j++) {
-                Vector3 p1 = allCustomRoads[i].points[j];
-                Vector3 p2 = allCustomRoads[i].points[j+1];
-
-                // Project position onto the line segment
-                Vector3 segmentVec = Vector3Subtract(p2, p1);
-                Vector3 pointVec = Vector3Subtract(position, p1);
-
-                float segmentLengthSq = Vector3LengthSqr(segmentVec);
-                if (segmentLengthSq == 0.0f) continue; // Segment has zero length
-
-                float t = Vector3DotProduct(pointVec, segmentVec) / segmentLengthSq;
-                t = Clamp(t, 0.0f, 1.0f); // Clamp t to be on the segment
-
-                Vector3 closestPointOnSegment = Vector3Add(p1, Vector3Scale(segmentVec, t));
-                
-                // Check distance from the plant's position to the closest point on the segment's centerline
-                if (Vector3Distance(position, closestPointOnSegment) < (rWidth / 2.0f) + 2.5f) // Increased buffer to prevent road blockage
-                    return true; // Position is on this road segment
-            }
-        }
-    }
-    return false; // Position is not on any road
+    // Distance to the road centerlines, only the segments binned in this cell are checked
+    return (QueryRoadGrid(position, (rWidth / 2.0f) + 2.5f, -1).roadId != -1); // Increased buffer to prevent road blockage
 }
 
 // Buffer for the path currently being recorded
 bool isRecordingPath = false;
 Vector3 currentRecordingBuffer[MAX_PATH_POINTS];
+Vector3 currentRecordingTargets[MAX_PATH_POINTS];   // Camera targets of the recorded points, saved with the camera path
 int currentRecordingPointCount = 0;
 float minRecordDistanceSq = 2.0f * 2.0f;
 
@@ -640,10 +1191,33 @@ typedef struct {
     int type; // Cloud type for different textures
 } Cloud;
 
-// Global array of clouds
-Cloud clouds[MAX_CLOUDS];
+// Global array of clouds, allocated by InitEntityPools()
+Cloud *clouds = NULL;
+int cloudCount = 0;
 Texture2D cloudTextures[MAX_CLOUD_TYPES];  // Different cloud textures for variety
 
+// Baked cloud chunk: all cloud boxes of one XZ grid cell in a single static mesh
+typedef struct {
+    Mesh mesh;
+    BoundingBox bounds;  // Bounds without wind drift
+    Vector3 center;
+} CloudChunk;
+
+CloudChunk *cloudChunks = NULL;
+int cloudChunkCount = 0;
+Vector2 cloudFieldOrigin = { 0 };  // Min XZ corner of the chunk grid
+Vector2 cloudFieldSize = { 0 };    // XZ extent of the chunk grid, chunks drifting past it wrap around
+Shader cloudShader = { 0 };
+Material cloudMaterial = { 0 };
+int cloudWindOffsetLoc = -1;
+Mesh skyDomeMesh = { 0 };          // Sphere of SKY_DOME_RADIUS around the origin, built once and moved with the camera
+Material skyMaterial = { 0 };
+Shader skyShader = { 0 };
+bool skyEnabled = false;           // False leaves the SKY_COLOR background
+
+double worldTime = 0.0;            // Simulated seconds, advanced by every simulation step (drives the cloud drift)
+float simulationAlpha = 0.0f;      // Fraction of a step the frame is past the last one, interpolates the drawn state
+
 Vector3 Farm_Entrance_points[] = {
     { -10.97f, 0.15f, -7.52f },
     { -12.55f, 0.15f, -6.29f },
@@ -783,11 +1357,20 @@ void GenerateRoadSegments(CustomRoad* road, float rWidth, Texture2D rTexture) {
         if (road) {
             road->segmentCount = 0;
             road->isActive = false;
+            SetRoadGridRoad((int)(road - allCustomRoads), NULL, 0);
         }
         TraceLog(LOG_INFO, "Path has less than 2 points or road is null, cannot generate road.");
         return;
     }
 
+#if defined(FARM_HEADLESS)
+    // No GL context, only the road grid used by the simulation is built
+    road->segmentCount = 0;
+    road->isActive = true;
+    SetRoadGridRoad((int)(road - allCustomRoads), road->points, road->numPoints);
+    return;
+#endif
+
     // Unload previous segments if any
     for (int i = 0; i < road->segmentCount; i++) {
         if (road->segments[i].meshCount > 0) UnloadModel(road->segments[i]);
@@ -919,6 +1502,7 @@ void GenerateRoadSegments(CustomRoad* road, float rWidth, Texture2D rTexture) {
     
     // Create model from mesh
     road->segments[0] = LoadModelFromMesh(roadMesh);
+    ApplyFogShader(&road->segments[0]);
     
     // Apply texture to the model
     road->segments[0].materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = roadTexture;
@@ -927,6 +1511,9 @@ void GenerateRoadSegments(CustomRoad* road, float rWidth, Texture2D rTexture) {
     road->segmentPositions[0] = (Vector3){0, 0, 0}; // We'll draw at origin since vertices are in world space
     road->segmentRotations[0] = 0.0f; 
     road->isActive = true;
+
+    // Bin the new road so road queries see it (only this road's cells are touched)
+    SetRoadGridRoad((int)(road - allCustomRoads), road->points, road->numPoints);
     
     // Free temporary resources
     MemFree(segmentLengths);
@@ -941,6 +1528,7 @@ void GenerateSmoothRoad(CustomRoad* road, float rWidth, Texture2D rTexture) {
         if (road) {
             road->segmentCount = 0;
             road->isActive = false;
+            SetRoadGridRoad((int)(road - allCustomRoads), NULL, 0);
         }
         TraceLog(LOG_INFO, "Path has less than 2 points or road is null, cannot generate smooth road.");
         return;
@@ -1043,11 +1631,13 @@ void GenerateSmoothRoad(CustomRoad* road, float rWidth, Texture2D rTexture) {
     
     // Create model from mesh
     road->segments[0] = LoadModelFromMesh(roadMesh);
+    ApplyFogShader(&road->segments[0]);
     road->segments[0].materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = roadTexture;
     
     // Set as single-segment road
     road->segmentCount = 1;
     road->isActive = true;
+    SetRoadGridRoad((int)(road - allCustomRoads), road->points, road->numPoints);
     
     TraceLog(LOG_INFO, "Smooth road created successfully for '%s' with %d points", 
              road->name, road->numPoints);
@@ -1077,101 +1667,325 @@ void DrawAllCustomRoads() {
     }
 }
 
+// Load the skinning shader, GPU skinning is disabled if it can't be used
+void InitSkinningShader(void) {
+#if defined(SUPPORT_GPU_SKINNING)
+    skinningShader = LoadShader(TextFormat("shaders/glsl%i/skinning.vs", GLSL_VERSION),
+                                TextFormat("shaders/glsl%i/skinning.fs", GLSL_VERSION));
+
+    gpuSkinningEnabled = (skinningShader.id != rlGetShaderIdDefault()) &&
+                         (skinningShader.locs[SHADER_LOC_VERTEX_BONEIDS] != -1) &&
+                         (skinningShader.locs[SHADER_LOC_VERTEX_BONEWEIGHTS] != -1) &&
+                         (skinningShader.locs[SHADER_LOC_BONE_MATRICES] != -1);
+#endif
+    if (!gpuSkinningEnabled) {
+        TraceLog(LOG_WARNING, "GPU skinning unavailable, animated models use CPU skinning");
+    } else {
+        RegisterFogShader(skinningShader);
+    }
+}
+
+// Switch a skinned model to the skinning shader if every skinned mesh has its bone vertex buffers uploaded.
+// Returns true if the model is now GPU skinned.
+bool SetupModelSkinning(Model *model) {
+    if (!gpuSkinningEnabled || model->boneCount == 0 || model->boneCount > MAX_SKINNING_BONES) return false;
+
+    for (int i = 0; i < model->meshCount; i++) {
+        Mesh *mesh = &model->meshes[i];
+        if (mesh->boneMatrices == NULL) continue;
+        // Bone VBOs are only created by UploadMesh() when the mesh has bone data
+        if (mesh->boneIds == NULL || mesh->boneWeights == NULL ||
+            mesh->vboId[SKINNING_VBO_BONEIDS] == 0 || mesh->vboId[SKINNING_VBO_BONEWEIGHTS] == 0) {
+            return false;
+        }
+    }
+
+    for (int i = 0; i < model->materialCount; i++) model->materials[i].shader = skinningShader;
+    return true;
+}
+
+#define SKINNING_BATCH_SIZE 2048    // Vertices per CPU skinning job
+
+// CPU skinning job of one mesh
+typedef struct {
+    Mesh *mesh;
+    const Matrix *normalMatrices;   // Inverse transpose of every bone matrix
+} SkinningJob;
+
+static Matrix *skinningNormalMatrices = NULL;   // Grown to the largest bone count seen
+static int skinningNormalMatrixCapacity = 0;
+
+// Job: skin the vertices [begin, end) of a mesh, same math as raylib's UpdateModelAnimation()
+void SkinMeshVertices(void *data, int begin, int end) {
+    const SkinningJob *job = (const SkinningJob *)data;
+    Mesh *mesh = job->mesh;
+    bool skinNormals = (mesh->normals != NULL) && (mesh->animNormals != NULL);
+
+    for (int v = begin; v < end; v++) {
+        Vector3 vertex = { mesh->vertices[v*3], mesh->vertices[v*3 + 1], mesh->vertices[v*3 + 2] };
+        Vector3 normal = skinNormals ? (Vector3){ mesh->normals[v*3], mesh->normals[v*3 + 1], mesh->normals[v*3 + 2] } : (Vector3){ 0 };
+        Vector3 animVertex = { 0 };
+        Vector3 animNormal = { 0 };
+
+        for (int j = 0; j < 4; j++) {
+            float weight = mesh->boneWeights[v*4 + j];
+            if (weight == 0.0f) continue;
+            int boneId = mesh->boneIds[v*4 + j];
+
+            animVertex = Vector3Add(animVertex, Vector3Scale(Vector3Transform(vertex, mesh->boneMatrices[boneId]), weight));
+            if (skinNormals) animNormal = Vector3Add(animNormal, Vector3Scale(Vector3Transform(normal, job->normalMatrices[boneId]), weight));
+        }
+
+        mesh->animVertices[v*3] = animVertex.x;
+        mesh->animVertices[v*3 + 1] = animVertex.y;
+        mesh->animVertices[v*3 + 2] = animVertex.z;
+        if (skinNormals) {
+            mesh->animNormals[v*3] = animNormal.x;
+            mesh->animNormals[v*3 + 1] = animNormal.y;
+            mesh->animNormals[v*3 + 2] = animNormal.z;
+        }
+    }
+}
+
+// Skin the vertices of a model with its current bone matrices, split over the job pool, the buffers
+// are uploaded on the main thread (the GL context isn't shared with the workers)
+void SkinModelVertices(Model model) {
+    for (int m = 0; m < model.meshCount; m++) {
+        Mesh *mesh = &model.meshes[m];
+        // Skip if missing bone data, like raylib does
+        if ((mesh->boneWeights == NULL) || (mesh->boneIds == NULL) || (mesh->boneMatrices == NULL) || (mesh->animVertices == NULL)) continue;
+
+        // The normal matrices are computed once per bone instead of once per vertex weight
+        if (model.boneCount > skinningNormalMatrixCapacity) {
+            Matrix *matrices = (Matrix *)MemRealloc(skinningNormalMatrices, model.boneCount*sizeof(Matrix));
+            if (matrices == NULL) continue;
+            skinningNormalMatrices = matrices;
+            skinningNormalMatrixCapacity = model.boneCount;
+        }
+        for (int b = 0; b < model.boneCount; b++) {
+            skinningNormalMatrices[b] = MatrixTranspose(MatrixInvert(mesh->boneMatrices[b]));
+        }
+
+        SkinningJob job = { mesh, skinningNormalMatrices };
+        RunParallelFor(mesh->vertexCount, SKINNING_BATCH_SIZE, SkinMeshVertices, &job);
+
+        rlUpdateVertexBuffer(mesh->vboId[0], mesh->animVertices, mesh->vertexCount*3*sizeof(float), 0); // Update vertex position
+        if ((mesh->normals != NULL) && (mesh->animNormals != NULL)) {
+            rlUpdateVertexBuffer(mesh->vboId[2], mesh->animNormals, mesh->vertexCount*3*sizeof(float), 0); // Update vertex normals
+        }
+    }
+}
+
+// Pose a model on the CPU, see SkinModelVertices()
+void UpdateModelAnimationParallel(Model model, ModelAnimation anim, int frame) {
+    UpdateModelAnimationBones(model, anim, frame);
+    SkinModelVertices(model);
+}
+
+// Check if a model was set up for GPU skinning (see SetupModelSkinning())
+bool IsModelGpuSkinned(Model model) {
+    return gpuSkinningEnabled && (model.materialCount > 0) && (model.materials[0].shader.id == skinningShader.id);
+}
+
+// Pose a model for an animation frame, on the GPU if the model was set up for it.
+// A LOD level of the model (see GetModelLod()) shares its bone matrices, so any level can be posed.
+void UpdateSkinnedModel(Model model, ModelAnimation anim, int frame) {
+    if (IsModelGpuSkinned(model)) {
+        UpdateModelAnimationBones(model, anim, frame);
+    } else {
+        UpdateModelAnimationParallel(model, anim, frame);
+    }
+}
+
+// Unload the skinning shader (the models only reference it)
+void UnloadSkinningShader(void) {
+    if (gpuSkinningEnabled) UnloadShader(skinningShader);
+    gpuSkinningEnabled = false;
+    MemFree(skinningNormalMatrices);
+    skinningNormalMatrices = NULL;
+    skinningNormalMatrixCapacity = 0;
+}
+
+// --- Model LOD Registry ---
+// Simplified levels of the loaded models (see mesh_lod.h), generated once per model and shared by
+// every object drawing it. Entries are found by the model's mesh array, models loaded from the same
+// file twice get their own levels.
+#define MAX_LOD_MODELS 32
+
+typedef struct {
+    Mesh *meshes;            // Full detail meshes of the model, identifies the entry
+    ModelLods lods;
+    int refCount;            // Users of the levels, unloaded when it drops to 0
+} ModelLodEntry;
+
+ModelLodEntry modelLodEntries[MAX_LOD_MODELS] = { 0 };
+
+// Get the levels of a model, generating them on first use (NULL for models without meshes)
+ModelLods* AcquireModelLods(Model model, const char *name) {
+    if (model.meshCount == 0) return NULL;
+
+    ModelLodEntry *freeEntry = NULL;
+    for (int i = 0; i < MAX_LOD_MODELS; i++) {
+        ModelLodEntry *entry = &modelLodEntries[i];
+        if ((entry->refCount > 0) && (entry->meshes == model.meshes)) {
+            entry->refCount++;
+            return &entry->lods;
+        }
+        if ((entry->refCount == 0) && (freeEntry == NULL)) freeEntry = entry;
+    }
+
+    if (freeEntry == NULL) {
+        TraceLog(LOG_WARNING, "LOD: No free entry for %s, drawn at full detail", name);
+        return NULL;
+    }
+
+    double startTime = GetTime();
+    freeEntry->meshes = model.meshes;
+    freeEntry->lods = GenModelLods(model, MAX_MODEL_LODS);
+    freeEntry->refCount = 1;
+
+    char levels[64] = { 0 };
+    int length = 0;
+    for (int level = 0; level < freeEntry->lods.levelCount; level++) {
+        length += snprintf(levels + length, sizeof(levels) - length, (level == 0) ? "%d" : " / %d", freeEntry->lods.triangleCounts[level]);
+    }
+    TraceLog(LOG_INFO, "LOD: %s has %d levels (%s triangles), generated in %.1f ms", name, freeEntry->lods.levelCount,
+             levels, (GetTime() - startTime)*1000.0);
+
+    return &freeEntry->lods;
+}
+
+// Drop one reference to the levels of a model, unloading them when nothing uses them anymore
+void ReleaseModelLods(Model model) {
+    if (model.meshCount == 0) return;
+
+    for (int i = 0; i < MAX_LOD_MODELS; i++) {
+        ModelLodEntry *entry = &modelLodEntries[i];
+        if ((entry->refCount == 0) || (entry->meshes != model.meshes)) continue;
+
+        if (--entry->refCount == 0) {
+            UnloadModelLods(&entry->lods);
+            *entry = (ModelLodEntry){ 0 };
+        }
+        return;
+    }
+}
+// --- End Model LOD Registry ---
+
+// --- Animal Asset Registry ---
+AnimalAssets animalAssets[ANIMAL_COUNT] = { 0 };
+
+// Model file names for each AnimalType, the walking/idle clips live in the same files
+const char* animalAssetNames[ANIMAL_COUNT] = { "horse", "cat", "dog", "cow", "chicken", "pig" };
+
+// Get the shared assets of a species, loading them on first use
+AnimalAssets* AcquireAnimalAssets(AnimalType type) {
+    if (type < 0 || type >= ANIMAL_COUNT) return NULL;
+
+    AnimalAssets *assets = &animalAssets[type];
+    if (assets->refCount == 0) {
+        const char *walkingPath = TextFormat("animals/walking_%s.glb", animalAssetNames[type]);
+        assets->walkingModel = LoadModelAsset(walkingPath);
+        assets->walkingAnim = LoadModelAnimationsAsset(walkingPath, &assets->walkingAnimCount);
+
+        const char *idlePath = TextFormat("animals/idle_%s.glb", animalAssetNames[type]);
+        assets->idleModel = LoadModelAsset(idlePath);
+        assets->idleAnim = LoadModelAnimationsAsset(idlePath, &assets->idleAnimCount);
+
+        // Rotation independent bounds, animals turn every frame so only the radius is cached
+        BoundingSphere walkingSphere = GetBoundingSphere(GetModelBoundingBox(assets->walkingModel));
+        BoundingSphere idleSphere = GetBoundingSphere(GetModelBoundingBox(assets->idleModel));
+        assets->boundsRadius = fmaxf(Vector3Length(walkingSphere.center) + walkingSphere.radius,
+                                     Vector3Length(idleSphere.center) + idleSphere.radius);
+
+        // Prefer GPU skinning, models that can't use it stay on the CPU path (drawn with the fog shader)
+        SetupModelSkinning(&assets->walkingModel);
+        SetupModelSkinning(&assets->idleModel);
+        ApplyFogShader(&assets->walkingModel);
+        ApplyFogShader(&assets->idleModel);
+        assets->walkingLods = AcquireModelLods(assets->walkingModel, TextFormat("walking_%s", animalAssetNames[type]));
+        assets->idleLods = AcquireModelLods(assets->idleModel, TextFormat("idle_%s", animalAssetNames[type]));
+
+        // Log if animations loaded successfully
+        if (assets->walkingAnimCount > 0) {
+            TraceLog(LOG_INFO, "Walking animation loaded for animal type %d", type);
+        } else {
+            TraceLog(LOG_WARNING, "No walking animations found for animal type %d", type);
+        }
+
+        if (assets->idleAnimCount > 0) {
+            TraceLog(LOG_INFO, "Idle animation loaded for animal type %d", type);
+        } else {
+            TraceLog(LOG_WARNING, "No idle animations found for animal type %d", type);
+        }
+    }
+
+    assets->refCount++;
+    return assets;
+}
+
+// Drop one reference to a species' assets, unloading them when no animal uses them anymore
+void ReleaseAnimalAssets(AnimalType type) {
+    if (type < 0 || type >= ANIMAL_COUNT) return;
+
+    AnimalAssets *assets = &animalAssets[type];
+    if (assets->refCount == 0) return;
+    if (--assets->refCount > 0) return;
+
+    ReleaseModelLods(assets->walkingModel);
+    ReleaseModelLods(assets->idleModel);
+    UnloadModel(assets->walkingModel);
+    UnloadModel(assets->idleModel);
+
+    if (assets->walkingAnim != NULL && assets->walkingAnimCount > 0) {
+        UnloadModelAnimations(assets->walkingAnim, assets->walkingAnimCount);
+    }
+
+    if (assets->idleAnim != NULL && assets->idleAnimCount > 0) {
+        UnloadModelAnimations(assets->idleAnim, assets->idleAnimCount);
+    }
+
+    *assets = (AnimalAssets){ 0 };
+}
+// --- End Animal Asset Registry ---
+
 // --- InitAnimal function ...
 
-// Function to initialize a new animal
-void InitAnimal(Animal* animal, AnimalType type, Vector3 position) {
-    animal->type = type;
-    animal->position = position;
-    animal->spawnPosition = position;  // Store original spawn position
-    animal->direction = (Vector3){0.0f, 0.0f, 1.0f};  // Default direction
-    animal->animFrameCounter = 0;
-    animal->moveTimer = 0.0f;
-    animal->moveInterval = 1.5f + GetRandomValue(0, 20) / 10.0f; // 1.5-3.5 seconds between decisions
-    animal->isMoving = false;
-    animal->rotationAngle = 0.0f;
-    animal->active = true;
-    animal->maxWanderDistance = 15.0f + GetRandomValue(0, 50) / 10.0f; // Each animal has a territory of 15-20 units
+// Function to initialize the animal in a herd slot
+void InitAnimal(AnimalType type, int slot) {
+    Herd *herd = &herds[type];
+    herd->moveInterval[slot] = 1.5f + GetRandomValue(0, 20) / 10.0f; // 1.5-3.5 seconds between decisions
+    herd->maxWanderDistance[slot] = 15.0f + GetRandomValue(0, 50) / 10.0f; // Each animal has a territory of 15-20 units
     
     // Set type-specific properties
     switch(type) {
         case ANIMAL_HORSE:
-            animal->walkingModel = LoadModel("animals/walking_horse.glb");
-            animal->idleModel = LoadModel("animals/idle_horse.glb");
-            animal->walkingAnim = LoadModelAnimations("animals/walking_horse.glb", &animal->walkingAnimCount);
-            animal->idleAnim = LoadModelAnimations("animals/idle_horse.glb", &animal->idleAnimCount);
-            animal->scale = 1.0f;
-            animal->speed = 0.022f; // Increased speed for better exploration
-            animal->maxWanderDistance = 40.0f + GetRandomValue(0, 100) / 10.0f; // Increased wander distance for horses (40-50 units)
+            herd->scale[slot] = 1.0f;
+            herd->speed[slot] = 0.022f; // Increased speed for better exploration
+            herd->maxWanderDistance[slot] = 40.0f + GetRandomValue(0, 100) / 10.0f; // Increased wander distance for horses (40-50 units)
             break;
         case ANIMAL_CAT:
-            animal->walkingModel = LoadModel("animals/walking_cat.glb");
-            animal->idleModel = LoadModel("animals/idle_cat.glb");
-            animal->walkingAnim = LoadModelAnimations("animals/walking_cat.glb", &animal->walkingAnimCount);
-            animal->idleAnim = LoadModelAnimations("animals/idle_cat.glb", &animal->idleAnimCount);
-            animal->scale = 0.9f;
-            animal->speed = 0.02f;  // Reduced speed
+            herd->scale[slot] = 0.9f;
+            herd->speed[slot] = 0.02f;  // Reduced speed
             break;
         case ANIMAL_DOG:
-            animal->walkingModel = LoadModel("animals/walking_dog.glb");
-            animal->idleModel = LoadModel("animals/idle_dog.glb");
-            animal->walkingAnim = LoadModelAnimations("animals/walking_dog.glb", &animal->walkingAnimCount);
-            animal->idleAnim = LoadModelAnimations("animals/idle_dog.glb", &animal->idleAnimCount);
-            animal->scale = 0.8f;
-            animal->speed = 0.0075f; // Reduced speed
+            herd->scale[slot] = 0.8f;
+            herd->speed[slot] = 0.0075f; // Reduced speed
             break;
         case ANIMAL_COW:
-            animal->walkingModel = LoadModel("animals/walking_cow.glb");
-            animal->idleModel = LoadModel("animals/idle_cow.glb");
-            animal->walkingAnim = LoadModelAnimations("animals/walking_cow.glb", &animal->walkingAnimCount);
-            animal->idleAnim = LoadModelAnimations("animals/idle_cow.glb", &animal->idleAnimCount);
-            animal->scale = 0.27f;  // Reduced from 1.2f by 10x
-            animal->speed = 0.018f;  // Increased speed for better exploration
-            animal->maxWanderDistance = 35.0f + GetRandomValue(0, 100) / 10.0f; // Increased wander distance for cows (35-45 units)
+            herd->scale[slot] = 0.27f;  // Reduced from 1.2f by 10x
+            herd->speed[slot] = 0.018f;  // Increased speed for better exploration
+            herd->maxWanderDistance[slot] = 35.0f + GetRandomValue(0, 100) / 10.0f; // Increased wander distance for cows (35-45 units)
             break;
         case ANIMAL_CHICKEN:
-            animal->walkingModel = LoadModel("animals/walking_chicken.glb");
-            animal->idleModel = LoadModel("animals/idle_chicken.glb");
-            animal->walkingAnim = LoadModelAnimations("animals/walking_chicken.glb", &animal->walkingAnimCount);
-            animal->idleAnim = LoadModelAnimations("animals/idle_chicken.glb", &animal->idleAnimCount);
-            animal->scale = 1.8f;  // Increased from 1.0f to make chickens bigger
-            animal->speed = 0.006f; // Reduced speed
+            herd->scale[slot] = 1.8f;  // Increased from 1.0f to make chickens bigger
+            herd->speed[slot] = 0.006f; // Reduced speed
             break;
         case ANIMAL_PIG:
-            animal->walkingModel = LoadModel("animals/walking_pig.glb");
-            animal->idleModel = LoadModel("animals/idle_pig.glb");
-            animal->walkingAnim = LoadModelAnimations("animals/walking_pig.glb", &animal->walkingAnimCount);
-            animal->idleAnim = LoadModelAnimations("animals/idle_pig.glb", &animal->idleAnimCount);
-            animal->scale = 0.16f;  // Reduced from 0.8f by 5x
-            animal->speed = 0.00825f; // Reduced speed
-            break;
-        case ANIMAL_COUNT:
-        default:
-            // This is not a valid animal type
-            TraceLog(LOG_ERROR, "Invalid animal type: %d", type);
-            animal->walkingModel = (Model){0};
-            animal->idleModel = (Model){0};
-            animal->walkingAnim = NULL;
-            animal->idleAnim = NULL;
-            animal->walkingAnimCount = 0;
-            animal->idleAnimCount = 0;
-            animal->scale = 1.0f;
-            animal->speed = 0.0f;
-            animal->active = false;
+            herd->scale[slot] = 0.16f;  // Reduced from 0.8f by 5x
+            herd->speed[slot] = 0.00825f; // Reduced speed
             break;
-    }
-    
-    // Log if animations loaded successfully
-    if (animal->walkingAnimCount > 0) {
-        TraceLog(LOG_INFO, "Walking animation loaded for animal type %d", type);
-    } else {
-        TraceLog(LOG_WARNING, "No walking animations found for animal type %d", type);
-    }
-    
-    if (animal->idleAnimCount > 0) {
-        TraceLog(LOG_INFO, "Idle animation loaded for animal type %d", type);
-    } else {
-        TraceLog(LOG_WARNING, "No idle animations found for animal type %d", type);
+        default: break;
     }
 }
 
@@ -1179,341 +1993,339 @@ void InitAnimal(Animal* animal, AnimalType type, Vector3 position) {
 bool collisionDetectionEnabled = true; // Default is enabled
 // Global flag for debug visualization
 bool showDebugVisualization = false; // Default is disabled
+// Global flag for the profiler overlay
+bool showProfilerOverlay = false; // Default is disabled
+// Profiler frame history dump (F4), written to the working directory (resources/)
+#define PROFILER_CSV_FILE "profile_frames.csv"
+// Chrome trace capture (F5 or --trace), written to the working directory when the capture ends
+#define TRACE_CAPTURE_FILE "frame_trace.json"
+// Camera path export (E) replayed by the flythrough benchmark (--benchmark <path file>)
+#define CAMERA_PATH_FILE "camera_path.txt"
+#define FLYTHROUGH_REPORT_FILE "flythrough_report.json"
+#define FLYTHROUGH_SEED 1234u              // Default random seed of benchmark runs (--seed)
+#define FLYTHROUGH_TIMESTEP (1.0f/60.0f)   // Simulation step of every benchmark frame
+#define FLYTHROUGH_CAMERA_SPEED 6.6f       // Units per second, the walking speed (CAMERA_MOVE_SPEED at 60 fps)
+#define FLYTHROUGH_WARMUP_FRAMES 60        // Frames drawn at the path start before measuring
 // Flag for whether the FarmHouse has been purchased
 bool purchasedFarmhouse = false;
 
-// Function to update animal position and state
-void UpdateAnimal(Animal* animal, float terrainSize) {
-    // Update timer for state changes
-    animal->moveTimer += GetFrameTime();
-
-    if (animal->type == ANIMAL_CHICKEN) {
-        // Chicken-specific logic
-        float enclosurePadding = 0.1f; // Consistent padding
-
-        if (animal->moveTimer >= animal->moveInterval) {
-            animal->moveTimer = 0.0f; // Reset timer for next decision
-            animal->isMoving = true;  // Chickens tend to keep moving or turning
-
-            // New direction: Adjust current direction by a random angle (smoother turns)
-            float turnStrength = 45.0f; // Max turn in degrees for wandering
-            float turnAngle = GetRandomValue(-turnStrength, turnStrength) * DEG2RAD;
-            float currentAngleRad = atan2f(animal->direction.x, animal->direction.z);
-            // Ensure there's a default direction if x and z are zero (e.g. at start)
-            if (animal->direction.x == 0.0f && animal->direction.z == 0.0f) {
-                currentAngleRad = GetRandomValue(0,360) * DEG2RAD;
-            }
-            float newAngleRad = currentAngleRad + turnAngle;
-
-            animal->direction.x = sinf(newAngleRad);
-            animal->direction.z = cosf(newAngleRad);
-            animal->direction = Vector3Normalize(animal->direction);
-            
-            // Longer interval for chickens before random turn
-            animal->moveInterval = 2.0f + GetRandomValue(0, 15)/10.0f; // 2.0 to 3.5 seconds
-        }
-
-        if (animal->isMoving) {
-            Vector3 newPosition = animal->position; // Start with current position
-
-            newPosition.x += animal->direction.x * animal->speed;
-            newPosition.z += animal->direction.z * animal->speed;
-
-            // Enclosure boundaries
-            float minX = ENCLOSURE_CENTER_2.x - (ENCLOSURE_WIDTH_2 / 2.0f);
-            float maxX = ENCLOSURE_CENTER_2.x + (ENCLOSURE_WIDTH_2 / 2.0f);
-            float minZ = ENCLOSURE_CENTER_2.z - (ENCLOSURE_LENGTH_2 / 2.0f);
-            float maxZ = ENCLOSURE_CENTER_2.z + (ENCLOSURE_LENGTH_2 / 2.0f);
-            bool bounced = false;
-
-            // X-axis reflection
-            if (newPosition.x <= minX + enclosurePadding) {
-                newPosition.x = minX + enclosurePadding;
-                animal->direction.x *= -1.0f;
-                animal->direction.z += GetRandomValue(-1, 1) / 20.0f; // Tiny perpendicular nudge
-                bounced = true;
-            } else if (newPosition.x >= maxX - enclosurePadding) {
-                newPosition.x = maxX - enclosurePadding;
-                animal->direction.x *= -1.0f;
-                animal->direction.z += GetRandomValue(-1, 1) / 20.0f;
-                bounced = true;
-            }
+// Get the enclosure of a penned species (chickens and pigs), shrunk by a padding
+BoundingBox GetPenBounds(AnimalType type, float padding) {
+    Vector3 center = (type == ANIMAL_CHICKEN) ? ENCLOSURE_CENTER_2 : ENCLOSURE_CENTER_1;
+    float width = (type == ANIMAL_CHICKEN) ? ENCLOSURE_WIDTH_2 : ENCLOSURE_WIDTH_1;
+    float length = (type == ANIMAL_CHICKEN) ? ENCLOSURE_LENGTH_2 : ENCLOSURE_LENGTH_1;
+    return (BoundingBox){ { center.x - width/2.0f + padding, 0.0f, center.z - length/2.0f + padding },
+                          { center.x + width/2.0f - padding, 0.0f, center.z + length/2.0f - padding } };
+}
 
-            // Z-axis reflection
-            if (newPosition.z <= minZ + enclosurePadding) {
-                newPosition.z = minZ + enclosurePadding;
-                animal->direction.z *= -1.0f;
-                animal->direction.x += GetRandomValue(-1, 1) / 20.0f;
-                bounced = true;
-            } else if (newPosition.z >= maxZ - enclosurePadding) {
-                newPosition.z = maxZ - enclosurePadding;
-                animal->direction.z *= -1.0f;
-                animal->direction.x += GetRandomValue(-1, 1) / 20.0f;
-                bounced = true;
-            }
+// Get the animals an enclosure takes at most (PEN_MAX_DENSITY). Past it the animals overlap more than
+// the collision pushes can resolve and every collision query sees the whole pen.
+int GetPenCapacity(AnimalType type) {
+    BoundingBox pen = GetPenBounds(type, 0.0f);
+    return (int)((pen.max.x - pen.min.x)*(pen.max.z - pen.min.z)*PEN_MAX_DENSITY);
+}
 
-            if (bounced) {
-                animal->direction = Vector3Normalize(animal->direction);
-                // Force commitment to bounce direction: Reset timer to make it take longer for next RANDOM turn decision
-                animal->moveTimer = animal->moveInterval * 0.25f; // Positive value, spend 75% of interval committed to bounce
-                                                                // Effectively, next random turn will be delayed.
-            }
-            animal->position = newPosition; // Position after bounce/clamp
-            animal->rotationAngle = atan2f(animal->direction.x, animal->direction.z) * RAD2DEG;
-        }
-    } else if (animal->type == ANIMAL_PIG) {
-        // Pig-specific logic
-        float enclosurePadding = 0.1f; // Consistent padding
-
-        if (animal->moveTimer >= animal->moveInterval) {
-            animal->moveTimer = 0.0f; // Reset timer for next decision
-            animal->isMoving = true;  // Pigs tend to keep moving or turning
-
-            // New direction: Adjust current direction by a random angle (smoother turns)
-            float turnStrength = 40.0f; // Max turn in degrees for wandering
-            float turnAngle = GetRandomValue(-turnStrength, turnStrength) * DEG2RAD;
-            float currentAngleRad = atan2f(animal->direction.x, animal->direction.z);
-            // Ensure there's a default direction if x and z are zero (e.g. at start)
-            if (animal->direction.x == 0.0f && animal->direction.z == 0.0f) {
-                currentAngleRad = GetRandomValue(0,360) * DEG2RAD;
-            }
-            float newAngleRad = currentAngleRad + turnAngle;
+// Set the heading of an animal, its rotation follows
+void SetAnimalHeading(Herd *herd, int slot, Vector3 direction) {
+    herd->dirX[slot] = direction.x;
+    herd->dirZ[slot] = direction.z;
+    herd->rotation[slot] = atan2f(direction.x, direction.z) * RAD2DEG;
+}
 
-            animal->direction.x = sinf(newAngleRad);
-            animal->direction.z = cosf(newAngleRad);
-            animal->direction = Vector3Normalize(animal->direction);
-            
-            // Interval for pigs before random turn
-            animal->moveInterval = 1.8f + GetRandomValue(0, 15)/10.0f; // 1.8 to 3.3 seconds
-        }
+// Decide the next move of a penned animal: chickens and pigs keep walking and turn smoothly
+void DecidePennedAnimal(Herd *herd, int slot, AnimalType type) {
+    herd->moveTimer[slot] = 0.0f; // Reset timer for next decision
+    herd->moving[slot] = 1.0f;    // Penned animals tend to keep moving or turning
+
+    // New direction: Adjust current direction by a random angle (smoother turns)
+    int turnStrength = (type == ANIMAL_CHICKEN) ? 45 : 40; // Max turn in degrees for wandering
+    float turnAngle = GetHerdRandomValue(herd, slot, -turnStrength, turnStrength) * DEG2RAD;
+    float currentAngleRad = atan2f(herd->dirX[slot], herd->dirZ[slot]);
+    // Ensure there's a default direction if x and z are zero (e.g. at start)
+    if (herd->dirX[slot] == 0.0f && herd->dirZ[slot] == 0.0f) {
+        currentAngleRad = GetHerdRandomValue(herd, slot, 0,360) * DEG2RAD;
+    }
+    float newAngleRad = currentAngleRad + turnAngle;
+    SetAnimalHeading(herd, slot, Vector3Normalize((Vector3){ sinf(newAngleRad), 0.0f, cosf(newAngleRad) }));
 
-        if (animal->isMoving) {
-            Vector3 newPosition = animal->position; // Start with current position
-
-            newPosition.x += animal->direction.x * animal->speed;
-            newPosition.z += animal->direction.z * animal->speed;
-
-            // Enclosure boundaries
-            float minX = ENCLOSURE_CENTER_1.x - (ENCLOSURE_WIDTH_1 / 2.0f);
-            float maxX = ENCLOSURE_CENTER_1.x + (ENCLOSURE_WIDTH_1 / 2.0f);
-            float minZ = ENCLOSURE_CENTER_1.z - (ENCLOSURE_LENGTH_1 / 2.0f);
-            float maxZ = ENCLOSURE_CENTER_1.z + (ENCLOSURE_LENGTH_1 / 2.0f);
-            bool bounced = false;
-
-            // X-axis reflection
-            if (newPosition.x <= minX + enclosurePadding) {
-                newPosition.x = minX + enclosurePadding;
-                animal->direction.x *= -1.0f;
-                animal->direction.z += GetRandomValue(-1, 1) / 20.0f; // Tiny perpendicular nudge
-                bounced = true;
-            } else if (newPosition.x >= maxX - enclosurePadding) {
-                newPosition.x = maxX - enclosurePadding;
-                animal->direction.x *= -1.0f;
-                animal->direction.z += GetRandomValue(-1, 1) / 20.0f;
-                bounced = true;
-            }
+    // Chickens wait 2.0 to 3.5 seconds before the next random turn, pigs 1.8 to 3.3
+    herd->moveInterval[slot] = ((type == ANIMAL_CHICKEN) ? 2.0f : 1.8f) + GetHerdRandomValue(herd, slot, 0, 15)/10.0f;
+}
 
-            // Z-axis reflection
-            if (newPosition.z <= minZ + enclosurePadding) {
-                newPosition.z = minZ + enclosurePadding;
-                animal->direction.z *= -1.0f;
-                animal->direction.x += GetRandomValue(-1, 1) / 20.0f;
-                bounced = true;
-            } else if (newPosition.z >= maxZ - enclosurePadding) {
-                newPosition.z = maxZ - enclosurePadding;
-                animal->direction.z *= -1.0f;
-                animal->direction.x += GetRandomValue(-1, 1) / 20.0f;
-                bounced = true;
-            }
+// Turn a wandering animal by a random angle in degrees
+void TurnAnimal(Herd *herd, int slot, int maxTurn) {
+    float turnAngle = GetHerdRandomValue(herd, slot, -maxTurn, maxTurn) * DEG2RAD;
+    float newAngle = atan2f(herd->dirX[slot], herd->dirZ[slot]) + turnAngle;
+    SetAnimalHeading(herd, slot, (Vector3){ sinf(newAngle), 0.0f, cosf(newAngle) });
+}
 
-            if (bounced) {
-                animal->direction = Vector3Normalize(animal->direction);
-                // Force commitment to bounce direction: Reset timer to make it take longer for next RANDOM turn decision
-                animal->moveTimer = animal->moveInterval * 0.3f; // Positive value, spend 70% of interval committed to bounce
-            }
-            animal->position = newPosition; // Position after bounce/clamp
-            animal->rotationAngle = atan2f(animal->direction.x, animal->direction.z) * RAD2DEG;
-        }
-    } else {
-        // Original logic for other animals (unchanged from previous state)
-        if (animal->moveTimer >= animal->moveInterval) {
-            animal->moveTimer = 0.0f;
+// Decide the next move of a free animal: walk or rest, wander around the spawn position
+void DecideWanderingAnimal(Herd *herd, int slot, AnimalType type) {
+    herd->moveTimer[slot] = 0.0f;
+    Vector3 position = { herd->x[slot], herd->y[slot], herd->z[slot] };
+    Vector3 spawnPosition = { herd->spawnX[slot], herd->y[slot], herd->spawnZ[slot] };
+    float maxWanderDistance = herd->maxWanderDistance[slot];
+
+    // Enhanced behavior for horses and cows to explore further
+    if (type == ANIMAL_HORSE || type == ANIMAL_COW) {
+        // Horses and cows are more likely to keep moving
+        if (GetHerdRandomValue(herd, slot, 0, 100) < 85) {  // Increased probability to move (was 70)
+            herd->moving[slot] = 1.0f;
+            float distanceFromSpawn = Vector3Distance(position, spawnPosition);
             
-            // Enhanced behavior for horses and cows to explore further
-            if (animal->type == ANIMAL_HORSE || animal->type == ANIMAL_COW) {
-                // Horses and cows are more likely to keep moving
-                if (GetRandomValue(0, 100) < 85) {  // Increased probability to move (was 70)
-                    animal->isMoving = true;
-                    float distanceFromSpawn = Vector3Distance(animal->position, animal->spawnPosition);
-                    
-                    // Lower probability of returning to spawn for these animals unless they're really far away
-                    if (GetRandomValue(0, 100) < 50 || distanceFromSpawn > animal->maxWanderDistance) {
-                        if (distanceFromSpawn > animal->maxWanderDistance * 0.9f) {
-                            // Only return to spawn when very close to max distance
-                            Vector3 toSpawn = Vector3Subtract(animal->spawnPosition, animal->position);
-                            animal->direction = Vector3Normalize(toSpawn);
-                        } else {
-                            // Otherwise make smaller turns to create more natural paths
-                            float turnAmount = GetRandomValue(-30, 30) * DEG2RAD;
-                            float currentAngle = atan2f(animal->direction.x, animal->direction.z);
-                            float newAngle = currentAngle + turnAmount;
-                            animal->direction.x = sinf(newAngle);
-                            animal->direction.z = cosf(newAngle);
-                        }
-                    } else {
-                        // Occasional large direction changes for more exploration (up to 180 degrees)
-                        float turnAngle = GetRandomValue(-180, 180) * DEG2RAD;
-                        float currentAngle = atan2f(animal->direction.x, animal->direction.z);
-                        float newAngle = currentAngle + turnAngle;
-                        animal->direction.x = sinf(newAngle);
-                        animal->direction.z = cosf(newAngle);
-                    }
-                    
-                    // Horses and cows move for longer periods
-                    animal->moveInterval = (1.5f + GetRandomValue(0, 25) / 10.0f);
+            // Lower probability of returning to spawn for these animals unless they're really far away
+            if (GetHerdRandomValue(herd, slot, 0, 100) < 50 || distanceFromSpawn > maxWanderDistance) {
+                if (distanceFromSpawn > maxWanderDistance * 0.9f) {
+                    // Only return to spawn when very close to max distance
+                    SetAnimalHeading(herd, slot, Vector3Normalize(Vector3Subtract(spawnPosition, position)));
                 } else {
-                    animal->isMoving = false;
-                    // Shorter resting periods
-                    animal->moveInterval = (1.0f + GetRandomValue(0, 10) / 10.0f);
+                    // Otherwise make smaller turns to create more natural paths
+                    TurnAnimal(herd, slot, 30);
                 }
             } else {
-                // Original logic for other animals
-                if (GetRandomValue(0, 100) < 70) { 
-                    animal->isMoving = true;
-                    float distanceFromSpawn = Vector3Distance(animal->position, animal->spawnPosition);
-                    if (GetRandomValue(0, 100) < 80 || distanceFromSpawn > animal->maxWanderDistance) {
-                        if (distanceFromSpawn > animal->maxWanderDistance * 0.7f) {
-                            Vector3 toSpawn = Vector3Subtract(animal->spawnPosition, animal->position);
-                            animal->direction = Vector3Normalize(toSpawn);
-                        } else {
-                            float turnAmount = GetRandomValue(-45, 45) * DEG2RAD;
-                            float currentAngle = atan2f(animal->direction.x, animal->direction.z);
-                            float newAngle = currentAngle + turnAmount;
-                            animal->direction.x = sinf(newAngle);
-                            animal->direction.z = cosf(newAngle);
-                        }
-                    } else {
-                        float turnAngle = GetRandomValue(-90, 90) * DEG2RAD;
-                        float currentAngle = atan2f(animal->direction.x, animal->direction.z);
-                        float newAngle = currentAngle + turnAngle;
-                        animal->direction.x = sinf(newAngle);
-                        animal->direction.z = cosf(newAngle);
-                    }
-                    animal->moveInterval = (animal->isMoving ? 1.0f : 2.0f) + GetRandomValue(0, 20) / 10.0f;
+                // Occasional large direction changes for more exploration (up to 180 degrees)
+                TurnAnimal(herd, slot, 180);
+            }
+            
+            // Horses and cows move for longer periods
+            herd->moveInterval[slot] = (1.5f + GetHerdRandomValue(herd, slot, 0, 25) / 10.0f);
+        } else {
+            herd->moving[slot] = 0.0f;
+            // Shorter resting periods
+            herd->moveInterval[slot] = (1.0f + GetHerdRandomValue(herd, slot, 0, 10) / 10.0f);
+        }
+    } else {
+        // Original logic for other animals
+        if (GetHerdRandomValue(herd, slot, 0, 100) < 70) { 
+            herd->moving[slot] = 1.0f;
+            float distanceFromSpawn = Vector3Distance(position, spawnPosition);
+            if (GetHerdRandomValue(herd, slot, 0, 100) < 80 || distanceFromSpawn > maxWanderDistance) {
+                if (distanceFromSpawn > maxWanderDistance * 0.7f) {
+                    SetAnimalHeading(herd, slot, Vector3Normalize(Vector3Subtract(spawnPosition, position)));
                 } else {
-                    animal->isMoving = false;
-                    animal->moveInterval = (animal->isMoving ? 1.0f : 2.0f) + GetRandomValue(0, 20) / 10.0f;
+                    TurnAnimal(herd, slot, 45);
                 }
+            } else {
+                TurnAnimal(herd, slot, 90);
             }
+            herd->moveInterval[slot] = 1.0f + GetHerdRandomValue(herd, slot, 0, 20) / 10.0f;
+        } else {
+            herd->moving[slot] = 0.0f;
+            herd->moveInterval[slot] = 2.0f + GetHerdRandomValue(herd, slot, 0, 20) / 10.0f;
         }
+    }
+}
 
-        if (animal->isMoving) {
-            Vector3 oldPosition = animal->position; 
-            animal->position.x += animal->direction.x * animal->speed;
-            animal->position.z += animal->direction.z * animal->speed;
-            
-            float boundary = terrainSize/2.0f - 2.0f;
-            if (animal->position.x < -boundary) animal->position.x = -boundary;
-            if (animal->position.x > boundary) animal->position.x = boundary;
-            if (animal->position.z < -boundary) animal->position.z = -boundary;
-            if (animal->position.z > boundary) animal->position.z = boundary;
-            
-            animal->rotationAngle = atan2f(animal->direction.x, animal->direction.z) * RAD2DEG;
+// Turn the penned animals of a slot range that ClampHerdToRect() stopped at the fence back inside.
+// commitment is the part of the decision interval already spent, the animal keeps the bounce heading for the rest.
+void BouncePennedAnimals(Herd *herd, int begin, int end, float commitment) {
+    for (int i = begin; i < end; i++) {
+        if (herd->bounced[i] == 0) continue;
+
+        Vector3 direction = { herd->dirX[i], 0.0f, herd->dirZ[i] };
+        if (herd->bounced[i] & HERD_BOUNCED_X) {
+            direction.x *= -1.0f;
+            direction.z += GetHerdRandomValue(herd, i, -1, 1) / 20.0f; // Tiny perpendicular nudge
+        }
+        if (herd->bounced[i] & HERD_BOUNCED_Z) {
+            direction.z *= -1.0f;
+            direction.x += GetHerdRandomValue(herd, i, -1, 1) / 20.0f;
         }
+        SetAnimalHeading(herd, i, Vector3Normalize(direction));
+        herd->moveTimer[i] = herd->moveInterval[i] * commitment;
     }
+}
+
+// Push the walking animals of a slot range out of buildings, trees and other animals.
+// Scalar: every animal runs its own grid queries. The other animals are read from the snapshot of
+// the step start (prevX, prevZ) and the grid isn't moved until every animal is updated, so the
+// result doesn't depend on which animals were already updated (or by which thread).
+void ResolveHerdCollisions(AnimalType type, int begin, int end) {
+    Herd *herd = &herds[type];
 
-    // --- Generic Collision Handling for ALL Animals (AFTER type-specific movement) ---
-    if (animal->isMoving) { // Only check collisions if animal attempted to move
-        Vector3 preCollisionPosition = animal->position; // Position after movement but before building/other animal collision
+    for (int i = begin; i < end; i++) {
+        if (herd->moving[i] == 0.0f) continue; // Only check collisions if the animal attempted to move
+
+        Vector3 position = { herd->x[i], herd->y[i], herd->z[i] };
+        float scale = herd->scale[i];
 
         // Check for collisions with buildings
         int collidedBuildingIndex = -1;
         // The IsCollisionWithBuilding function already has logic to ignore buildings with scale 1.0f (like the ChickenCoop)
-        if (IsCollisionWithBuilding(animal->position, animal->scale * 0.7f, &collidedBuildingIndex)) {
-            animal->position = Vector3MoveTowards(preCollisionPosition, buildings[collidedBuildingIndex].position, -animal->speed); // Try to step back slightly
+        if (IsCollisionWithBuilding(position, scale * 0.7f, &collidedBuildingIndex)) {
+            // Trees have no index, bounce off a point straight ahead
+            Vector3 obstacle = (collidedBuildingIndex >= 0) ? buildings[collidedBuildingIndex].position :
+                               Vector3Add(position, (Vector3){ herd->dirX[i], 0.0f, herd->dirZ[i] });
+            position = Vector3MoveTowards(position, obstacle, -herd->speed[i]); // Try to step back slightly
 
             // Simplified bounce off building for all animals
-            Vector3 awayFromBuilding = Vector3Normalize(Vector3Subtract(animal->position, buildings[collidedBuildingIndex].position));
-            animal->direction.x = awayFromBuilding.x + GetRandomValue(-1,1)/10.0f;
-            animal->direction.z = awayFromBuilding.z + GetRandomValue(-1,1)/10.0f;
-            animal->direction = Vector3Normalize(animal->direction);
-            animal->rotationAngle = atan2f(animal->direction.x, animal->direction.z) * RAD2DEG;
-            animal->moveTimer = 0; // Re-evaluate direction quickly
+            Vector3 awayFromBuilding = Vector3Normalize(Vector3Subtract(position, obstacle));
+            Vector3 direction = { awayFromBuilding.x + GetHerdRandomValue(herd, i, -1,1)/10.0f, 0.0f, awayFromBuilding.z + GetHerdRandomValue(herd, i, -1,1)/10.0f };
+            SetAnimalHeading(herd, i, Vector3Normalize(direction));
+            herd->moveTimer[i] = 0; // Re-evaluate direction quickly
         }
 
-        // Check for collisions with other animals
-        for (int i = 0; i < animalCount; i++) {
-            if (!animals[i].active || &animals[i] == animal) continue;
-
-            float distance = Vector3Distance(animal->position, animals[i].position);
-            float minDistance = (animal->scale + animals[i].scale) * 0.6f; // Reduced for less pushing
+        // Check for collisions with other animals (only the ones in the surrounding cells)
+        int selfId = GetAnimalId(type, i);
+        int buffer[COLLISION_QUERY_IDS];
+        int *candidates = NULL;
+        int candidateCount = QueryCollisionGrid(&animalGrid, position, (scale + maxAnimalScale) * 0.6f, buffer, COLLISION_QUERY_IDS, &candidates);
+        for (int c = 0; c < candidateCount; c++) {
+            if (candidates[c] == selfId) continue;
+
+            Herd *other = &herds[GetAnimalType(candidates[c])];
+            int otherSlot = GetAnimalSlot(candidates[c]);
+            Vector3 otherPosition = { other->prevX[otherSlot], other->y[otherSlot], other->prevZ[otherSlot] };
+            float otherScale = other->scale[otherSlot];
+            float distance = Vector3Distance(position, otherPosition);
+            float minDistance = (scale + otherScale) * 0.6f; // Reduced for less pushing
 
             if (distance < minDistance) {
-                Vector3 resolutionVector = Vector3Normalize(Vector3Subtract(animal->position, animals[i].position));
-                // Move both animals away from each other slightly
-                animal->position = Vector3Add(animal->position, Vector3Scale(resolutionVector, (minDistance - distance) / 2.0f));
-                // animals[i].position = Vector3Subtract(animals[i].position, Vector3Scale(resolutionVector, (minDistance - distance) / 2.0f)); 
-                // ^ Modifying other animals here can be complex; focus on current animal's reaction.
+                Vector3 resolutionVector = Vector3Normalize(Vector3Subtract(position, otherPosition));
+                // Move away from the other animal slightly, it reacts on its own update
+                position = Vector3Add(position, Vector3Scale(resolutionVector, (minDistance - distance) / 2.0f));
                 
                 // Current animal decides to change direction
-                animal->direction = resolutionVector; // Move directly away
-                animal->rotationAngle = atan2f(animal->direction.x, animal->direction.z) * RAD2DEG;
-                animal->moveTimer = animal->moveInterval * 0.1f; // Quicker re-evaluation
+                SetAnimalHeading(herd, i, resolutionVector); // Move directly away
+                herd->moveTimer[i] = herd->moveInterval[i] * 0.1f; // Quicker re-evaluation
             }
         }
+        if (candidates != buffer) MemFree(candidates);
+
+        herd->x[i] = position.x;
+        herd->z[i] = position.z;
     }
-    // --- FINAL FAILSAFE CLAMP for Chickens (after all other collisions) ---
-    if (animal->type == ANIMAL_CHICKEN) {
-        float minX = ENCLOSURE_CENTER_2.x - (ENCLOSURE_WIDTH_2 / 2.0f);
-        float maxX = ENCLOSURE_CENTER_2.x + (ENCLOSURE_WIDTH_2 / 2.0f);
-        float minZ = ENCLOSURE_CENTER_2.z - (ENCLOSURE_LENGTH_2 / 2.0f);
-        float maxZ = ENCLOSURE_CENTER_2.z + (ENCLOSURE_LENGTH_2 / 2.0f);
-        float padding = 0.05f; // Minimal padding
-
-        if (animal->position.x < minX + padding) animal->position.x = minX + padding;
-        if (animal->position.x > maxX - padding) animal->position.x = maxX - padding;
-        if (animal->position.z < minZ + padding) animal->position.z = minZ + padding;
-        if (animal->position.z > maxZ - padding) animal->position.z = maxZ - padding;
-    }
-    // --- FINAL FAILSAFE CLAMP for Pigs (after all other collisions) ---
-    else if (animal->type == ANIMAL_PIG) {
-        float minX = ENCLOSURE_CENTER_1.x - (ENCLOSURE_WIDTH_1 / 2.0f);
-        float maxX = ENCLOSURE_CENTER_1.x + (ENCLOSURE_WIDTH_1 / 2.0f);
-        float minZ = ENCLOSURE_CENTER_1.z - (ENCLOSURE_LENGTH_1 / 2.0f);
-        float maxZ = ENCLOSURE_CENTER_1.z + (ENCLOSURE_LENGTH_1 / 2.0f);
-        float padding = 0.05f; // Minimal padding
-
-        if (animal->position.x < minX + padding) animal->position.x = minX + padding;
-        if (animal->position.x > maxX - padding) animal->position.x = maxX - padding;
-        if (animal->position.z < minZ + padding) animal->position.z = minZ + padding;
-        if (animal->position.z > maxZ - padding) animal->position.z = maxZ - padding;
-    }
-
-    // Update animation
-    animal->animFrameCounter++;
-    
-    // Update the appropriate animation based on movement state
-    if (animal->isMoving && animal->walkingAnimCount > 0) {
-        UpdateModelAnimation(animal->walkingModel, animal->walkingAnim[0], animal->animFrameCounter);
-        if (animal->animFrameCounter >= animal->walkingAnim[0].frameCount) {
-            animal->animFrameCounter = 0;
+}
+
+// Update the animals of a slot range of one herd.
+// Timers, movement, fence and terrain clamps and animation run as batch kernels over the herd
+// arrays, the random decisions, bounces and collision queries only visit the animals that need them.
+void UpdateHerdRange(AnimalType type, int begin, int end, float deltaTime) {
+    Herd *herd = &herds[type];
+    bool penned = (type == ANIMAL_CHICKEN) || (type == ANIMAL_PIG);
+
+    AdvanceHerdTimers(herd, begin, end, deltaTime);
+    for (int i = begin; i < end; i++) {
+        if (herd->moveTimer[i] < herd->moveInterval[i]) continue;
+        if (penned) DecidePennedAnimal(herd, i, type);
+        else DecideWanderingAnimal(herd, i, type);
+    }
+
+    MoveHerd(herd, begin, end);
+    if (penned) {
+        // Bounce off the fence, chickens commit to the new heading for 75% of the interval, pigs 70%
+        BoundingBox pen = GetPenBounds(type, 0.1f);
+        if (ClampHerdToRect(herd, begin, end, pen.min.x, pen.max.x, pen.min.z, pen.max.z) > 0) {
+            BouncePennedAnimals(herd, begin, end, (type == ANIMAL_CHICKEN) ? 0.25f : 0.3f);
+        }
+    } else {
+        float boundary = FIXED_TERRAIN_SIZE/2.0f - 2.0f;
+        ClampHerdToRect(herd, begin, end, -boundary, boundary, -boundary, boundary);
+    }
+
+    ResolveHerdCollisions(type, begin, end);
+
+    // Final failsafe clamp of penned animals (after all other collisions), minimal padding
+    if (penned) {
+        BoundingBox pen = GetPenBounds(type, 0.05f);
+        ClampHerdPositions(herd, begin, end, pen.min.x, pen.max.x, pen.min.z, pen.max.z);
+    }
+
+    // Update animation (only the frame counters, the shared model is posed when the animal is drawn)
+    AnimalAssets *assets = &animalAssets[type];
+    AdvanceHerdAnimation(herd, begin, end, (assets->walkingAnimCount > 0) ? assets->walkingAnim[0].frameCount : 0,
+                         (assets->idleAnimCount > 0) ? assets->idleAnim[0].frameCount : 0);
+}
+
+// Animal update jobs: every herd is cut into chunks of ANIMAL_UPDATE_CHUNK_SIZE slots
+#define ANIMAL_UPDATE_CHUNK_SIZE 256
+
+typedef struct {
+    AnimalType type;
+    int begin;
+    int end;
+} AnimalUpdateChunk;
+
+typedef struct {
+    const AnimalUpdateChunk *chunks;
+    float deltaTime;
+} AnimalUpdateJob;
+
+AnimalUpdateChunk *animalUpdateChunks = NULL;   // Grown by UpdateAnimals(), freed by UnloadEntityPools()
+int animalUpdateChunkCapacity = 0;
+
+// Job: update the chunks [begin, end)
+void UpdateAnimalChunks(void *data, int begin, int end) {
+    const AnimalUpdateJob *job = (const AnimalUpdateJob *)data;
+    for (int c = begin; c < end; c++) {
+        UpdateHerdRange(job->chunks[c].type, job->chunks[c].begin, job->chunks[c].end, job->deltaTime);
+    }
+}
+
+// Update every herd on the job pool and keep the animal collision grid in sync.
+// The snapshot is taken before any job runs and the grid is moved after the last one, in slot order.
+void UpdateAnimals(float deltaTime) {
+    int chunkCount = 0;
+    for (int type = 0; type < ANIMAL_COUNT; type++) {
+        chunkCount += (herds[type].count + ANIMAL_UPDATE_CHUNK_SIZE - 1)/ANIMAL_UPDATE_CHUNK_SIZE;
+        SaveHerdState(&herds[type]);
+    }
+    if (chunkCount == 0) return;
+
+    if (chunkCount > animalUpdateChunkCapacity) {
+        AnimalUpdateChunk *chunks = (AnimalUpdateChunk *)MemRealloc(animalUpdateChunks, chunkCount*sizeof(AnimalUpdateChunk));
+        if (chunks == NULL) {
+            TraceLog(LOG_ERROR, "SIMULATION: Failed to allocate %d animal update chunks", chunkCount);
+            return;
+        }
+        animalUpdateChunks = chunks;
+        animalUpdateChunkCapacity = chunkCount;
+    }
+
+    int chunk = 0;
+    for (int type = 0; type < ANIMAL_COUNT; type++) {
+        for (int begin = 0; begin < herds[type].count; begin += ANIMAL_UPDATE_CHUNK_SIZE) {
+            int end = begin + ANIMAL_UPDATE_CHUNK_SIZE;
+            animalUpdateChunks[chunk++] = (AnimalUpdateChunk){ (AnimalType)type, begin, (end < herds[type].count) ? end : herds[type].count };
         }
-    } else if (animal->idleAnimCount > 0) {
-        UpdateModelAnimation(animal->idleModel, animal->idleAnim[0], animal->animFrameCounter);
-        if (animal->animFrameCounter >= animal->idleAnim[0].frameCount) {
-            animal->animFrameCounter = 0;
+    }
+
+    // A farm smaller than one chunk isn't worth waking the workers for, it runs as a single batch
+    AnimalUpdateJob job = { animalUpdateChunks, deltaTime };
+    RunParallelFor(chunkCount, (animalCount < ANIMAL_UPDATE_CHUNK_SIZE) ? chunkCount : 1, UpdateAnimalChunks, &job);
+
+    for (int type = 0; type < ANIMAL_COUNT; type++) {
+        Herd *herd = &herds[type];
+        for (int i = 0; i < herd->count; i++) {
+            SpatialHashMove(&animalGrid, herd->gridEntry[i], (Vector3){ herd->x[i], herd->y[i], herd->z[i] });
         }
     }
 }
 
 // Function to spawn an animal of specified type
 void SpawnAnimal(AnimalType type, Vector3 position, float terrainSize) {
-    if (animalCount >= MAX_ANIMALS) {
+    if (animalCount >= maxAnimals) {
         TraceLog(LOG_WARNING, "Cannot spawn more animals - maximum limit reached.");
         return;
     }
+    if (type < 0 || type >= ANIMAL_COUNT) {
+        TraceLog(LOG_ERROR, "Invalid animal type: %d", type);
+        return;
+    }
     
-    InitAnimal(&animals[animalCount], type, position);
+    TraceMarker("SpawnAnimal", "game");
+    Herd *herd = &herds[type];
+    unsigned int seed = ((unsigned int)GetRandomValue(0, 32767) << 15) | (unsigned int)GetRandomValue(0, 32767); // Within RAND_MAX everywhere
+    int slot = AddHerdAnimal(herd, position, seed);
+    if (slot == -1) return;
+    InitAnimal(type, slot);
+
+    // Models and clips are shared per species, every non-empty herd holds one reference
+    if (herd->count == 1) AcquireAnimalAssets(type);
+
+    herd->gridEntry[slot] = SpatialHashInsert(&animalGrid, GetAnimalId(type, slot), position);
+    AttachAnimalSound(type, slot);
+    if (herd->scale[slot] > maxAnimalScale) maxAnimalScale = herd->scale[slot];
     animalCountByType[type]++;
     animalCount++;
 }
@@ -1541,17 +2353,19 @@ Vector3 GetRandomSpawnPosition(float terrainSize, Camera camera) {
             continue;
         }
         
-        // Check for collisions with other animals
+        // Check for collisions with other animals (only the ones in the surrounding cells)
         validPosition = true;
-        for (int i = 0; i < animalCount; i++) {
-            if (!animals[i].active) continue;
-            
-            float dist = Vector3Distance(position, animals[i].position);
+        int buffer[COLLISION_QUERY_IDS];
+        int *candidates = NULL;
+        int candidateCount = QueryCollisionGrid(&animalGrid, position, minDistance, buffer, COLLISION_QUERY_IDS, &candidates);
+        for (int c = 0; c < candidateCount; c++) {
+            float dist = Vector3Distance(position, GetAnimalPosition(candidates[c]));
             if (dist < minDistance) {
                 validPosition = false;
                 break;
             }
         }
+        if (candidates != buffer) MemFree(candidates);
         
         attempts++;
     }
@@ -1561,80 +2375,185 @@ Vector3 GetRandomSpawnPosition(float terrainSize, Camera camera) {
 
 // Function to spawn multiple animals at once
 void SpawnMultipleAnimals(AnimalType type, int count, float terrainSize, Camera camera) {
-    for (int i = 0; i < count && animalCount < MAX_ANIMALS; i++) {
+    for (int i = 0; i < count && animalCount < maxAnimals; i++) {
         Vector3 position = GetRandomSpawnPosition(terrainSize, camera);
         SpawnAnimal(type, position, terrainSize);
     }
 }
 
-// Draw all animals
-void DrawAnimals(void) {
-    for (int i = 0; i < animalCount; i++) {
-        if (!animals[i].active) continue;
-        
-        Animal *animal = &animals[i];
-        
-        // Get the appropriate model based on state
-        Model modelToDraw = (animal->isMoving) ? animal->walkingModel : animal->idleModel;
-        
-        // Draw the animal with its original texture
-        DrawModelEx(modelToDraw,
-                   animal->position,
-                   (Vector3){0.0f, 1.0f, 0.0f},  // Rotation axis (Y-axis)
-                   animal->rotationAngle,        // Rotation angle
-                   (Vector3){animal->scale, animal->scale, animal->scale},
-                   WHITE);
+// Interpolate between two angles in degrees, the shorter way around
+float LerpAngleDegrees(float from, float to, float t) {
+    float delta = fmodf(to - from, 360.0f);
+    if (delta > 180.0f) delta -= 360.0f;
+    else if (delta < -180.0f) delta += 360.0f;
+    return from + delta*t;
+}
+
+// Draw all animals, interpolated between the last two simulation steps
+void DrawAnimals(Camera camera, const Frustum *frustum) {
+    for (int type = 0; type < ANIMAL_COUNT; type++) {
+        Herd *herd = &herds[type];
+        AnimalAssets *assets = &animalAssets[type];
+
+        for (int i = 0; i < herd->count; i++) {
+            Vector3 position = { Lerp(herd->prevX[i], herd->x[i], simulationAlpha), herd->y[i], Lerp(herd->prevZ[i], herd->z[i], simulationAlpha) };
+            float rotationAngle = LerpAngleDegrees(herd->prevRotation[i], herd->rotation[i], simulationAlpha);
+            float scale = herd->scale[i];
+
+            BoundingSphere sphere = { position, assets->boundsRadius*scale };
+            bool visible = IsSphereInFogRange(sphere) && FrustumContainsSphere(frustum, sphere);
+            RecordCullResult(CULL_ANIMALS, visible);
+            if (!visible) continue;
+            
+            // Get the appropriate model based on state and its level for the animal's size on screen,
+            // then pose it for this animal
+            bool isMoving = (herd->moving[i] > 0.0f);
+            ModelLods *lods = isMoving ? assets->walkingLods : assets->idleLods;
+            int level = GetModelLodLevel(lods, position, scale, camera);
+            Model modelToDraw = GetModelLod(isMoving ? assets->walkingModel : assets->idleModel, lods, level);
+            RecordModelLodDraw(lods, level, 1);
+            if (isMoving && assets->walkingAnimCount > 0) {
+                UpdateSkinnedModel(modelToDraw, assets->walkingAnim[0], herd->animFrame[i]);
+            } else if (!isMoving && assets->idleAnimCount > 0) {
+                UpdateSkinnedModel(modelToDraw, assets->idleAnim[0], herd->animFrame[i]);
+            }
+            
+            // Draw the animal with its original texture
+            DrawModelEx(modelToDraw,
+                       position,
+                       (Vector3){0.0f, 1.0f, 0.0f},  // Rotation axis (Y-axis)
+                       rotationAngle,                // Rotation angle
+                       (Vector3){scale, scale, scale},
+                       WHITE);
+        }
     }
 }
 
-// Unload all animal resources
+// Unload all animal resources: empty the herds, releasing each species' assets
 void UnloadAnimalResources(void) {
-    for (int i = 0; i < ANIMAL_COUNT; i++) {
-        UnloadModel(animals[i].walkingModel);
-        UnloadModel(animals[i].idleModel);
-        
-        if (animals[i].walkingAnim != NULL && animals[i].walkingAnimCount > 0) {
-            UnloadModelAnimations(animals[i].walkingAnim, animals[i].walkingAnimCount);
+    for (int type = 0; type < ANIMAL_COUNT; type++) {
+        Herd *herd = &herds[type];
+        if (herd->count == 0) continue;
+        for (int i = 0; i < herd->count; i++) SpatialHashRemove(&animalGrid, herd->gridEntry[i]);
+        ReleaseAnimalAssets(type);
+        herd->count = 0;
+        animalCountByType[type] = 0;
+    }
+    animalCount = 0;
+}
+
+// Generate a terrain chunk mesh: a flat CHUNK_SIZE grid with tiled UVs.
+// Odd vertices on edges in edgeMask are snapped to their even neighbour so the edge matches a
+// neighbour with half the resolution (no T-junctions), triangles collapsed by the snap are dropped.
+Mesh GenTerrainLodMesh(int resolution, int edgeMask) {
+    // Adjust texture tiling for higher detail
+    float textureTilingX = 4.0f;
+    float textureTilingZ = 4.0f;
+
+    Mesh mesh = { 0 };
+    int verticesPerSide = resolution + 1;
+    mesh.vertexCount = verticesPerSide*verticesPerSide;
+    mesh.vertices = (float *)MemAlloc(mesh.vertexCount*3*sizeof(float));
+    mesh.normals = (float *)MemAlloc(mesh.vertexCount*3*sizeof(float));
+    mesh.texcoords = (float *)MemAlloc(mesh.vertexCount*2*sizeof(float));
+    mesh.indices = (unsigned short *)MemAlloc(resolution*resolution*6*sizeof(unsigned short));
+
+    float step = CHUNK_SIZE/resolution;
+    for (int iz = 0; iz < verticesPerSide; iz++) {
+        for (int ix = 0; ix < verticesPerSide; ix++) {
+            int v = iz*verticesPerSide + ix;
+            mesh.vertices[v*3 + 0] = -CHUNK_SIZE/2.0f + ix*step;
+            mesh.vertices[v*3 + 1] = 0.0f;
+            mesh.vertices[v*3 + 2] = -CHUNK_SIZE/2.0f + iz*step;
+            mesh.normals[v*3 + 0] = 0.0f;
+            mesh.normals[v*3 + 1] = 1.0f;
+            mesh.normals[v*3 + 2] = 0.0f;
+            mesh.texcoords[v*2 + 0] = (float)ix/resolution*textureTilingX;
+            mesh.texcoords[v*2 + 1] = (float)iz/resolution*textureTilingZ;
         }
-        
-        if (animals[i].idleAnim != NULL && animals[i].idleAnimCount > 0) {
-            UnloadModelAnimations(animals[i].idleAnim, animals[i].idleAnimCount);
+    }
+
+    int triangleCount = 0;
+    for (int iz = 0; iz < resolution; iz++) {
+        for (int ix = 0; ix < resolution; ix++) {
+            int corners[4][2] = { { ix, iz }, { ix, iz + 1 }, { ix + 1, iz + 1 }, { ix + 1, iz } };
+            unsigned short quad[4] = { 0 };
+
+            for (int c = 0; c < 4; c++) {
+                int cx = corners[c][0];
+                int cz = corners[c][1];
+                if ((cz == 0) && (edgeMask & TERRAIN_EDGE_NEG_Z) && (cx % 2 == 1)) cx--;
+                if ((cz == resolution) && (edgeMask & TERRAIN_EDGE_POS_Z) && (cx % 2 == 1)) cx--;
+                if ((cx == 0) && (edgeMask & TERRAIN_EDGE_NEG_X) && (cz % 2 == 1)) cz--;
+                if ((cx == resolution) && (edgeMask & TERRAIN_EDGE_POS_X) && (cz % 2 == 1)) cz--;
+                quad[c] = (unsigned short)(cz*verticesPerSide + cx);
+            }
+
+            // Two counter-clockwise triangles (seen from above) per quad
+            unsigned short triangles[2][3] = { { quad[0], quad[1], quad[2] }, { quad[0], quad[2], quad[3] } };
+            for (int t = 0; t < 2; t++) {
+                if ((triangles[t][0] == triangles[t][1]) || (triangles[t][1] == triangles[t][2]) || (triangles[t][0] == triangles[t][2])) continue;
+                memcpy(&mesh.indices[triangleCount*3], triangles[t], sizeof(triangles[t]));
+                triangleCount++;
+            }
         }
     }
+    mesh.triangleCount = triangleCount;
+
+    UploadMesh(&mesh, false);
+    return mesh;
 }
 
-// Function to initialize a terrain chunk
-void InitTerrainChunk(TerrainChunk* chunk, Vector2 position, Texture2D terrainTexture) {
-    chunk->position = position;
-    chunk->worldPos = (Vector3){ position.x * CHUNK_SIZE, 0.0f, position.y * CHUNK_SIZE };
-    chunk->active = true;
+// Generate the shared terrain LOD meshes and the terrain material
+void InitTerrainLods(Texture2D terrainTexture) {
+    for (int level = 0; level < TERRAIN_LOD_COUNT; level++) {
+        int resolution = TERRAIN_LOD_BASE_RESOLUTION >> level;
+        int maskCount = (level < TERRAIN_LOD_COUNT - 1) ? 16 : 1;
+        for (int mask = 0; mask < maskCount; mask++) {
+            terrainLodMeshes[level][mask] = GenTerrainLodMesh(resolution, mask);
+        }
+    }
 
-    // Generate a more detailed mesh for the terrain
-    Mesh terrainMesh = GenMeshPlane(CHUNK_SIZE, CHUNK_SIZE, 128, 128);  // Increased mesh detail
+    terrainMaterial = LoadMaterialDefault();
+    SetMaterialTexture(&terrainMaterial, MATERIAL_MAP_DIFFUSE, terrainTexture);
+    if (fogEnabled) terrainMaterial.shader = fogShader;
 
-    // Adjust texture tiling for higher detail
-    float textureTilingX = 4.0f;
-    float textureTilingZ = 4.0f;
+    TraceLog(LOG_INFO, "Terrain LOD: %d levels, %d to %d triangles per chunk", TERRAIN_LOD_COUNT,
+             terrainLodMeshes[TERRAIN_LOD_COUNT - 1][0].triangleCount, terrainLodMeshes[0][0].triangleCount);
+}
 
-    // Update UV mapping for better texture repetition
-    for (int i = 0; i < terrainMesh.vertexCount; i++)
-    {
-        terrainMesh.texcoords[i * 2] *= textureTilingX;
-        terrainMesh.texcoords[i * 2 + 1] *= textureTilingZ;
+// Unload the shared terrain LOD meshes (the texture is owned by the caller)
+void UnloadTerrainLods(void) {
+    for (int level = 0; level < TERRAIN_LOD_COUNT; level++) {
+        for (int mask = 0; mask < 16; mask++) {
+            if (terrainLodMeshes[level][mask].vertexCount > 0) UnloadMesh(terrainLodMeshes[level][mask]);
+            terrainLodMeshes[level][mask] = (Mesh){ 0 };
+        }
     }
+    MemFree(terrainMaterial.maps);
+}
+
+// Function to initialize a terrain chunk
+void InitTerrainChunk(TerrainChunk* chunk, Vector2 position) {
+    chunk->position = position;
+    chunk->worldPos = (Vector3){ position.x * CHUNK_SIZE, 0.0f, position.y * CHUNK_SIZE };
+    chunk->active = true;
+    chunk->lodLevel = 0;
+    chunk->edgeMask = 0;
 
-    chunk->model = LoadModelFromMesh(terrainMesh);
-    chunk->model.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = terrainTexture;
-    SetMaterialTexture(&chunk->model.materials[0], MATERIAL_MAP_DIFFUSE, terrainTexture);
+    Vector3 halfSize = { CHUNK_SIZE/2.0f, 0.0f, CHUNK_SIZE/2.0f };
+    chunk->bounds = (BoundingBox){ Vector3Subtract(chunk->worldPos, halfSize), Vector3Add(chunk->worldPos, halfSize) };
 }
 
 // Function to initialize all terrain chunks in a fixed grid
 void InitAllTerrainChunks(Texture2D terrainTexture) {
+    InitTerrainLods(terrainTexture);
+
     int index = 0;
     for (int z = 0; z < TERRAIN_CHUNKS_PER_SIDE; z++) {
         for (int x = 0; x < TERRAIN_CHUNKS_PER_SIDE; x++) {
             Vector2 chunkPos = { x - TERRAIN_CHUNKS_PER_SIDE/2.0f, z - TERRAIN_CHUNKS_PER_SIDE/2.0f };
-            InitTerrainChunk(&terrainChunks[index], chunkPos, terrainTexture);
+            InitTerrainChunk(&terrainChunks[index], chunkPos);
             index++;
         }
     }
@@ -1648,37 +2567,391 @@ void UpdateTerrainChunks(Vector3 playerPosition, Texture2D terrainTexture) {
     if (playerPosition.x > boundary) playerPosition.x = boundary;
     if (playerPosition.z < -boundary) playerPosition.z = -boundary;
     if (playerPosition.z > boundary) playerPosition.z = boundary;
+
+    // Pick each chunk's LOD from the distance to its closest point, one ring per TERRAIN_LOD_RING_SIZE
+    for (int i = 0; i < MAX_TERRAIN_CHUNKS; i++) {
+        TerrainChunk *chunk = &terrainChunks[i];
+        float dx = fmaxf(fabsf(playerPosition.x - chunk->worldPos.x) - CHUNK_SIZE/2.0f, 0.0f);
+        float dz = fmaxf(fabsf(playerPosition.z - chunk->worldPos.z) - CHUNK_SIZE/2.0f, 0.0f);
+        int level = (int)(sqrtf(dx*dx + dz*dz)/TERRAIN_LOD_RING_SIZE);
+        chunk->lodLevel = (level < TERRAIN_LOD_COUNT - 1) ? level : TERRAIN_LOD_COUNT - 1;
+    }
+
+    // Neighbours may differ by one level at most so every seam can be stitched
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int z = 0; z < TERRAIN_CHUNKS_PER_SIDE; z++) {
+            for (int x = 0; x < TERRAIN_CHUNKS_PER_SIDE; x++) {
+                TerrainChunk *chunk = &terrainChunks[z*TERRAIN_CHUNKS_PER_SIDE + x];
+                int neighbours[4][2] = { { x, z - 1 }, { x + 1, z }, { x, z + 1 }, { x - 1, z } };
+                for (int n = 0; n < 4; n++) {
+                    int nx = neighbours[n][0], nz = neighbours[n][1];
+                    if (nx < 0 || nz < 0 || nx >= TERRAIN_CHUNKS_PER_SIDE || nz >= TERRAIN_CHUNKS_PER_SIDE) continue;
+                    int neighbourLevel = terrainChunks[nz*TERRAIN_CHUNKS_PER_SIDE + nx].lodLevel;
+                    if (chunk->lodLevel > neighbourLevel + 1) {
+                        chunk->lodLevel = neighbourLevel + 1;
+                        changed = true;
+                    }
+                }
+            }
+        }
+    }
+
+    // Stitch the edges facing a coarser neighbour (edge order matches TerrainEdge)
+    for (int z = 0; z < TERRAIN_CHUNKS_PER_SIDE; z++) {
+        for (int x = 0; x < TERRAIN_CHUNKS_PER_SIDE; x++) {
+            TerrainChunk *chunk = &terrainChunks[z*TERRAIN_CHUNKS_PER_SIDE + x];
+            int neighbours[4][2] = { { x, z - 1 }, { x + 1, z }, { x, z + 1 }, { x - 1, z } };
+            chunk->edgeMask = 0;
+            for (int n = 0; n < 4; n++) {
+                int nx = neighbours[n][0], nz = neighbours[n][1];
+                if (nx < 0 || nz < 0 || nx >= TERRAIN_CHUNKS_PER_SIDE || nz >= TERRAIN_CHUNKS_PER_SIDE) continue;
+                if (terrainChunks[nz*TERRAIN_CHUNKS_PER_SIDE + nx].lodLevel > chunk->lodLevel) chunk->edgeMask |= (1 << n);
+            }
+        }
+    }
 }
 
 // Function to draw terrain chunks with fog effect
-void DrawTerrainChunks(void) {
+void DrawTerrainChunks(const Frustum *frustum) {
+    terrainTrianglesDrawn = 0;
+    terrainVerticesDrawn = 0;
+
     // Draw terrain chunks without using BeginShaderMode
     for (int i = 0; i < MAX_TERRAIN_CHUNKS; i++) {
-        if (terrainChunks[i].active) {
-            DrawModel(terrainChunks[i].model, terrainChunks[i].worldPos, 1.0f, WHITE);
+        TerrainChunk *chunk = &terrainChunks[i];
+        if (!chunk->active) continue;
+
+        bool visible = IsBoxInFogRange(chunk->bounds) && FrustumContainsBox(frustum, chunk->bounds);
+        RecordCullResult(CULL_TERRAIN, visible);
+        if (!visible) continue;
+
+        Mesh mesh = terrainLodMeshes[chunk->lodLevel][chunk->edgeMask];
+        DrawMesh(mesh, terrainMaterial, MatrixTranslate(chunk->worldPos.x, chunk->worldPos.y, chunk->worldPos.z));
+        terrainTrianglesDrawn += mesh.triangleCount;
+        terrainVerticesDrawn += mesh.vertexCount;
+    }
+}
+
+// Cache the world bounds of every loaded building, call again if a building is moved or replaced
+void UpdateBuildingBounds(void) {
+    for (int i = 0; i < MAX_BUILDINGS; i++) {
+        if (buildings[i].scale == 0.0f) continue; // Unused slot, a model that failed to load still gets its position
+        buildings[i].bounds = GetModelWorldBounds(buildings[i].model, buildings[i].position, buildings[i].rotationAngle, buildings[i].scale);
+    }
+}
+
+// Check if a building is drawn: the FarmHouse appears once purchased and replaces the constructionHouse
+bool IsBuildingShown(int i) {
+    if (buildings[i].scale == 0.0f) return false; // Unused slot (empty models simply draw nothing)
+    return !((i == 4 && !purchasedFarmhouse) || (i == 3 && purchasedFarmhouse));
+}
+
+// Get the static material drawing a building mesh, registered on first use (-1 when the table is full).
+// Materials with the same shader, diffuse texture and diffuse color share a batch.
+int GetStaticMaterialIndex(Model model, int mesh) {
+    Material material = model.materials[model.meshMaterial[mesh]];
+    MaterialMap diffuse = material.maps[MATERIAL_MAP_DIFFUSE];
+
+    for (int k = 0; k < staticMaterialCount; k++) {
+        MaterialMap other = staticMaterials[k].maps[MATERIAL_MAP_DIFFUSE];
+        if ((staticMaterials[k].shader.id == material.shader.id) && (other.texture.id == diffuse.texture.id) &&
+            ColorIsEqual(other.color, diffuse.color)) return k;
+    }
+
+    if (staticMaterialCount == MAX_STATIC_MATERIALS) return -1;
+    staticMaterials[staticMaterialCount] = material;
+    return staticMaterialCount++;
+}
+
+// Get the model to world transform of a building, the one DrawModelEx() builds
+Matrix GetBuildingTransform(const Building *building) {
+    Matrix scale = MatrixScale(building->scale, building->scale, building->scale);
+    Matrix rotation = MatrixRotate((Vector3){ 0.0f, 1.0f, 0.0f }, building->rotationAngle*DEG2RAD);
+    Matrix translation = MatrixTranslate(building->position.x, building->position.y, building->position.z);
+    return MatrixMultiply(building->model.transform, MatrixMultiply(MatrixMultiply(scale, rotation), translation));
+}
+
+// Get the number of indices a mesh is drawn with (unindexed meshes draw their vertices in order)
+int GetStaticMeshIndexCount(const Mesh *mesh) {
+    return (mesh->indices != NULL) ? mesh->triangleCount*3 : mesh->vertexCount;
+}
+
+// Append a building mesh in world space to a merged mesh, missing attributes get raylib's defaults
+void AppendStaticMesh(Mesh *merged, int *vertexOffset, int *indexOffset, const Mesh *mesh, Matrix transform) {
+    Matrix normalMatrix = MatrixTranspose(MatrixInvert(transform));
+    normalMatrix.m12 = normalMatrix.m13 = normalMatrix.m14 = 0.0f;  // Directions don't translate
+    int base = *vertexOffset;
+
+    for (int v = 0; v < mesh->vertexCount; v++) {
+        Vector3 position = Vector3Transform((Vector3){ mesh->vertices[v*3], mesh->vertices[v*3 + 1], mesh->vertices[v*3 + 2] }, transform);
+        Vector3 normal = { 0 };
+        if (mesh->normals != NULL) {
+            normal = Vector3Normalize(Vector3Transform((Vector3){ mesh->normals[v*3], mesh->normals[v*3 + 1], mesh->normals[v*3 + 2] }, normalMatrix));
+        }
+
+        int o = base + v;
+        merged->vertices[o*3] = position.x;
+        merged->vertices[o*3 + 1] = position.y;
+        merged->vertices[o*3 + 2] = position.z;
+        merged->normals[o*3] = normal.x;
+        merged->normals[o*3 + 1] = normal.y;
+        merged->normals[o*3 + 2] = normal.z;
+        merged->texcoords[o*2] = (mesh->texcoords != NULL) ? mesh->texcoords[v*2] : 0.0f;
+        merged->texcoords[o*2 + 1] = (mesh->texcoords != NULL) ? mesh->texcoords[v*2 + 1] : 0.0f;
+        for (int c = 0; c < 4; c++) merged->colors[o*4 + c] = (mesh->colors != NULL) ? mesh->colors[v*4 + c] : 255;
+    }
+
+    int indexCount = GetStaticMeshIndexCount(mesh);
+    for (int k = 0; k < indexCount; k++) {
+        merged->indices[*indexOffset + k] = (unsigned short)(base + ((mesh->indices != NULL) ? mesh->indices[k] : k));
+    }
+
+    *vertexOffset += mesh->vertexCount;
+    *indexOffset += indexCount;
+}
+
+// Get the mesh of a building piece at a level (clamped to the levels its building has)
+const Mesh *GetStaticPieceMesh(StaticPiece piece, int level) {
+    const Building *building = &buildings[piece.building];
+    return GetModelLod(building->model, building->lods, level).meshes + piece.mesh;
+}
+
+// Merge building pieces at a level into one uploaded world space mesh
+Mesh MergeStaticPieces(const StaticPiece *pieces, int count, int level) {
+    int vertexCount = 0;
+    int indexCount = 0;
+    for (int p = 0; p < count; p++) {
+        const Mesh *mesh = GetStaticPieceMesh(pieces[p], level);
+        vertexCount += mesh->vertexCount;
+        indexCount += GetStaticMeshIndexCount(mesh);
+    }
+
+    Mesh merged = { 0 };
+    merged.vertexCount = vertexCount;
+    merged.triangleCount = indexCount/3;
+    merged.vertices = (float *)MemAlloc(vertexCount*3*sizeof(float));
+    merged.normals = (float *)MemAlloc(vertexCount*3*sizeof(float));
+    merged.texcoords = (float *)MemAlloc(vertexCount*2*sizeof(float));
+    merged.colors = (unsigned char *)MemAlloc(vertexCount*4*sizeof(unsigned char));
+    merged.indices = (unsigned short *)MemAlloc(indexCount*sizeof(unsigned short));
+
+    int vertexOffset = 0;
+    int indexOffset = 0;
+    for (int p = 0; p < count; p++) {
+        AppendStaticMesh(&merged, &vertexOffset, &indexOffset, GetStaticPieceMesh(pieces[p], level), GetBuildingTransform(&buildings[pieces[p].building]));
+    }
+
+    UploadMesh(&merged, false);
+    return merged;
+}
+
+// Unload every level of a batch
+void UnloadStaticBatch(StaticBatch *batch) {
+    for (int level = 0; level < batch->levelCount; level++) UnloadMesh(batch->levels[level]);
+    batch->levelCount = 0;
+}
+
+// Merge the meshes of the shown buildings drawn with one static material into batches,
+// replacing the batches the material had
+void BuildStaticMaterialBatches(int materialIndex) {
+    int kept = 0;
+    for (int b = 0; b < staticBatchCount; b++) {
+        if (staticBatches[b].materialIndex == materialIndex) UnloadStaticBatch(&staticBatches[b]);
+        else staticBatches[kept++] = staticBatches[b];
+    }
+    staticBatchCount = kept;
+
+    kept = 0;
+    for (int p = 0; p < staticLoosePieceCount; p++) {
+        if (staticLoosePieces[p].materialIndex != materialIndex) staticLoosePieces[kept++] = staticLoosePieces[p];
+    }
+    staticLoosePieceCount = kept;
+
+    // Meshes of the material in building order
+    int pieceCount = 0;
+    for (int i = 0; i < MAX_BUILDINGS; i++) {
+        if (!IsBuildingShown(i)) continue;
+        for (int m = 0; m < buildings[i].model.meshCount; m++) {
+            if (GetStaticMaterialIndex(buildings[i].model, m) == materialIndex) pieceCount++;
+        }
+    }
+    if (pieceCount == 0) return;
+
+    StaticPiece *pieces = (StaticPiece *)MemAlloc(pieceCount*sizeof(StaticPiece));
+    pieceCount = 0;
+    for (int i = 0; i < MAX_BUILDINGS; i++) {
+        if (!IsBuildingShown(i)) continue;
+        for (int m = 0; m < buildings[i].model.meshCount; m++) {
+            if (GetStaticMaterialIndex(buildings[i].model, m) != materialIndex) continue;
+
+            // Its own vertices would already overflow the 16-bit indices of a batch
+            StaticPiece piece = { i, m };
+            int vertexCount = GetStaticPieceMesh(piece, 0)->vertexCount;
+            if (vertexCount <= STATIC_BATCH_MAX_VERTICES) pieces[pieceCount++] = piece;
+            else if (staticLoosePieceCount < MAX_STATIC_LOOSE_PIECES) {
+                TraceLog(LOG_INFO, "STATIC: Building %d mesh %d has %d vertices, drawn unbatched", i, m, vertexCount);
+                staticLoosePieces[staticLoosePieceCount++] = (StaticLoosePiece){ piece, materialIndex };
+            }
+            else TraceLog(LOG_WARNING, "STATIC: Unbatched mesh limit reached, building %d mesh %d is not drawn", i, m);
         }
     }
+
+    for (int first = 0; first < pieceCount;) {
+        // Take meshes while their vertices fit the 16-bit indices (the simplified levels have fewer),
+        // every piece fits on its own so a batch always takes at least one
+        int vertexCount = 0;
+        int last = first;
+        while (last < pieceCount) {
+            const Mesh *mesh = GetStaticPieceMesh(pieces[last], 0);
+            if ((last > first) && (vertexCount + mesh->vertexCount > STATIC_BATCH_MAX_VERTICES)) break;
+            vertexCount += mesh->vertexCount;
+            last++;
+        }
+
+        if (staticBatchCount == MAX_STATIC_BATCHES) {
+            TraceLog(LOG_WARNING, "STATIC: Batch limit reached, some buildings are not drawn");
+            break;
+        }
+
+        StaticBatch *batch = &staticBatches[staticBatchCount++];
+        *batch = (StaticBatch){ 0 };
+        batch->materialIndex = materialIndex;
+        batch->levelCount = 1;
+        for (int p = first; p < last; p++) {
+            const Building *building = &buildings[pieces[p].building];
+            if (building->lods == NULL) continue;
+            if (building->lods->levelCount > batch->levelCount) batch->levelCount = building->lods->levelCount;
+            batch->pieceRadius = fmaxf(batch->pieceRadius, building->lods->radius*building->scale);
+        }
+
+        for (int level = 0; level < batch->levelCount; level++) batch->levels[level] = MergeStaticPieces(pieces + first, last - first, level);
+        batch->bounds = GetMeshBoundingBox(batch->levels[0]);
+        first = last;
+    }
+
+    MemFree(pieces);
+}
+
+// Merge every shown building into static batches, call once the buildings are placed
+void BuildStaticWorld(void) {
+    // Register the materials of every building first, hidden ones included, so a later
+    // visibility swap only rebuilds the batches of its own materials
+    staticMaterialCount = 0;
+    for (int i = 0; i < MAX_BUILDINGS; i++) {
+        for (int m = 0; m < buildings[i].model.meshCount; m++) GetStaticMaterialIndex(buildings[i].model, m);
+    }
+
+    for (int k = 0; k < staticMaterialCount; k++) BuildStaticMaterialBatches(k);
+    for (int i = 0; i < MAX_BUILDINGS; i++) staticBuildingShown[i] = IsBuildingShown(i);
+    staticWorldBuilt = true;
+
+    int vertexCount = 0;
+    for (int b = 0; b < staticBatchCount; b++) vertexCount += staticBatches[b].levels[0].vertexCount;
+    TraceLog(LOG_INFO, "STATIC: Buildings merged into %d batches (%d materials, %d vertices), %d meshes unbatched", staticBatchCount, staticMaterialCount,
+             vertexCount, staticLoosePieceCount);
+}
+
+// Rebuild the batches of the materials of buildings that were shown or hidden since the last build
+void UpdateStaticWorld(void) {
+    bool dirty[MAX_STATIC_MATERIALS] = { 0 };
+    bool changed = false;
+
+    for (int i = 0; i < MAX_BUILDINGS; i++) {
+        bool shown = IsBuildingShown(i);
+        if (shown == staticBuildingShown[i]) continue;
+        staticBuildingShown[i] = shown;
+        for (int m = 0; m < buildings[i].model.meshCount; m++) {
+            int k = GetStaticMaterialIndex(buildings[i].model, m);
+            if (k >= 0) dirty[k] = changed = true;
+        }
+    }
+    if (!changed) return;
+
+    for (int k = 0; k < staticMaterialCount; k++) {
+        if (dirty[k]) BuildStaticMaterialBatches(k);
+    }
+    TraceLog(LOG_INFO, "STATIC: Building visibility changed, %d batches now", staticBatchCount);
+}
+
+// Draw the shown buildings, merged batches when built, else one DrawModelEx per building.
+// Both pick the simplified level for the size on screen.
+void DrawStaticWorld(Camera camera, const Frustum *frustum) {
+    if (!staticWorldBuilt) {
+        for (int i = 0; i < MAX_BUILDINGS; i++) {
+            if (!IsBuildingShown(i)) continue;
+            bool visible = IsBoxInFogRange(buildings[i].bounds) && FrustumContainsBox(frustum, buildings[i].bounds);
+            RecordCullResult(CULL_BUILDINGS, visible);
+            if (!visible) continue;
+
+            int level = GetModelLodLevel(buildings[i].lods, buildings[i].position, buildings[i].scale, camera);
+            RecordModelLodDraw(buildings[i].lods, level, 1);
+            DrawModelEx(GetModelLod(buildings[i].model, buildings[i].lods, level), buildings[i].position, (Vector3){0.0f, 1.0f, 0.0f}, buildings[i].rotationAngle, (Vector3){buildings[i].scale, buildings[i].scale, buildings[i].scale}, WHITE);
+        }
+        return;
+    }
+
+    UpdateStaticWorld();
+    for (int b = 0; b < staticBatchCount; b++) {
+        StaticBatch *batch = &staticBatches[b];
+        bool visible = IsBoxInFogRange(batch->bounds) && FrustumContainsBox(frustum, batch->bounds);
+        RecordCullResult(CULL_BUILDINGS, visible);
+        if (!visible) continue;
+
+        // The nearest point of the merged bounds is at most as far as the nearest building
+        Vector3 nearest = Vector3Clamp(camera.position, batch->bounds.min, batch->bounds.max);
+        int level = GetLodLevel(batch->levelCount, batch->pieceRadius, Vector3Distance(camera.position, nearest), camera.fovy);
+        RecordLodDraw(level, 1, batch->levels[level].triangleCount, batch->levels[0].triangleCount);
+        DrawMesh(batch->levels[level], staticMaterials[batch->materialIndex], MatrixIdentity());
+    }
+
+    for (int p = 0; p < staticLoosePieceCount; p++) {
+        const StaticLoosePiece *loose = &staticLoosePieces[p];
+        const Building *building = &buildings[loose->piece.building];
+        bool visible = IsBoxInFogRange(building->bounds) && FrustumContainsBox(frustum, building->bounds);
+        RecordCullResult(CULL_BUILDINGS, visible);
+        if (!visible) continue;
+
+        int level = GetModelLodLevel(building->lods, building->position, building->scale, camera);
+        RecordModelLodDraw(building->lods, level, 1);
+        DrawMesh(*GetStaticPieceMesh(loose->piece, level), staticMaterials[loose->materialIndex], GetBuildingTransform(building));
+    }
+}
+
+// Unload the merged batches (the materials belong to the building models)
+void UnloadStaticWorld(void) {
+    for (int b = 0; b < staticBatchCount; b++) UnloadStaticBatch(&staticBatches[b]);
+    staticBatchCount = 0;
+    staticLoosePieceCount = 0;
+    staticMaterialCount = 0;
+    staticWorldBuilt = false;
 }
 
 // ...rest of the code...
 
 // Function to check if the player is colliding with an animal
-bool IsCollisionWithAnimal(Vector3 playerPosition, float playerRadius, int* animalIndex) {
+bool IsCollisionWithAnimal(Vector3 playerPosition, float playerRadius, int* animalId) {
     // First check if we're in the bank area or on the road to the bank
     if (IsNearBankOrOnRoadToBank(playerPosition)) {
-        if (animalIndex != NULL) *animalIndex = -1;
+        if (animalId != NULL) *animalId = -1;
         return false; // No collision in bank area
     }
     
-    for (int i = 0; i < animalCount; i++) {
-        if (!animals[i].active) continue;
+    // Only the animals in the cells around the player
+    int buffer[COLLISION_QUERY_IDS];
+    int *candidates = NULL;
+    int candidateCount = QueryCollisionGrid(&animalGrid, playerPosition, playerRadius + MAX_ANIMAL_COLLISION_RADIUS, buffer, COLLISION_QUERY_IDS, &candidates);
+    bool collided = false;
+    for (int c = 0; (c < candidateCount) && !collided; c++) {
+        int id = candidates[c];
         
         // Calculate distance between player and animal
-        float distance = Vector3Distance(playerPosition, animals[i].position);
+        float distance = Vector3Distance(playerPosition, GetAnimalPosition(id));
         
         // Use a collision radius based on the animal type for more accurate collision
         float animalRadius;
-        switch(animals[i].type) {
+        switch(GetAnimalType(id)) {
             case ANIMAL_HORSE:
                 animalRadius = 1.8f; // Reduced from 2.5f to 1.8f for easier navigation
                 break;
@@ -1698,43 +2971,66 @@ bool IsCollisionWithAnimal(Vector3 playerPosition, float playerRadius, int* anim
                 animalRadius = 0.8f; // Small collision for chicken
                 break;
             default:
-                animalRadius = animals[i].scale * 1.5f; // Fallback
+                animalRadius = 1.5f; // Not a species, no herd to read the scale from
         }
         
         // Check for collision
         if (distance < (playerRadius + animalRadius)) {
-            if (animalIndex != NULL) *animalIndex = i;
-            return true;
+            if (animalId != NULL) *animalId = id;
+            collided = true;
         }
     }
+    if (candidates != buffer) MemFree(candidates);
     
-    return false;
+    return collided;
+}
+
+// Build the sky dome and its gradient shader, the dome stays loaded for the whole run
+void InitSky(void) {
+    skyShader = LoadShader(TextFormat("shaders/glsl%i/sky.vs", GLSL_VERSION),
+                           TextFormat("shaders/glsl%i/sky.fs", GLSL_VERSION));
+    int zenithLoc = GetShaderLocation(skyShader, "zenithColor");
+    if ((skyShader.id == rlGetShaderIdDefault()) || (zenithLoc == -1)) {
+        TraceLog(LOG_WARNING, "Sky shader unavailable, the sky is a flat background color");
+        return;
+    }
+
+    Vector4 zenith = ColorNormalize(SKY_ZENITH_COLOR);
+    Vector4 horizon = ColorNormalize(SKY_HORIZON_COLOR);
+    Vector4 ground = ColorNormalize(SKY_GROUND_COLOR);
+    SetShaderValue(skyShader, zenithLoc, &zenith, SHADER_UNIFORM_VEC3);
+    SetShaderValue(skyShader, GetShaderLocation(skyShader, "horizonColor"), &horizon, SHADER_UNIFORM_VEC3);
+    SetShaderValue(skyShader, GetShaderLocation(skyShader, "groundColor"), &ground, SHADER_UNIFORM_VEC3);
+
+    skyDomeMesh = GenMeshSphere(SKY_DOME_RADIUS, 16, 32);
+    skyMaterial = LoadMaterialDefault();
+    skyMaterial.shader = skyShader;
+    skyEnabled = true;
 }
 
-// Draw a realistic sky: flat dome + hemisphere
-void DrawRealisticSky(Vector3 center, Texture2D skyTexture) {
-    // Parameters for the sky
-    float flatRadius = 200.0f; // Radius of the flat part
-    float flatHeight = 80.0f;  // Height above ground for the flat part
-    float hemiRadius = 200.0f; // Radius of the hemisphere
-    float hemiHeight = flatHeight; // Hemisphere starts at the edge of the flat part
-
-    // Draw flat disc (sky dome)
-    Mesh flatMesh = GenMeshCylinder(flatRadius, 0.1f, 64);
-    Model flatModel = LoadModelFromMesh(flatMesh);
-    flatModel.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = skyTexture;
-    SetMaterialTexture(&flatModel.materials[0], MATERIAL_MAP_DIFFUSE, skyTexture);
-    DrawModelEx(flatModel, (Vector3){center.x, center.y + flatHeight, center.z}, (Vector3){1,0,0}, 0, (Vector3){1,1,1}, WHITE);
-    UnloadModel(flatModel);
-
-    // Draw hemisphere (connects flat sky to ground)
-    Mesh hemiMesh = GenMeshHemiSphere(hemiRadius, 64, 32);
-    Model hemiModel = LoadModelFromMesh(hemiMesh);
-    hemiModel.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = skyTexture;
-    SetMaterialTexture(&hemiModel.materials[0], MATERIAL_MAP_DIFFUSE, skyTexture);
-    // Position hemisphere so its base aligns with the flat disc
-    DrawModelEx(hemiModel, (Vector3){center.x, center.y + hemiHeight, center.z}, (Vector3){1,0,0}, 0, (Vector3){1,1,1}, WHITE);
-    UnloadModel(hemiModel);
+// Draw the sky dome around the camera, first in the frame: no depth writes, so everything drawn
+// later covers it, and no face culling since the dome is seen from inside
+void DrawSky(Camera camera) {
+    if (!skyEnabled) return;
+
+    rlDisableDepthMask();
+    rlDisableBackfaceCulling();
+    DrawMesh(skyDomeMesh, skyMaterial, MatrixTranslate(camera.position.x, camera.position.y, camera.position.z));
+    rlEnableBackfaceCulling();
+    rlEnableDepthMask();
+}
+
+// Unload the sky dome and its shader
+void UnloadSky(void) {
+    if (!skyEnabled) {
+        if (skyShader.id != rlGetShaderIdDefault()) UnloadShader(skyShader);
+        return;
+    }
+
+    UnloadMesh(skyDomeMesh);
+    MemFree(skyMaterial.maps);  // The default material maps are ours, the texture is raylib's default
+    UnloadShader(skyShader);
+    skyEnabled = false;
 }
 
 // Initialize clouds for a Minecraft-style sky
@@ -1754,7 +3050,7 @@ void InitClouds(float terrainSize) {
     
     // Calculate how many clouds to place in each part of the sky
     int cloudGridSize = 16;  // 16x16 grid for cloud placement
-    int cloudsPerCell = MAX_CLOUDS / (cloudGridSize * cloudGridSize);
+    int cloudsPerCell = cloudCount / (cloudGridSize * cloudGridSize);
     
     int cloudIndex = 0;
     
@@ -1767,7 +3063,7 @@ void InitClouds(float terrainSize) {
             
             // Place multiple clouds in each grid cell with some randomness
             for (int i = 0; i < cloudsPerCell; i++) {
-                if (cloudIndex >= MAX_CLOUDS) break;
+                if (cloudIndex >= cloudCount) break;
                 
                 // Add randomness within each grid cell
                 float offsetX = GetRandomValue(-100, 100) / 200.0f; // -0.5 to 0.5
@@ -1806,7 +3102,7 @@ void InitClouds(float terrainSize) {
     }
     
     // Add some extra clouds to fill any remaining gaps
-    int extraCloudCount = MAX_CLOUDS - cloudIndex;
+    int extraCloudCount = cloudCount - cloudIndex;
     if (extraCloudCount > 0) {
         // Add remaining clouds with a focus on filling gaps
         for (int i = 0; i < extraCloudCount; i++) {
@@ -1827,46 +3123,210 @@ void InitClouds(float terrainSize) {
  }
 }
 
-// Draw all clouds in the sky - Static Minecraft style
-void DrawClouds(Camera camera) {
-    for (int i = 0; i < MAX_CLOUDS; i++) {
-        // Calculate distance from camera to cloud
-        float distance = Vector3Distance(camera.position, clouds[i].position);
-        
-        // Skip clouds that are too far away
-        if (distance > CLOUD_VIEW_DISTANCE) continue;
-        
-        // Draw flat rectangular clouds (Minecraft style)
-        DrawCube(clouds[i].position, clouds[i].scale, clouds[i].scale * 0.2f, clouds[i].scale, WHITE);
-        
-        // Draw additional blocks for larger cloud shapes (2x2 or 3x3 patterns)
-        if (i % 3 == 0) { // Every third cloud gets a more complex shape
-            // Add 2-4 adjacent blocks to create a larger cloud formation
-            for (int bx = -1; bx <= 1; bx++) {
-                for (int bz = -1; bz <= 1; bz++) {
-                    // Skip center block (already drawn above)
-                    if (bx == 0 && bz == 0) continue;
-                    
-                    // Skip some blocks randomly for more varied shapes
-                    if (abs(bx) + abs(bz) > 1 && (i % 5 > 2)) continue;
-                    
-                    // Draw additional cloud blocks at fixed positions
-                    Vector3 blockPos = clouds[i].position;
-                                                                             blockPos.x += bx * clouds[i].scale * 0.9f;
-                    blockPos.z += bz * clouds[i].scale * 0.9f;
-                    blockPos.y += (i % 3 - 1) * 0.1f * clouds[i].scale; // Small fixed height variation
-                    
-                    DrawCube(blockPos, 
-                            clouds[i].scale * 0.95f, 
-                            clouds[i].scale * 0.18f, 
-                            clouds[i].scale * 0.95f, 
-                            WHITE);
+// Get the boxes that make up a cloud (a flat block, larger clouds get adjacent blocks).
+// Returns the number of boxes written, at most 9.
+int GetCloudBoxes(int i, Vector3 *centers, Vector3 *sizes) {
+    int count = 0;
+
+    // Flat rectangular cloud (Minecraft style)
+    centers[count] = clouds[i].position;
+    sizes[count] = (Vector3){ clouds[i].scale, clouds[i].scale*0.2f, clouds[i].scale };
+    count++;
+
+    // Additional blocks for larger cloud shapes (2x2 or 3x3 patterns)
+    if (i % 3 == 0) { // Every third cloud gets a more complex shape
+        for (int bx = -1; bx <= 1; bx++) {
+            for (int bz = -1; bz <= 1; bz++) {
+                // Skip center block (already added above)
+                if (bx == 0 && bz == 0) continue;
+
+                // Skip some blocks for more varied shapes
+                if (abs(bx) + abs(bz) > 1 && (i % 5 > 2)) continue;
+
+                Vector3 blockPos = clouds[i].position;
+                blockPos.x += bx*clouds[i].scale*0.9f;
+                blockPos.z += bz*clouds[i].scale*0.9f;
+                blockPos.y += (i % 3 - 1)*0.1f*clouds[i].scale; // Small fixed height variation
+
+                centers[count] = blockPos;
+                sizes[count] = (Vector3){ clouds[i].scale*0.95f, clouds[i].scale*0.18f, clouds[i].scale*0.95f };
+                count++;
+            }
+        }
+    }
+
+    return count;
+}
+
+// Upload a finished cloud chunk mesh and store its bounds.
+// Chunks are filled into room for CLOUD_CHUNK_MAX_BOXES boxes, the arrays are shrunk to the boxes
+// they hold first (UploadMesh() keeps the CPU copies).
+void FinishCloudChunk(CloudChunk *chunk, int boxCount) {
+    chunk->mesh.vertices = (float *)MemRealloc(chunk->mesh.vertices, boxCount*8*3*sizeof(float));
+    chunk->mesh.indices = (unsigned short *)MemRealloc(chunk->mesh.indices, boxCount*36*sizeof(unsigned short));
+    chunk->mesh.vertexCount = boxCount*8;
+    chunk->mesh.triangleCount = boxCount*12;
+    UploadMesh(&chunk->mesh, false);
+    chunk->bounds = GetMeshBoundingBox(chunk->mesh);
+    chunk->center = Vector3Scale(Vector3Add(chunk->bounds.min, chunk->bounds.max), 0.5f);
+}
+
+// Bake the cloud field into static meshes, one per CLOUD_CHUNK_SIZE grid cell
+// (cells with more than CLOUD_CHUNK_MAX_BOXES boxes are split into several chunks)
+void BuildCloudChunks(void) {
+    static const float cornerSigns[8][3] = {
+        { -1, -1, -1 }, { 1, -1, -1 }, { 1, 1, -1 }, { -1, 1, -1 },
+        { -1, -1, 1 }, { 1, -1, 1 }, { 1, 1, 1 }, { -1, 1, 1 }
+    };
+    static const unsigned short boxIndices[36] = {
+        0, 2, 1, 0, 3, 2,   // Back
+        4, 5, 6, 4, 6, 7,   // Front
+        0, 4, 7, 0, 7, 3,   // Left
+        1, 2, 6, 1, 6, 5,   // Right
+        3, 7, 6, 3, 6, 2,   // Top
+        0, 1, 5, 0, 5, 4    // Bottom
+    };
+
+    cloudChunks = NULL;
+    cloudChunkCount = 0;
+    if (cloudCount == 0) return; // "clouds 0" scenarios have an empty sky
+
+    // Grid covering every cloud center
+    float minX = clouds[0].position.x, maxX = minX;
+    float minZ = clouds[0].position.z, maxZ = minZ;
+    for (int i = 1; i < cloudCount; i++) {
+        minX = fminf(minX, clouds[i].position.x); maxX = fmaxf(maxX, clouds[i].position.x);
+        minZ = fminf(minZ, clouds[i].position.z); maxZ = fmaxf(maxZ, clouds[i].position.z);
+    }
+    int gridX = (int)((maxX - minX)/CLOUD_CHUNK_SIZE) + 1;
+    int gridZ = (int)((maxZ - minZ)/CLOUD_CHUNK_SIZE) + 1;
+    cloudFieldOrigin = (Vector2){ minX, minZ };
+    cloudFieldSize = (Vector2){ gridX*CLOUD_CHUNK_SIZE, gridZ*CLOUD_CHUNK_SIZE };
+
+    // Bucket clouds by grid cell (counting sort keeps the cloud order inside a cell)
+    int cellCount = gridX*gridZ;
+    int *cellStart = (int *)MemAlloc((cellCount + 1)*sizeof(int));
+    int *cellOfCloud = (int *)MemAlloc(cloudCount*sizeof(int));
+    int *sortedClouds = (int *)MemAlloc(cloudCount*sizeof(int));
+    for (int i = 0; i < cloudCount; i++) {
+        int cx = (int)((clouds[i].position.x - minX)/CLOUD_CHUNK_SIZE);
+        int cz = (int)((clouds[i].position.z - minZ)/CLOUD_CHUNK_SIZE);
+        cellOfCloud[i] = cz*gridX + cx;
+        cellStart[cellOfCloud[i] + 1]++;
+    }
+    for (int c = 0; c < cellCount; c++) cellStart[c + 1] += cellStart[c];
+    int *cellFill = (int *)MemAlloc(cellCount*sizeof(int));
+    for (int i = 0; i < cloudCount; i++) sortedClouds[cellStart[cellOfCloud[i]] + cellFill[cellOfCloud[i]]++] = i;
+
+    // Worst case every cell is split once per CLOUD_CHUNK_MAX_BOXES boxes
+    int maxChunks = cellCount + (cloudCount*9)/CLOUD_CHUNK_MAX_BOXES + 1;
+    cloudChunks = (CloudChunk *)MemAlloc(maxChunks*sizeof(CloudChunk));
+    cloudChunkCount = 0;
+
+    int totalBoxes = 0;
+    for (int c = 0; c < cellCount; c++) {
+        CloudChunk *chunk = NULL;
+        int boxCount = 0;
+
+        for (int k = cellStart[c]; k < cellStart[c + 1]; k++) {
+            Vector3 centers[9], sizes[9];
+            int count = GetCloudBoxes(sortedClouds[k], centers, sizes);
+
+            for (int b = 0; b < count; b++) {
+                if (chunk == NULL || boxCount == CLOUD_CHUNK_MAX_BOXES) {
+                    if (chunk != NULL) FinishCloudChunk(chunk, boxCount);
+                    chunk = &cloudChunks[cloudChunkCount++];
+                    chunk->mesh.vertices = (float *)MemAlloc(CLOUD_CHUNK_MAX_BOXES*8*3*sizeof(float));
+                    chunk->mesh.indices = (unsigned short *)MemAlloc(CLOUD_CHUNK_MAX_BOXES*36*sizeof(unsigned short));
+                    boxCount = 0;
+                }
+
+                float *vertices = &chunk->mesh.vertices[boxCount*8*3];
+                for (int v = 0; v < 8; v++) {
+                    vertices[v*3 + 0] = centers[b].x + cornerSigns[v][0]*sizes[b].x*0.5f;
+                    vertices[v*3 + 1] = centers[b].y + cornerSigns[v][1]*sizes[b].y*0.5f;
+                    vertices[v*3 + 2] = centers[b].z + cornerSigns[v][2]*sizes[b].z*0.5f;
                 }
+                unsigned short *indices = &chunk->mesh.indices[boxCount*36];
+                for (int n = 0; n < 36; n++) indices[n] = (unsigned short)(boxCount*8 + boxIndices[n]);
+
+                boxCount++;
+                totalBoxes++;
             }
         }
+
+        if (chunk != NULL) FinishCloudChunk(chunk, boxCount);
+    }
+
+    MemFree(cellStart);
+    MemFree(cellOfCloud);
+    MemFree(sortedClouds);
+    MemFree(cellFill);
+
+    TraceLog(LOG_INFO, "Clouds baked: %d boxes in %d chunks (%dx%d grid)", totalBoxes, cloudChunkCount, gridX, gridZ);
+}
+
+// Load the cloud shader and bake the cloud meshes
+void InitCloudRenderer(void) {
+    cloudShader = LoadShader(TextFormat("shaders/glsl%i/clouds.vs", GLSL_VERSION),
+                             TextFormat("shaders/glsl%i/clouds.fs", GLSL_VERSION));
+    cloudWindOffsetLoc = GetShaderLocation(cloudShader, "windOffset");
+    if (cloudWindOffsetLoc == -1) TraceLog(LOG_WARNING, "Cloud shader unavailable, clouds will not drift");
+
+    cloudMaterial = LoadMaterialDefault();
+    cloudMaterial.shader = cloudShader;
+    cloudMaterial.maps[MATERIAL_MAP_DIFFUSE].color = WHITE;
+
+    BuildCloudChunks();
+}
+
+// Draw the baked cloud chunks, each culled as a unit by view distance and frustum
+void DrawClouds(Camera camera, const Frustum *frustum) {
+    // Wind drift, each chunk wraps around the cloud field so the sky never empties
+    float drift = (float)(worldTime + simulationAlpha*SIMULATION_TIMESTEP)*CLOUD_WIND_SPEED;
+    Vector3 windDirection = { 0.96f, 0.0f, 0.28f };
+
+    for (int i = 0; i < cloudChunkCount; i++) {
+        CloudChunk *chunk = &cloudChunks[i];
+
+        float wrappedX = fmodf(chunk->center.x - cloudFieldOrigin.x + drift*windDirection.x, cloudFieldSize.x);
+        float wrappedZ = fmodf(chunk->center.z - cloudFieldOrigin.y + drift*windDirection.z, cloudFieldSize.y);
+        if (wrappedX < 0.0f) wrappedX += cloudFieldSize.x;
+        if (wrappedZ < 0.0f) wrappedZ += cloudFieldSize.y;
+        Vector3 offset = { cloudFieldOrigin.x + wrappedX - chunk->center.x, 0.0f,
+                           cloudFieldOrigin.y + wrappedZ - chunk->center.z };
+
+        BoundingBox bounds = { Vector3Add(chunk->bounds.min, offset), Vector3Add(chunk->bounds.max, offset) };
+
+        // Skip chunks whose closest point is beyond the cloud view distance
+        Vector3 closest = Vector3Clamp(camera.position, bounds.min, bounds.max);
+        bool visible = (Vector3DistanceSqr(camera.position, closest) <= CLOUD_VIEW_DISTANCE*CLOUD_VIEW_DISTANCE) &&
+                       FrustumContainsBox(frustum, bounds);
+        RecordCullResult(CULL_CLOUDS, visible);
+        if (!visible) continue;
+
+        if (cloudWindOffsetLoc != -1) {
+            SetShaderValue(cloudShader, cloudWindOffsetLoc, &offset, SHADER_UNIFORM_VEC3);
+            DrawMesh(chunk->mesh, cloudMaterial, MatrixIdentity());
+        } else {
+            DrawMesh(chunk->mesh, cloudMaterial, MatrixTranslate(offset.x, offset.y, offset.z));
+        }
     }
 }
 
+// Unload the baked cloud chunks and the cloud shader
+void UnloadClouds(void) {
+    for (int i = 0; i < cloudChunkCount; i++) UnloadMesh(cloudChunks[i].mesh);
+    if (cloudChunks != NULL) MemFree(cloudChunks);
+    cloudChunks = NULL;
+    cloudChunkCount = 0;
+
+    // The material maps are ours, the shader is unloaded separately (may be the default one)
+    MemFree(cloudMaterial.maps);
+    if (cloudShader.id != rlGetShaderIdDefault()) UnloadShader(cloudShader);
+    UnloadTexture(cloudTextures[0]); // All cloud types share the same texture
+}
+
 // Sound-related constants
 #define MAX_SOUND_DISTANCE 30.0f  // Maximum distance at which sounds can be heard
 #define MIN_SOUND_INTERVAL 9.5f   // Minimum time between sounds (in seconds)
@@ -1882,82 +3342,102 @@ typedef struct {
     Sound sound;
     float nextSoundTime;
     float soundInterval;
+    float dueVolume;     // Volume to play at this frame, negative when not due (set by ScheduleAnimalSounds)
 } AnimalSound;
 
-// Function to load animal sounds
-void LoadAnimalSounds(void) {
-    // Initialize audio device
-    InitAudioDevice();
-    
-    // Load sounds for each animal type
-    for (int i = 0; i < animalCount; i++) {
-        if (!animals[i].active) continue;
-        
-        AnimalSound* animalSound = (AnimalSound*)MemAlloc(sizeof(AnimalSound));
-        if (animalSound == NULL) {
-            TraceLog(LOG_ERROR, "Failed to allocate memory for animal sound");
-            continue;
-        }
-        
-        // Load appropriate sound based on animal type
-        switch(animals[i].type) {
-            case ANIMAL_HORSE:
-                animalSound->sound = LoadSound("sounds/horse.mp3");
-                break;
-            case ANIMAL_CAT:
-                animalSound->sound = LoadSound("sounds/cat.mp3");
-                break;
-            case ANIMAL_DOG:
-                animalSound->sound = LoadSound("sounds/dog.mp3");
-                break;
-            case ANIMAL_COW:
-                animalSound->sound = LoadSound("sounds/cow.mp3");
-                break;
-            case ANIMAL_PIG:
-                animalSound->sound = LoadSound("sounds/pig.mp3");
-                break;
+#define ANIMAL_SOUND_BATCH_SIZE 1024  // Animals per sound scheduling job
 
-            case ANIMAL_CHICKEN:
-                animalSound->sound = LoadSound("sounds/chicken.mp3");
-                break;
-             
-            default:
-                animalSound->sound = (Sound){0};
-                break;
-        }
-        
-        // Initialize sound timing
-        animalSound->nextSoundTime = GetTime() + GetRandomValue(0, 5); // Random initial delay
-        animalSound->soundInterval = MIN_SOUND_INTERVAL + 
-            (float)GetRandomValue(0, (int)((MAX_SOUND_INTERVAL - MIN_SOUND_INTERVAL) * 100)) / 100.0f;
-        
-        // Store the sound data with the animal
-        animals[i].soundData = animalSound;
+// Sound file of each AnimalType, loaded once and played by every animal through an alias
+const char* animalSoundFiles[ANIMAL_COUNT] = { "sounds/horse.mp3", "sounds/cat.mp3", "sounds/dog.mp3",
+                                               "sounds/cow.mp3", "sounds/chicken.mp3", "sounds/pig.mp3" };
+Sound animalSpeciesSounds[ANIMAL_COUNT] = { 0 };
+
+// Give an animal its own alias of the species sound (no-op until LoadAnimalSounds() has run)
+void AttachAnimalSound(AnimalType type, int slot) {
+    if (animalSpeciesSounds[type].frameCount == 0) return;
+
+    Herd *herd = &herds[type];
+    AnimalSound* animalSound = (AnimalSound*)MemAlloc(sizeof(AnimalSound));
+    if (animalSound == NULL) {
+        TraceLog(LOG_ERROR, "Failed to allocate memory for animal sound");
+        return;
     }
+
+    // Aliases share the sample data, each one only adds its own playback state (volume, position)
+    animalSound->sound = LoadSoundAlias(animalSpeciesSounds[type]);
+
+    // Initialize sound timing
+    animalSound->nextSoundTime = GetTime() + GetRandomValue(0, 5); // Random initial delay
+    animalSound->soundInterval = MIN_SOUND_INTERVAL + 
+        (float)GetRandomValue(0, (int)((MAX_SOUND_INTERVAL - MIN_SOUND_INTERVAL) * 100)) / 100.0f;
+    animalSound->dueVolume = -1.0f;
+
+    // Store the sound data with the animal
+    herd->soundData[slot] = animalSound;
 }
 
-// Function to play animal sounds with distance-based volume
-void PlayAnimalSound(Animal* animal, Camera camera) {
-    if (!animal || !animal->active || !animal->soundData) return;
-    
-    AnimalSound* soundData = (AnimalSound*)animal->soundData;
-    float currentTime = GetTime();
+// Function to load animal sounds
+void LoadAnimalSounds(void) {
+    // Initialize audio device
+    InitAudioDevice();
     
-    // Check if it's time to play the sound
-    if (currentTime >= soundData->nextSoundTime) {
-        // Calculate distance to camera
-        float distance = Vector3Distance(animal->position, camera.position);
-        
+    // Load one sound per species, then give every animal spawned so far its alias
+    for (int type = 0; type < ANIMAL_COUNT; type++) {
+        animalSpeciesSounds[type] = LoadSoundAsset(animalSoundFiles[type]);
+
+        Herd *herd = &herds[type];
+        for (int i = 0; i < herd->count; i++) AttachAnimalSound(type, i);
+    }
+}
+
+// Sound scheduling job of one herd
+typedef struct {
+    Herd *herd;
+    Vector3 listener;
+    float time;
+} AnimalSoundJob;
+
+// Job: find the sounds due in the slots [begin, end) of a herd and their distance-based volume
+void ScheduleAnimalSounds(void *data, int begin, int end) {
+    const AnimalSoundJob *job = (const AnimalSoundJob *)data;
+    Herd *herd = job->herd;
+
+    for (int i = begin; i < end; i++) {
+        AnimalSound* soundData = (AnimalSound*)herd->soundData[i];
+        if (!soundData) continue;
+        soundData->dueVolume = -1.0f;
+
+        // Check if it's time to play the sound
+        if (job->time < soundData->nextSoundTime) continue;
+
         // Only play sound if within hearing range
+        float distance = Vector3Distance((Vector3){ herd->x[i], herd->y[i], herd->z[i] }, job->listener);
         if (distance <= MAX_SOUND_DISTANCE) {
             // Calculate volume based on distance (1.0 at 0 distance, 0.0 at MAX_SOUND_DISTANCE)
-            float volume = 1.0f - (distance / MAX_SOUND_DISTANCE);
-            volume = Clamp(volume, 0.0f, 1.0f);
-            
+            soundData->dueVolume = Clamp(1.0f - (distance / MAX_SOUND_DISTANCE), 0.0f, 1.0f);
+        }
+    }
+}
+
+// Function to play animal sounds with distance-based volume.
+// The due sounds are found on the job pool, played and rescheduled on the main thread in slot
+// order (the audio device and the random generator stay on the main thread).
+void PlayAnimalSounds(Camera camera) {
+    float currentTime = GetTime();
+
+    for (int type = 0; type < ANIMAL_COUNT; type++) {
+        Herd *herd = &herds[type];
+        AnimalSoundJob job = { herd, camera.position, currentTime };
+        RunParallelFor(herd->count, ANIMAL_SOUND_BATCH_SIZE, ScheduleAnimalSounds, &job);
+
+        for (int i = 0; i < herd->count; i++) {
+            AnimalSound* soundData = (AnimalSound*)herd->soundData[i];
+            if (!soundData || soundData->dueVolume < 0.0f) continue;
+
             // Set volume and play sound
-            SetSoundVolume(soundData->sound, volume);
+            SetSoundVolume(soundData->sound, soundData->dueVolume);
             PlaySound(soundData->sound);
-            
+
             // Schedule next sound
             soundData->nextSoundTime = currentTime + soundData->soundInterval;
             // Randomize next interval
@@ -1969,13 +3449,20 @@ void PlayAnimalSound(Animal* animal, Camera camera) {
 
 // Function to unload animal sounds
 void UnloadAnimalSounds(void) {
-    for (int i = 0; i < animalCount; i++) {
-        if (!animals[i].active || !animals[i].soundData) continue;
-        
-        AnimalSound* soundData = (AnimalSound*)animals[i].soundData;
-        UnloadSound(soundData->sound);
-        MemFree(soundData);
-        animals[i].soundData = NULL;
+    for (int type = 0; type < ANIMAL_COUNT; type++) {
+        Herd *herd = &herds[type];
+        for (int i = 0; i < herd->count; i++) {
+            if (!herd->soundData[i]) continue;
+            
+            AnimalSound* soundData = (AnimalSound*)herd->soundData[i];
+            UnloadSoundAlias(soundData->sound);
+            MemFree(soundData);
+            herd->soundData[i] = NULL;
+        }
+
+        // The aliases are gone, the species sound owns the sample data
+        if (animalSpeciesSounds[type].frameCount > 0) UnloadSound(animalSpeciesSounds[type]);
+        animalSpeciesSounds[type] = (Sound){ 0 };
     }
     
     CloseAudioDevice();
@@ -2011,9 +3498,14 @@ Vector3 GetRandomChickenEnclosurePosition(void) {
     return position;
 }
 
-// Function to spawn multiple chickens in the enclosure
+// Function to spawn multiple chickens in the enclosure, up to its capacity
 void SpawnChickensInEnclosure(int count) {
-    for (int i = 0; i < count && animalCount < MAX_ANIMALS; i++) {
+    int capacity = GetPenCapacity(ANIMAL_CHICKEN);
+    for (int i = 0; i < count && animalCount < maxAnimals; i++) {
+        if (animalCountByType[ANIMAL_CHICKEN] >= capacity) {
+            TraceLog(LOG_WARNING, "Chicken enclosure is full (%d animals), %d not spawned", capacity, count - i);
+            break;
+        }
         Vector3 position = GetRandomChickenEnclosurePosition();
         SpawnAnimal(ANIMAL_CHICKEN, position, FIXED_TERRAIN_SIZE);
     }
@@ -2049,9 +3541,14 @@ Vector3 GetRandomPigEnclosurePosition(void) {
     return position;
 }
 
-// Function to spawn multiple pigs in the enclosure
+// Function to spawn multiple pigs in the enclosure, up to its capacity
 void SpawnPigsInEnclosure(int count) {
-    for (int i = 0; i < count && animalCount < MAX_ANIMALS; i++) {
+    int capacity = GetPenCapacity(ANIMAL_PIG);
+    for (int i = 0; i < count && animalCount < maxAnimals; i++) {
+        if (animalCountByType[ANIMAL_PIG] >= capacity) {
+            TraceLog(LOG_WARNING, "Pig enclosure is full (%d animals), %d not spawned", capacity, count - i);
+            break;
+        }
         Vector3 position = GetRandomPigEnclosurePosition();
         SpawnAnimal(ANIMAL_PIG, position, FIXED_TERRAIN_SIZE);
     }
@@ -2069,31 +3566,11 @@ bool IsNearBankOrOnRoadToBank(Vector3 position) {
     
     // Check if on road to bank (second road)
     if (totalCustomRoadsCount >= 2) {
-        CustomRoad* bankRoad = &allCustomRoads[1]; // Second road (to bank)
-        
-        // Check each segment of this road
-        for (int segmentIndex = 0; segmentIndex < bankRoad->numPoints - 1; segmentIndex++) {
-            Vector3 p1 = bankRoad->points[segmentIndex];
-            Vector3 p2 = bankRoad->points[segmentIndex + 1];
-            
-            // Project position onto the road segment
-            Vector3 segmentVec = Vector3Subtract(p2, p1);
-            Vector3 posVec = Vector3Subtract(position, p1);
-            
-            float segmentLengthSq = Vector3LengthSqr(segmentVec);
-            if (segmentLengthSq == 0.0f) continue; // Avoid division by zero
-            
-            float t = Vector3DotProduct(posVec, segmentVec) / segmentLengthSq;
-            t = Clamp(t, 0.0f, 1.0f); // Ensure projection is on the segment
-            
-            Vector3 closestPoint = Vector3Add(p1, Vector3Scale(segmentVec, t));
-            
-            // Check if player is on or near the road
-            float roadBuffer = roadWidth * 1.5f; // Wider buffer for player movement
-            
-            if (Vector3Distance(position, closestPoint) < roadBuffer) {
-                return true; // On or near the road to bank
-            }
+        // Check if player is on or near the second road (to bank)
+        float roadBuffer = roadWidth * 1.5f; // Wider buffer for player movement
+
+        if (QueryRoadGrid(position, roadBuffer, 1).roadId != -1) {
+            return true; // On or near the road to bank
         }
     }
     
@@ -2106,18 +3583,21 @@ bool IsNearBankOrOnRoadToBank(Vector3 position) {
 void InitHuman(Human* h) {
     TraceLog(LOG_INFO, "Initializing human character");
     
-    // Create a default cube model as a fallback in case model loading fails
-    Model fallbackModel = LoadModelFromMesh(GenMeshCube(1.0f, 2.0f, 1.0f));
+    // Create a default cube model as a fallback in case model loading fails (headless: no GL, stays empty)
+    Model fallbackModel = { 0 };
+#if !defined(FARM_HEADLESS)
+    fallbackModel = LoadModelFromMesh(GenMeshCube(1.0f, 2.0f, 1.0f));
+#endif
     
     // Load models from the resources/humans folder with extended error handling
     TraceLog(LOG_INFO, "Loading human walking model...");
-    h->walkingModel = LoadModel("humans/walking_character.glb");
+    h->walkingModel = LoadModelAsset("humans/walking_character.glb");
     
     TraceLog(LOG_INFO, "Loading human idle model...");
-    h->idleModel = LoadModel("humans/idle_character.glb");
+    h->idleModel = LoadModelAsset("humans/idle_character.glb");
     
     TraceLog(LOG_INFO, "Loading human looking model...");
-    h->lookingModel = LoadModel("humans/looking_character.glb");
+    h->lookingModel = LoadModelAsset("humans/looking_character.glb");
     
     // Check if models loaded successfully and use fallbacks if needed
     if (h->walkingModel.meshCount == 0) {
@@ -2135,6 +3615,14 @@ void InitHuman(Human* h) {
         h->lookingModel = fallbackModel;
     }
     
+    // Prefer GPU skinning (the fallback cube has no bones and is left untouched)
+    SetupModelSkinning(&h->walkingModel);
+    SetupModelSkinning(&h->idleModel);
+    SetupModelSkinning(&h->lookingModel);
+    ApplyFogShader(&h->walkingModel);
+    ApplyFogShader(&h->idleModel);
+    ApplyFogShader(&h->lookingModel);
+
     // Initialize animation pointers to NULL
     h->walkingAnim = NULL;
     h->idleAnim = NULL;
@@ -2145,9 +3633,9 @@ void InitHuman(Human* h) {
     
     // Load animations - this is where errors might occur
     TraceLog(LOG_INFO, "Loading human animations");
-    h->walkingAnim = LoadModelAnimations("humans/walking_character.glb", &h->walkingAnimCount);
-    h->idleAnim = LoadModelAnimations("humans/idle_character.glb", &h->idleAnimCount);
-    h->lookingAnim = LoadModelAnimations("humans/looking_character.glb", &h->lookingAnimCount);
+    h->walkingAnim = LoadModelAnimationsAsset("humans/walking_character.glb", &h->walkingAnimCount);
+    h->idleAnim = LoadModelAnimationsAsset("humans/idle_character.glb", &h->idleAnimCount);
+    h->lookingAnim = LoadModelAnimationsAsset("humans/looking_character.glb", &h->lookingAnimCount);
     h->animFrameCounter = 0;
     
     // Check if animations loaded successfully
@@ -2182,6 +3670,11 @@ void InitHuman(Human* h) {
             h->lookingAnimCount = h->idleAnimCount;
         }
     }
+
+    // Simplified levels, after the fallbacks above so a shared model shares its levels
+    h->walkingLods = AcquireModelLods(h->walkingModel, "walking_character");
+    h->idleLods = AcquireModelLods(h->idleModel, "idle_character");
+    h->lookingLods = AcquireModelLods(h->lookingModel, "looking_character");
     
     // Set default values
     h->position = (Vector3){ 0.0f, 0.3f, 0.0f };  // Slightly above ground level
@@ -2211,15 +3704,8 @@ bool IsRoadIntersection(Vector3 position, float threshold) {
     // First check against actual road intersections
     int crossingCount = 0;
     
-    // Check each road to count how many are near this position
-    for (int i = 0; i < totalCustomRoadsCount; i++) {
-        for (int j = 0; j < allCustomRoads[i].numPoints; j++) {
-            if (Vector3Distance(position, allCustomRoads[i].points[j]) < threshold) {
-                crossingCount++;
-                break;  // Count each road only once
-            }
-        }
-    }
+    // Count how many roads have a point near this position (each road counted once)
+    crossingCount = CountRoadsNearPoint(position, threshold);
     
     // If more than one road is nearby, it's likely an intersection
     if (crossingCount > 1) {
@@ -2309,7 +3795,7 @@ void SetupHumanPath(Human* h, Vector3 startPos, Vector3 endPos) {
 // Function to draw the human character
 void DrawHuman(Human* h, Camera camera) {
     // Add debug logging
-    TraceLog(LOG_INFO, "DrawHuman called: active=%d, state=%d, position=(%.2f, %.2f, %.2f)", 
+    TraceLog(LOG_DEBUG, "DrawHuman called: active=%d, state=%d, position=(%.2f, %.2f, %.2f)", 
         h->active, h->state, h->position.x, h->position.y, h->position.z);
     
     // Removed debug markers: sphere, cube, vertical line, path point spheres/lines, destination cube.
@@ -2319,23 +3805,27 @@ void DrawHuman(Human* h, Camera camera) {
         return;
     }
     
-    // Determine which model to use based on state
+    // Determine which model to use based on state, posed with its own clip
     Model modelToDraw;
+    ModelLods *lods = h->idleLods;
+    ModelAnimation *anim = (h->idleAnimCount > 0) ? &h->idleAnim[0] : NULL;
     switch (h->state) {
         case HUMAN_STATE_WALKING:
             modelToDraw = h->walkingModel;
-            TraceLog(LOG_INFO, "Using walking model for human");
+            lods = h->walkingLods;
+            anim = (h->walkingAnimCount > 0) ? &h->walkingAnim[0] : NULL;
+            TraceLog(LOG_DEBUG, "Using walking model for human");
             break;
         // HUMAN_STATE_IDLE_AT_INTERSECTION will now use the idle model for its 3D representation
         // The full-screen menu is handled separately by DrawHumanStartMenu
         case HUMAN_STATE_IDLE_AT_INTERSECTION: 
         case HUMAN_STATE_TALKING: // Fallthrough, TALKING might also use idle or looking
             modelToDraw = h->idleModel;  // Use idle model for idle/talking state
-            TraceLog(LOG_INFO, "Using idle model for human while idle/talking");
+            TraceLog(LOG_DEBUG, "Using idle model for human while idle/talking");
             break;
         case HUMAN_STATE_DISAPPEARING:
             modelToDraw = h->idleModel;
-            TraceLog(LOG_INFO, "Using idle model for disappearing human");
+            TraceLog(LOG_DEBUG, "Using idle model for disappearing human");
             break;
         default:
             TraceLog(LOG_WARNING, "Human in unexpected state: %d", h->state);
@@ -2356,13 +3846,23 @@ void DrawHuman(Human* h, Camera camera) {
     }
     
     // Draw the human model
-    TraceLog(LOG_INFO, "Drawing human model at (%.2f, %.2f, %.2f) with rotation %.2f, scale %.2f", 
+    TraceLog(LOG_DEBUG, "Drawing human model at (%.2f, %.2f, %.2f) with rotation %.2f, scale %.2f", 
            h->position.x, h->position.y, h->position.z, h->rotationAngle, h->scale);
     
+    // Interpolated between the last two simulation steps
+    Vector3 position = Vector3Lerp(h->prevPosition, h->position, simulationAlpha);
+
+    // Posed once per drawn frame at the level drawn, UpdateHuman() only advances the frame counter
+    // (like the animals, a fast time scale runs many steps per frame)
+    int level = GetModelLodLevel(lods, position, h->scale, camera);
+    modelToDraw = GetModelLod(modelToDraw, lods, level);
+    if (anim != NULL) UpdateSkinnedModel(modelToDraw, *anim, h->animFrameCounter);
+    RecordModelLodDraw(lods, level, 1);
+
     DrawModelEx(modelToDraw,
-              h->position,
+              position,
               (Vector3){0.0f, 1.0f, 0.0f},  // Rotation axis (Y-axis)
-              h->rotationAngle,         // Rotation angle
+              LerpAngleDegrees(h->prevRotationAngle, h->rotationAngle, simulationAlpha), // Rotation angle
               (Vector3){h->scale, h->scale, h->scale},
               tint);
     
@@ -2372,6 +3872,9 @@ void DrawHuman(Human* h, Camera camera) {
 
 // Function to unload human character resources
 void UnloadHumanResources(Human* h) {
+    ReleaseModelLods(h->walkingModel);
+    ReleaseModelLods(h->idleModel);
+    ReleaseModelLods(h->lookingModel);
     UnloadModel(h->walkingModel);
     UnloadModel(h->idleModel);
     UnloadModel(h->lookingModel);
@@ -2393,7 +3896,7 @@ void UnloadHumanResources(Human* h) {
 // Function to update the human character
 void UpdateHuman(Human* h, float deltaTime) {
     // Add debug logging at the start of UpdateHuman
-    TraceLog(LOG_INFO, "UpdateHuman called: active=%d, state=%d, position=(%.2f, %.2f, %.2f)", 
+    TraceLog(LOG_DEBUG, "UpdateHuman called: active=%d, state=%d, position=(%.2f, %.2f, %.2f)", 
               h->active, h->state, h->position.x, h->position.y, h->position.z);
               
     // EMERGENCY FIX: If position is too far from the origin, reset to origin
@@ -2413,23 +3916,22 @@ void UpdateHuman(Human* h, float deltaTime) {
     // Update based on current state
     switch (h->state) {
         case HUMAN_STATE_WALKING: {
-            TraceLog(LOG_INFO, "Human WALKING, time=%.2f", h->stateTimer);
+            TraceLog(LOG_DEBUG, "Human WALKING, time=%.2f", h->stateTimer);
             
             // Update walking animation
             if (h->walkingAnimCount > 0) {
                 h->animFrameCounter++;
-                UpdateModelAnimation(h->walkingModel, h->walkingAnim[0], h->animFrameCounter);
                 if (h->animFrameCounter >= h->walkingAnim[0].frameCount) {
                     h->animFrameCounter = 0;
                 }
-                TraceLog(LOG_INFO, "Playing walking animation frame %d", h->animFrameCounter);
+                TraceLog(LOG_DEBUG, "Playing walking animation frame %d", h->animFrameCounter);
             } else {
-                TraceLog(LOG_WARNING, "No walking animation available");
+                TraceLog(LOG_DEBUG, "No walking animation available");
             }
             
             // Calculate movement distance for this frame
             float moveDistance = h->speed * deltaTime * 5.0f; // Significantly reduced from 100.0f to 5.0f for slower movement
-            TraceLog(LOG_INFO, "Moving distance: %.4f per frame", moveDistance);
+            TraceLog(LOG_DEBUG, "Moving distance: %.4f per frame", moveDistance);
             
             // Calculate direction to current target point (second path point)
             Vector3 pathDirection = Vector3Normalize(Vector3Subtract(h->targetPosition, h->position));
@@ -2445,7 +3947,7 @@ void UpdateHuman(Human* h, float deltaTime) {
             h->rotationAngle = atan2f(exactPathDirection.x, exactPathDirection.z) * RAD2DEG;
             
             // Log the movement
-            TraceLog(LOG_INFO, "Human position updated to (%.2f, %.2f, %.2f)", 
+            TraceLog(LOG_DEBUG, "Human position updated to (%.2f, %.2f, %.2f)", 
                      h->position.x, h->position.y, h->position.z);
             
             // Update timer but don't use it for state transitions
@@ -2453,12 +3955,12 @@ void UpdateHuman(Human* h, float deltaTime) {
             
             // Check distance to destination instead of using timer
             float distanceToTarget = Vector3Distance(h->position, h->targetPosition);
-            TraceLog(LOG_WARNING, "Walking time: %.2f, distance to target: %.2f", h->stateTimer, distanceToTarget);
+            TraceLog(LOG_DEBUG, "Walking time: %.2f, distance to target: %.2f", h->stateTimer, distanceToTarget);
             
             // Only switch states when we're close enough to the destination
             if (distanceToTarget < 0.5f) {
                 // Arrived at destination, switch to idle state for start menu
-                TraceLog(LOG_WARNING, "REACHED DESTINATION - SWITCHING TO IDLE FOR START MENU");
+                TraceLog(LOG_DEBUG, "REACHED DESTINATION - SWITCHING TO IDLE FOR START MENU");
                 h->state = HUMAN_STATE_IDLE_AT_INTERSECTION;
                 h->stateTimer = 0.0f;
                 h->animFrameCounter = 0; // Reset animation counter for new state
@@ -2466,8 +3968,8 @@ void UpdateHuman(Human* h, float deltaTime) {
                 // Force human to stay active for the menu
                 h->active = true; 
                 
-                TraceLog(LOG_WARNING, "Human reached destination, transitioning to HUMAN_STATE_IDLE_AT_INTERSECTION.");
-                TraceLog(LOG_WARNING, "Human state after transition: %d, active: %d", 
+                TraceLog(LOG_DEBUG, "Human reached destination, transitioning to HUMAN_STATE_IDLE_AT_INTERSECTION.");
+                TraceLog(LOG_DEBUG, "Human state after transition: %d, active: %d", 
                        h->state, h->active);
                 
                 // Snap to exact destination position to avoid floating point imprecision
@@ -2478,14 +3980,13 @@ void UpdateHuman(Human* h, float deltaTime) {
         }
             
         case HUMAN_STATE_IDLE_AT_INTERSECTION: {
-            TraceLog(LOG_INFO, "Human IDLE_AT_INTERSECTION (Start Menu State)");
+            TraceLog(LOG_DEBUG, "Human IDLE_AT_INTERSECTION (Start Menu State)");
 
             h->active = true; // Human stays active to display the menu
 
             // Update idle animation
             if (h->idleAnimCount > 0) {
                 h->animFrameCounter++;
-                UpdateModelAnimation(h->idleModel, h->idleAnim[0], h->animFrameCounter);
                 if (h->animFrameCounter >= h->idleAnim[0].frameCount) {
                     h->animFrameCounter = 0;
                 }
@@ -2498,19 +3999,17 @@ void UpdateHuman(Human* h, float deltaTime) {
         case HUMAN_STATE_TALKING: {
             // This state is not currently used in the primary welcome flow.
             // If it were to be used, it would need its own dialog handling.
-            TraceLog(LOG_WARNING, "Human TALKING (currently unused in welcome flow), dialog=%d, waitForKey=%d", h->showDialog, h->waitForKeyPress);
+            TraceLog(LOG_DEBUG, "Human TALKING (currently unused in welcome flow), dialog=%d, waitForKey=%d", h->showDialog, h->waitForKeyPress);
             
             h->active = true; // Ensure human is active if this state is somehow entered
             // Play an animation (e.g., looking or idle)
             if (h->lookingAnimCount > 0) {
                 h->animFrameCounter++;
-                UpdateModelAnimation(h->lookingModel, h->lookingAnim[0], h->animFrameCounter);
                 if (h->animFrameCounter >= h->lookingAnim[0].frameCount) {
                     h->animFrameCounter = 0;
                 }
             } else if (h->idleAnimCount > 0) {
                 h->animFrameCounter++;
-                UpdateModelAnimation(h->idleModel, h->idleAnim[0], h->animFrameCounter);
                 if (h->animFrameCounter >= h->idleAnim[0].frameCount) {
                     h->animFrameCounter = 0;
                 }
@@ -2524,7 +4023,7 @@ void UpdateHuman(Human* h, float deltaTime) {
         case HUMAN_STATE_DISAPPEARING:
             // This state could be used for a fade-out animation if desired.
             // For now, it will just lead to inactive.
-            TraceLog(LOG_INFO, "Human DISAPPEARING");
+            TraceLog(LOG_DEBUG, "Human DISAPPEARING");
             h->disappearAlpha -= deltaTime * 0.5f; // Example fade out speed
             if (h->disappearAlpha <= 0.0f) {
                 h->disappearAlpha = 0.0f;
@@ -2537,7 +4036,7 @@ void UpdateHuman(Human* h, float deltaTime) {
             // Human is inactive, do nothing further here.
             // DrawHuman will not draw the model.
             // DrawHumanStartMenu will not draw the menu.
-            TraceLog(LOG_INFO, "Human INACTIVE");
+            TraceLog(LOG_DEBUG, "Human INACTIVE");
             h->active = false; // Ensure active is false
             break;
 
@@ -2569,7 +4068,7 @@ void UpdateHuman(Human* h, float deltaTime) {
 void DrawHumanStartMenu(Human *h) {
     // Only draw if the human is active and in the specific state for the start menu
     if (h->active && h->state == HUMAN_STATE_IDLE_AT_INTERSECTION) {
-        TraceLog(LOG_INFO, "DrawHumanStartMenu: Menu IS ACTIVE and being drawn. human.active = %d, human.state = %d", h->active, h->state);
+        TraceLog(LOG_DEBUG, "DrawHumanStartMenu: Menu IS ACTIVE and being drawn. human.active = %d, human.state = %d", h->active, h->state);
         int screenWidth = GetScreenWidth();
         int screenHeight = GetScreenHeight();
 
@@ -2652,223 +4151,423 @@ void DrawHumanStartMenu(Human *h) {
     }
 }
 
-int main(void)
-{
-    // const int screenWidth = 1512;
-    // const int screenHeight = 1080;
-    int currentMonitor = GetCurrentMonitor();
-    const int screenWidth = GetMonitorWidth(currentMonitor);
-    const int screenHeight = GetMonitorHeight(currentMonitor);
+// --- Farm Economy (menu actions, also driven by the headless simulation) ---
 
-    InitWindow(screenWidth, screenHeight, "VR Farming Simulator");
-    rlSetClipPlanes(1.0, 1500.0); // Adjust near/far clip planes for better depth precision
+// Deplete hunger and advance production of every species (using AnimalCategoryStats)
+void UpdateAnimalProduction(float deltaTime) {
+    for (int type = 0; type < ANIMAL_COUNT; type++) {
+        if (animalCountByType[type] == 0) continue; // Skip if no animals of this type
 
-    // Define the camera
-    Camera camera = {0};
-    camera.position = (Vector3){0.0f, HUMAN_HEIGHT, 0.0f}; // Set camera at human height
-    camera.target = (Vector3){0.0f, HUMAN_HEIGHT, 1.0f};   // Look forward (will be updated)
-    camera.up = (Vector3){0.0f, 1.0f, 0.0f};
-    camera.fovy = 60.0f;
-    camera.projection = CAMERA_PERSPECTIVE;
+        animalStats[type].timeSinceLastFed += deltaTime;
 
-    int cameraMode = CAMERA_FIRST_PERSON; // Default to first person
+        // Hunger depletion
+        if (animalStats[type].timeSinceLastFed >= HUNGER_DEPLETION_INTERVAL) {
+            animalStats[type].timeSinceLastFed = 0.0f; // Reset interval timer
+            float depletionRate = 0.0f;
+            switch(type) {
+                case ANIMAL_CHICKEN: depletionRate = CHICKEN_HUNGER_DEPLETION_RATE; break;
+                case ANIMAL_PIG:     depletionRate = PIG_HUNGER_DEPLETION_RATE; break;
+                case ANIMAL_COW:     depletionRate = COW_HUNGER_DEPLETION_RATE; break;
+            }
+            animalStats[type].hunger -= depletionRate;
+            if (animalStats[type].hunger < 0) animalStats[type].hunger = 0;
+        }
 
-    // Update the texture loading part of your code
-    SearchAndSetResourceDir("resources");
-    // Change the filename to match your downloaded texture
-    Texture2D terrainTexture = LoadTexture("textures/rocky_terrain_02_diff_8k.jpg");
+        // Production
+        if (animalStats[type].hunger > 20.0f) { // Animals only produce if hunger > 20%
+             if (!animalStats[type].productReady) { // Only countdown if product is not already ready
+                animalStats[type].productCooldownTimer -= deltaTime;
+                if (animalStats[type].productCooldownTimer <= 0) {
+                    animalStats[type].productReady = true;
+                    // Cooldown will be reset when product is collected
+                    // Set a minimal timer to avoid immediate re-trigger if collection fails
+                    animalStats[type].productCooldownTimer = 0.1f; 
+                }
+            }
+        } else {
+            // If hunger is too low, pause production timer but don't reset it completely.
+            // It will resume when animals are fed again. Product can still be ready if it became ready before hunger dropped.
+        }
+    }
+}
 
-    // Load road texture
-    roadTexture = LoadTexture("textures/rocky_trail_diff_8k.jpg"); // Initialize global roadTexture
-    if (roadTexture.id == 0) { // Check if road texture failed to load
-        TraceLog(LOG_ERROR, "Failed to load road texture: textures/rocky_trail_diff_8k.jpg");
+// Feed every animal of a species from the inventory, 1 food per animal
+bool FeedAnimals(AnimalType type) {
+    const char* animalName = (type == ANIMAL_CHICKEN) ? "Chickens" : (type == ANIMAL_PIG) ? "Pigs" : "Cows";
+    int foodNeeded = animalCountByType[type];
+    if (playerInventory.type == ITEM_FOOD && playerInventory.quantity >= foodNeeded) {
+        RemoveFromInventory(ITEM_FOOD, foodNeeded);
+        animalStats[type].hunger = 100.0f;
+        animalStats[type].timeSinceLastFed = 0.0f; // Reset depletion timer
+        TraceLog(LOG_INFO, "Fed %s. Consumed %d food.", animalName, foodNeeded);
+        return true;
     }
-    
-    // Load inventory item textures
-    inventoryItemTextures[ITEM_FOOD] = LoadTexture("inventory/food.png");
-    inventoryItemTextures[ITEM_EGG] = LoadTexture("inventory/egg.png");
-    inventoryItemTextures[ITEM_MILK] = LoadTexture("inventory/milk.png");
-    inventoryItemTextures[ITEM_STEAK] = LoadTexture("inventory/steak.png");
-    
-    // Log loading of textures
-    TraceLog(LOG_INFO, "Loading inventory textures:");
-    TraceLog(LOG_INFO, "- Food texture ID: %d", inventoryItemTextures[ITEM_FOOD].id);
-    TraceLog(LOG_INFO, "- Egg texture ID: %d", inventoryItemTextures[ITEM_EGG].id);
-    TraceLog(LOG_INFO, "- Milk texture ID: %d", inventoryItemTextures[ITEM_MILK].id);
-    TraceLog(LOG_INFO, "- Steak texture ID: %d", inventoryItemTextures[ITEM_STEAK].id);
-    
-    // Check if textures loaded successfully
-    for (int i = 0; i < ITEM_TYPE_COUNT; i++) {
-        if (inventoryItemTextures[i].id == 0) {
-            TraceLog(LOG_WARNING, "Failed to load texture for item type %s", inventoryItemNames[i]);
+
+    TraceLog(LOG_WARNING, "Not enough food in inventory to feed %s.", animalName);
+    return false;
+}
+
+// Collect the ready products of a species into the (empty) inventory, 1 product per animal
+bool CollectAnimalProducts(AnimalType type) {
+    InventoryItemType item = (type == ANIMAL_CHICKEN) ? ITEM_EGG : (type == ANIMAL_PIG) ? ITEM_STEAK : ITEM_MILK;
+    int numProducts = animalCountByType[type];
+    if (playerInventory.type == ITEM_NONE && animalStats[type].productReady && numProducts > 0) {
+        AddToInventory(item, numProducts);
+        animalStats[type].productReady = false;
+        // Reset cooldown based on type
+        switch(type) {
+            case ANIMAL_CHICKEN: animalStats[type].productCooldownTimer = CHICKEN_PRODUCTION_TIME; break;
+            case ANIMAL_PIG:     animalStats[type].productCooldownTimer = PIG_PRODUCTION_TIME; break;
+            case ANIMAL_COW:     animalStats[type].productCooldownTimer = COW_PRODUCTION_TIME; break;
+            default: 
+                // Handle other animal types or provide a default behavior
+                TraceLog(LOG_WARNING, "Product collection cooldown not set for animal type: %d", type);
+                break;
         }
+        TraceLog(LOG_INFO, "Collected %d %s.", numProducts, inventoryItemNames[item]);
+        return true;
     }
-    
-    // Initialize animal stats
+
+    TraceLog(LOG_WARNING, "Cannot collect. Inventory not empty, products not ready, or no animals.");
+    return false;
+}
+
+// Get the barn storage slot of an item type
+int *GetBarnStorageSlot(InventoryItemType item) {
+    switch (item) {
+        case ITEM_FOOD: return &barnStorage.food;
+        case ITEM_EGG: return &barnStorage.eggs;
+        case ITEM_MILK: return &barnStorage.milk;
+        case ITEM_STEAK: return &barnStorage.steak;
+        default: return NULL;
+    }
+}
+
+// Move the inventory into the barn if it holds the given item
+bool StoreInventoryInBarn(InventoryItemType item) {
+    int *slot = GetBarnStorageSlot(item);
+    if (slot != NULL && playerInventory.type == item && playerInventory.quantity > 0) {
+        *slot += playerInventory.quantity;
+        TraceLog(LOG_INFO, "Stored %d %s in barn. Barn total: %d", playerInventory.quantity, inventoryItemNames[item], *slot);
+        ClearInventory();
+        return true;
+    }
+
+    TraceLog(LOG_WARNING, "No %s in inventory to store.", inventoryItemNames[item]);
+    return false;
+}
+
+// Take up to 50 food from the barn into the inventory
+bool TakeFoodFromBarn(void) {
+    if (playerInventory.type == ITEM_NONE || playerInventory.type == ITEM_FOOD) {
+        if (barnStorage.food > 0) {
+            int amountToTake = (barnStorage.food >= 50) ? 50 : barnStorage.food;
+            AddToInventory(ITEM_FOOD, amountToTake);
+            barnStorage.food -= amountToTake;
+            TraceLog(LOG_INFO, "Took %d food from barn. Barn remaining: %d", amountToTake, barnStorage.food);
+            return true;
+        }
+        TraceLog(LOG_WARNING, "No food in barn to take.");
+    } else {
+        TraceLog(LOG_WARNING, "Inventory not empty or already contains a different item. Cannot take food.");
+    }
+    return false;
+}
+
+// Sell every stored unit of a product at the bank
+bool SellBarnProduct(InventoryItemType item) {
+    int *slot = GetBarnStorageSlot(item);
+    float price = (item == ITEM_EGG) ? PRICE_EGG_SELL : (item == ITEM_MILK) ? PRICE_MILK_SELL : PRICE_STEAK_SELL;
+    if (slot != NULL && item != ITEM_FOOD && *slot > 0) {
+        playerCoins += *slot * price;
+        TraceLog(LOG_INFO, "Sold %d %s. Player coins: %.0f", *slot, inventoryItemNames[item], playerCoins);
+        *slot = 0;
+        return true;
+    }
+
+    TraceLog(LOG_WARNING, "No %s in barn to sell.", inventoryItemNames[item]);
+    return false;
+}
+
+// Buy 50 food, delivered to the barn
+bool BuyFood(void) {
+    if (playerCoins >= PRICE_FOOD_BUY * 50) {
+        playerCoins -= PRICE_FOOD_BUY * 50;
+        barnStorage.food += 50; // Add to barn, player can take it later
+        TraceLog(LOG_INFO, "Bought 50 food. Player coins: %.0f. Barn food: %d", playerCoins, barnStorage.food);
+        return true;
+    }
+
+    TraceLog(LOG_WARNING, "Not enough coins to buy food.");
+    return false;
+}
+
+// --- World Setup (shared by the game and the headless simulation) ---
+
+// Reset the hunger and production state of every species
+void InitAnimalStats(void) {
     for (int i = 0; i < ANIMAL_COUNT; i++) {
         animalStats[i].hunger = 100.0f;
         animalStats[i].productCooldownTimer = 0.0f;
         animalStats[i].timeSinceLastFed = 0.0f;
         animalStats[i].productReady = false;
     }
+}
 
-    // Optimize texture quality for terrain
-    SetTextureFilter(terrainTexture, TEXTURE_FILTER_ANISOTROPIC_16X);
-    SetTextureWrap(terrainTexture, TEXTURE_WRAP_REPEAT);
+// --- Scenarios ---
+// Startup counts and ramps come from the active scenario (see scenario.h), selected with
+// --scenario <file> and --set "<line>". Keys are the animal asset names, the plant keys below,
+// "clouds" and "roads"; every count the scenario doesn't set keeps its default.
+#define DEFAULT_ROAD_COUNT 5            // The authored roads
+#define SCENARIO_ROAD_POINTS 40         // Control points of a generated road
+#define SCENARIO_ROAD_STEP 3.0f         // Distance between them
+
+const char *plantScenarioKeys[PLANT_TYPE_COUNT] = { "tree", "grass", "flower", "flower2", "bush" };
+const int defaultAnimalCounts[ANIMAL_COUNT] = { 3, 2, 2, 2, 1, 1 }; // Horse, cat, dog, cow, chicken, pig
+const int defaultPlantCounts[PLANT_TYPE_COUNT] = { NUMBER_OF_TREES, NUMBER_OF_GRASS, NUMBER_OF_FLOWERS,
+                                                   NUMBER_OF_FLOWER_TYPE2, NUMBER_OF_BUSH_WITH_FLOWERS };
+
+Scenario scenario = { .name = "default" };
+
+// Find a key in a name table, -1 if it isn't there
+int FindScenarioKey(const char *const *keys, int keyCount, const char *key) {
+    for (int i = 0; i < keyCount; i++) {
+        if (strcmp(keys[i], key) == 0) return i;
+    }
+    return -1;
+}
 
-    // Optimize texture quality for road
-    SetTextureFilter(roadTexture, TEXTURE_FILTER_ANISOTROPIC_16X);
-    SetTextureWrap(roadTexture, TEXTURE_WRAP_REPEAT);
+// Load the scenario selected on the command line: the --scenario file first, every --set line on top
+void LoadScenarioFromArgs(int argc, char *argv[]) {
+    for (int i = 1; i < argc - 1; i++) {
+        if (strcmp(argv[i], "--scenario") == 0) scenario = LoadScenario(argv[i + 1]);
+    }
+    for (int i = 1; i < argc - 1; i++) {
+        if ((strcmp(argv[i], "--set") == 0) && !SetScenarioLine(&scenario, argv[i + 1])) {
+            TraceLog(LOG_WARNING, "SCENARIO: Invalid --set line: %s", argv[i + 1]);
+        }
+    }
 
-    // Initialize all terrain chunks at once with fixed layout
-    InitAllTerrainChunks(terrainTexture);
-    
-    // Initialize the animals array
-    for (int i = 0; i < MAX_ANIMALS; i++) {
-        animals[i].active = false;
+    for (int i = 0; i < scenario.countCount; i++) {
+        const char *key = scenario.counts[i].key;
+        if ((FindScenarioKey(animalAssetNames, ANIMAL_COUNT, key) < 0) && (FindScenarioKey(plantScenarioKeys, PLANT_TYPE_COUNT, key) < 0) &&
+            (strcmp(key, "clouds") != 0) && (strcmp(key, "roads") != 0)) {
+            TraceLog(LOG_WARNING, "SCENARIO: Unknown key '%s' ignored", key);
+        }
+    }
+    for (int i = 0; i < scenario.rampCount; i++) {
+        const char *key = scenario.ramps[i].key;
+        if ((FindScenarioKey(animalAssetNames, ANIMAL_COUNT, key) < 0) && (FindScenarioKey(plantScenarioKeys, PLANT_TYPE_COUNT, key) < 0)) {
+            TraceLog(LOG_WARNING, "SCENARIO: Only animals and plants can ramp, ramp of '%s' ignored", key);
+        }
     }
+}
 
-    // Initialize the plants array
-    for (int i = 0; i < MAX_PLANTS; i++) {
-        plants[i].active = false;
+// Allocate the entity pools, zeroed (every slot inactive).
+// Herds grow as animals are spawned, animalCapacity only limits their total.
+void InitEntityPools(int animalCapacity, int plantCapacity, int cloudTotal) {
+    maxAnimals = animalCapacity;
+    for (int type = 0; type < ANIMAL_COUNT; type++) herds[type] = LoadHerd(0);
+    animalCount = 0;
+
+    maxPlants = plantCapacity;
+    plants = (Plant *)MemAlloc(maxPlants*sizeof(Plant));
+    plantCount = 0;
+
+    cloudCount = cloudTotal;
+    clouds = (cloudCount > 0) ? (Cloud *)MemAlloc(cloudCount*sizeof(Cloud)) : NULL;
+}
+
+// Allocate the entity pools for the most entities the scenario asks for, never below the default sizes
+void InitScenarioEntityPools(void) {
+    int animalTotal = 0;
+    for (int t = 0; t < ANIMAL_COUNT; t++) animalTotal += GetScenarioMaxCount(&scenario, animalAssetNames[t], defaultAnimalCounts[t]);
+    int plantTotal = 0;
+    for (int t = 0; t < PLANT_TYPE_COUNT; t++) plantTotal += GetScenarioMaxCount(&scenario, plantScenarioKeys[t], defaultPlantCounts[t]);
+
+    InitEntityPools((animalTotal > MAX_ANIMALS) ? animalTotal : MAX_ANIMALS, (plantTotal > MAX_PLANTS) ? plantTotal : MAX_PLANTS,
+                    GetScenarioCount(&scenario, "clouds", MAX_CLOUDS));
+    TraceLog(LOG_INFO, "SCENARIO: '%s', pools for %d animals, %d plants and %d clouds", scenario.name, maxAnimals, maxPlants, cloudCount);
+}
+
+// Free the entity pools
+void UnloadEntityPools(void) {
+    for (int type = 0; type < ANIMAL_COUNT; type++) UnloadHerd(&herds[type]);
+    MemFree(animalUpdateChunks);
+    animalUpdateChunks = NULL;
+    animalUpdateChunkCapacity = 0;
+    MemFree(plants);
+    MemFree(clouds);
+    plants = NULL;
+    clouds = NULL;
+    maxAnimals = maxPlants = cloudCount = 0;
+    animalCount = plantCount = 0;
+}
+
+// Spawn animals where the game keeps their species: chickens and pigs in their enclosures,
+// the other species around the camera
+void SpawnScenarioAnimals(AnimalType type, int count, Camera camera) {
+    if (type == ANIMAL_CHICKEN) SpawnChickensInEnclosure(count);
+    else if (type == ANIMAL_PIG) SpawnPigsInEnclosure(count);
+    else SpawnMultipleAnimals(type, count, FIXED_TERRAIN_SIZE, camera);
+}
+
+// Scatter plants of one type over the farm, with the random scale range of the type
+void SpawnRandomPlants(PlantType type, int count) {
+    for (int i = 0; i < count; i++) {
+        Vector3 pos = GetRandomPlantPosition(FIXED_TERRAIN_SIZE);
+        float scale = 1.0f;
+        switch (type) {
+            case PLANT_TREE: scale = GetRandomValue(80, 150) / 100.0f; break; // Random scale between 0.8 and 1.5
+            case PLANT_GRASS: scale = GetRandomValue(50, 120) / 100.0f; break;
+            case PLANT_FLOWER: scale = GetRandomValue(70, 130) / 100.0f; break;
+            case PLANT_FLOWER_TYPE2: scale = 0.003f; break; // Fixed scale, the model is huge
+            case PLANT_BUSH_WITH_FLOWERS: scale = GetRandomValue(80, 120) / 100.0f; break;
+            default: break;
+        }
+        float rotation = GetRandomValue(0, 360);
+        SpawnPlant(type, pos, scale, rotation);
     }
+}
 
-    // --- Load Global Plant Models ---
-    // Ensure these paths are correct and models exist
-    globalTreeModel = LoadModel("plants/tree.glb");
-    if (globalTreeModel.meshCount == 0) TraceLog(LOG_ERROR, "Failed to load tree.glb");
+// Spawn what the scenario ramps add by a simulated time. Ramped animals spawn around the player
+// start rather than the player, so a ramp doesn't depend on where the player walks.
+void UpdateScenarioRamps(double time) {
+    Camera spawnCamera = { 0 };
+    spawnCamera.position = (Vector3){ 0.0f, HUMAN_HEIGHT, 0.0f };
+
+    bool plantsAdded = false;
+    for (int i = 0; i < scenario.rampCount; i++) {
+        ScenarioRamp *ramp = &scenario.ramps[i];
+        int animalType = FindScenarioKey(animalAssetNames, ANIMAL_COUNT, ramp->key);
+        int plantType = FindScenarioKey(plantScenarioKeys, PLANT_TYPE_COUNT, ramp->key);
+        if ((animalType < 0) && (plantType < 0)) continue; // Warned about at load
+
+        int count = UpdateScenarioRamp(ramp, time);
+        if (count == 0) continue;
+
+        if (animalType >= 0) SpawnScenarioAnimals((AnimalType)animalType, count, spawnCamera);
+        else {
+            SpawnRandomPlants((PlantType)plantType, count);
+            plantsAdded = true;
+        }
+        TraceMarker(TextFormat("Ramp %s +%d", ramp->key, count), "game");
+        TraceLog(LOG_INFO, "SCENARIO: Ramp added %d %s at %.0f s (%d animals, %d plants)", count, ramp->key, time, animalCount, plantCount);
+    }
 
-    globalGrassModel = LoadModel("plants/grass.glb");
-    if (globalGrassModel.meshCount == 0) TraceLog(LOG_ERROR, "Failed to load grass.glb");
+    // New plants still have to clear the roads, join the instance batches and (trees) the collision grid
+    if (plantsAdded) {
+        ClearPlantsNearRoads(3.0f);
+        BuildVegetationBatches();
+        RegisterStaticColliders();
+    }
+}
 
-    globalFlowerModel = LoadModel("plants/flower.glb");
-    if (globalFlowerModel.meshCount == 0) TraceLog(LOG_ERROR, "Failed to load flower.glb");
+// Pre-spawn the scenario's animals, by default 3 horses, 2 dogs, 2 cats, 2 cows and one chicken
+// and one pig in their enclosures (collision grids must exist)
+void SpawnInitialAnimals(Camera camera) {
+    const AnimalType spawnOrder[ANIMAL_COUNT] = { ANIMAL_HORSE, ANIMAL_DOG, ANIMAL_CAT, ANIMAL_COW, ANIMAL_CHICKEN, ANIMAL_PIG };
+    for (int i = 0; i < ANIMAL_COUNT; i++) {
+        AnimalType type = spawnOrder[i];
+        SpawnScenarioAnimals(type, GetScenarioCount(&scenario, animalAssetNames[type], defaultAnimalCounts[type]), camera);
+    }
+}
 
-    globalFlowerModel_type2 = LoadModel("plants/flower2.glb");
-    if (globalFlowerModel_type2.meshCount == 0) TraceLog(LOG_ERROR, "Failed to load flower2.glb");
+// --- Simulation Step ---
+// The farm (animals, the human guide, hunger and production, scenario ramps) advances in fixed
+// SIMULATION_TIMESTEP steps, whatever the frame rate. Frames accumulate their scaled time and run
+// as many steps as it covers, the drawn state is interpolated between the last two steps.
+const float timeScales[] = { 1.0f, 10.0f, 100.0f };   // Speeds F7 cycles through
+float timeScale = 1.0f;                                // 0 pauses the farm
+double simulationAccumulator = 0.0;                    // Scaled seconds not yet simulated
+
+// Advance the farm by one fixed step
+void StepSimulation(void) {
+    worldTime += SIMULATION_TIMESTEP;
+
+    BeginProfileZone(PROFILE_ZONE_ANIMALS);
+    UpdateScenarioRamps(worldTime); // Spawns what the ramps add, before the update
+    UpdateAnimals(SIMULATION_TIMESTEP);
+    EndProfileZone(PROFILE_ZONE_ANIMALS);
+
+    BeginProfileZone(PROFILE_ZONE_HUMAN);
+    human.prevPosition = human.position;
+    human.prevRotationAngle = human.rotationAngle;
+    UpdateHuman(&human, SIMULATION_TIMESTEP);
+    EndProfileZone(PROFILE_ZONE_HUMAN);
+
+    BeginProfileZone(PROFILE_ZONE_PRODUCTION);
+    UpdateAnimalProduction(SIMULATION_TIMESTEP);
+    EndProfileZone(PROFILE_ZONE_PRODUCTION);
+}
 
-    globalBushWithFlowersModel = LoadModel("plants/bushWithFlowers.glb"); // Load new bush model
-    if (globalBushWithFlowersModel.meshCount == 0) TraceLog(LOG_ERROR, "Failed to load bushWithFlowers.glb");
-    // --- End Load Global Plant Models ---
+// Run the steps a frame covers at the current time scale and update the interpolation factor
+void UpdateSimulation(float frameTime) {
+    simulationAccumulator += (double)frameTime*timeScale;
 
-    // Set up basic fog effect for distance
-    float fogDensity = FOG_DENSITY;
-    Color fogColor = FOG_COLOR;
-    
-    // Pre-spawn initial animals: 3 horses, 2 dogs, 2 cats
-    SpawnMultipleAnimals(ANIMAL_HORSE, 3, FIXED_TERRAIN_SIZE, camera);
-    SpawnMultipleAnimals(ANIMAL_DOG, 2, FIXED_TERRAIN_SIZE, camera);
-    SpawnMultipleAnimals(ANIMAL_CAT, 2, FIXED_TERRAIN_SIZE, camera);
-    SpawnMultipleAnimals(ANIMAL_COW, 2, FIXED_TERRAIN_SIZE, camera);
-    // Also pre-spawn one chicken and one pig in their specific enclosures
-    SpawnChickensInEnclosure(1);
-    SpawnPigsInEnclosure(1);
-    
+    int steps = 0;
+    while ((simulationAccumulator >= SIMULATION_TIMESTEP) && (steps < SIMULATION_MAX_STEPS)) {
+        StepSimulation();
+        simulationAccumulator -= SIMULATION_TIMESTEP;
+        steps++;
+    }
+
+    // Out of budget: drop the backlog rather than carrying it into the next frames
+    if (simulationAccumulator >= SIMULATION_TIMESTEP) simulationAccumulator = 0.0;
+    simulationAlpha = (float)(simulationAccumulator/SIMULATION_TIMESTEP);
+}
+
+// Set the simulation speed (0 pauses), the drawn state stays where it is
+void SetTimeScale(float scale) {
+    timeScale = scale;
+    if (scale == 0.0f) TraceLog(LOG_INFO, "SIMULATION: Paused");
+    else TraceLog(LOG_INFO, "SIMULATION: Time scale %gx", scale);
+    TraceMarker((scale == 0.0f) ? "Paused" : TextFormat("Time scale %gx", scale), "game");
+}
+
+// Place the buildings and the fences of both enclosures
+void SetupBuildings(void) {
     // Load building models
-    buildings[0].model = LoadModel("buildings/barn.glb");
+    buildings[0].model = LoadModelAsset("buildings/barn.glb");
     if (buildings[0].model.meshCount == 0) TraceLog(LOG_ERROR, "Failed to load buildings/barn.glb");
     buildings[0].position = (Vector3){ -10.0f, 0.0f, -10.0f };
     buildings[0].scale = 0.05f;
     buildings[0].rotationAngle = 45.0f;
 
-    buildings[1].model = LoadModel("buildings/horse_barn.glb");
+    buildings[1].model = LoadModelAsset("buildings/horse_barn.glb");
     if (buildings[1].model.meshCount == 0) TraceLog(LOG_ERROR, "Failed to load buildings/horse_barn.glb");
     buildings[1].position = (Vector3){ 10.0f, 0.0f, 10.0f };
     buildings[1].scale = 0.75f;
     buildings[1].rotationAngle = -42.0f;
 
     // Load Bank model
-    buildings[2].model = LoadModel("buildings/Bank.glb");
+    buildings[2].model = LoadModelAsset("buildings/Bank.glb");
     if (buildings[2].model.meshCount == 0) TraceLog(LOG_ERROR, "Failed to load buildings/Bank.glb");
     buildings[2].position = (Vector3){ 20.0f, 0.0f, -46.0f };
     buildings[2].scale = 0.0002f; // Drastically reduced scale for testing
     buildings[2].rotationAngle = 250.0f;
 
     // Load Construction House model
-    buildings[3].model = LoadModel("buildings/constructionHouse.glb");
+    buildings[3].model = LoadModelAsset("buildings/constructionHouse.glb");
     if (buildings[3].model.meshCount == 0) TraceLog(LOG_ERROR, "Failed to load buildings/constructionHouse.glb");
     buildings[3].position = (Vector3){ -40.0f, 0.1f, 26.0f }; // Opposite direction of Bank from Barn
     buildings[3].scale = 3.8f; // Adjust scale as needed
     buildings[3].rotationAngle = 0.0f; // Adjust rotation as needed
 
     // Load FarmHouse model
-    buildings[4].model = LoadModel("buildings/FarmHouse.glb");
+    buildings[4].model = LoadModelAsset("buildings/FarmHouse.glb");
     if (buildings[4].model.meshCount == 0) TraceLog(LOG_ERROR, "Failed to load buildings/FarmHouse.glb");
     buildings[4].position = (Vector3){ -35.0f, 0.1f, 20.0f }; // Positioned near the constructionHouse
     buildings[4].scale = 0.5f; // Adjust scale as needed
     buildings[4].rotationAngle = 108.0f; // Adjust rotation as needed
 
     // Load Chicken Coop model in chicken enclosure
-    buildings[5].model = LoadModel("buildings/ChickenCoop.glb");
+    buildings[5].model = LoadModelAsset("buildings/ChickenCoop.glb");
     if (buildings[5].model.meshCount == 0) TraceLog(LOG_ERROR, "Failed to load buildings/ChickenCoop.glb");
     buildings[5].position = ENCLOSURE_CENTER_2; // Center of chicken enclosure
     buildings[5].scale = 1.0f; // Adjust scale as needed
     buildings[5].rotationAngle = 0.0f;
 
-    // Orient camera to look at the farmhouse initially
-    Vector3 farmhouseLookAtPosition = buildings[4].position;
-    farmhouseLookAtPosition.y = HUMAN_HEIGHT; // Keep camera target at human height
-    camera.target = farmhouseLookAtPosition;
-
-    // Initialize the human character
-    InitHuman(&human);
-    
-    // Set up human path from farmhouse to barn - with proper offsets and debug messages
-    Vector3 farmhousePosition = buildings[4].position;  // FarmHouse position
-    Vector3 barnPosition = buildings[0].position;       // Barn position
-    
-    // Make sure farmhouse and barn positions are far enough apart
-    float pathDistance = Vector3Distance(farmhousePosition, barnPosition);
-    TraceLog(LOG_INFO, "Distance between farmhouse and barn: %.2f units", pathDistance);
-    
-    // Offset start position to be in front of farmhouse
-    farmhousePosition.x += 3.0f; // Move 3 units out from the farmhouse
-    farmhousePosition.y = 0.3f;  // Set consistent height above ground
-    
-    // Offset end position to be more to the right of the barn
-    barnPosition.x += 15.0f;  // Increased from 2.0f to move further right
-    barnPosition.z += 5.0f;   // Also shift a bit forward for better visibility
-    barnPosition.y = 0.3f;
-    
-    // Reduce the path length by 60%
-    Vector3 pathVector = Vector3Subtract(barnPosition, farmhousePosition);
-    float originalDistance = Vector3Length(pathVector);
-    
-    // Calculate 40% of the original distance (reducing path by 60%)
-    float newDistance = originalDistance * 0.4f;
-    
-    // Update barn position to be 40% of the original distance from farmhouse
-    Vector3 direction = Vector3Normalize(pathVector);
-    barnPosition = Vector3Add(farmhousePosition, Vector3Scale(direction, newDistance));
-    
-    TraceLog(LOG_INFO, "Path shortened from %.2f to %.2f units (40%% of original)", 
-             originalDistance, newDistance);
-    
-    TraceLog(LOG_INFO, "About to setup human path from farmhouse (%.2f, %.2f, %.2f) to barn (%.2f, %.2f, %.2f)",
-             farmhousePosition.x, farmhousePosition.y, farmhousePosition.z,
-             barnPosition.x, barnPosition.y, barnPosition.z);
-    
-    // Set up the path for the human
-    SetupHumanPath(&human, farmhousePosition, barnPosition);
-    
-    // Extra failsafe to ensure the human is active and has good speed
-    human.active = true;
-    human.state = HUMAN_STATE_WALKING;
-    human.stateTimer = 0.0f; // Start timer at 0
-    human.showDialog = false; // No dialog initially
-    human.speed = 0.15f; // Reduced speed from 0.3f for slower movement
-    
-    // Make sure direction is properly set
-    if (Vector3Length(human.direction) < 0.1f) {
-        // If direction isn't set correctly, use a default direction
-        human.direction = (Vector3){ 1.0f, 0.0f, 0.0f }; // Default direction: right
-        human.rotationAngle = 90.0f; // Facing East
-        TraceLog(LOG_WARNING, "Human direction not properly set, using default");
-    }
-    
-    TraceLog(LOG_INFO, "Human setup complete - active=%d, state=%d, direction=(%.2f, %.2f, %.2f), speed=%.2f",
-             human.active, human.state, human.direction.x, human.direction.y, human.direction.z, human.speed);
-
     // Create animal enclosure using fences
     const float FENCE_MODEL_SCALE_CONST = 0.2f;
     const float ENCLOSURE_WIDTH = ENCLOSURE_WIDTH_1;  // Use the defined constant
@@ -2886,7 +4585,7 @@ int main(void)
     int fenceIndex = 6; // Start after existing buildings (including chicken coop)
 
     // Load fence model
-    Model fenceModel = LoadModel("buildings/Fence.glb");
+    Model fenceModel = LoadModelAsset("buildings/Fence.glb");
     if (fenceModel.meshCount == 0) {
         TraceLog(LOG_ERROR, "Failed to load buildings/Fence.glb");
     }
@@ -2944,72 +4643,543 @@ int main(void)
         fenceIndex++;
     }
 
-    // --- Second Animal Enclosure ---
-    Vector3 startPos2 = {
-        ENCLOSURE_CENTER_2.x - (ENCLOSURE_WIDTH_2 / 2.0f),
-        0.0f,
-        ENCLOSURE_CENTER_2.z - (ENCLOSURE_LENGTH_2 / 2.0f)
-    };
+    // --- Second Animal Enclosure ---
+    Vector3 startPos2 = {
+        ENCLOSURE_CENTER_2.x - (ENCLOSURE_WIDTH_2 / 2.0f),
+        0.0f,
+        ENCLOSURE_CENTER_2.z - (ENCLOSURE_LENGTH_2 / 2.0f)
+    };
+
+    int fenceIndex2 = fenceIndex; // Continue after the first enclosure
+
+    // Top side (left to right, moved even more to the right)
+    for (int i = 0; i <= (int)ENCLOSURE_WIDTH_2 + 1; i++) {
+        if (fenceIndex2 >= MAX_BUILDINGS) break;
+        buildings[fenceIndex2].model = fenceModel;
+        buildings[fenceIndex2].position = (Vector3){
+            startPos2.x - (2 * FENCE_SPACING) + (i * FENCE_SPACING) + (2 * FENCE_SPACING),
+            startPos2.y,
+            startPos2.z - FENCE_SPACING
+        };
+        buildings[fenceIndex2].scale = FENCE_MODEL_SCALE_CONST;
+        buildings[fenceIndex2].rotationAngle = 0.0f;
+        fenceIndex2++;
+    }
+
+    // Right side (top to bottom, moved further to the exterior)
+    for (int i = 0; i <= (int)ENCLOSURE_LENGTH_2; i++) {
+        if (fenceIndex2 >= MAX_BUILDINGS) break;
+        buildings[fenceIndex2].model = fenceModel;
+        buildings[fenceIndex2].position = (Vector3){
+            startPos2.x + ((ENCLOSURE_WIDTH_2 + 1) * FENCE_SPACING) + FENCE_SPACING,
+            startPos2.y,
+            startPos2.z + (i * FENCE_SPACING)
+        };
+        buildings[fenceIndex2].scale = FENCE_MODEL_SCALE_CONST;
+        buildings[fenceIndex2].rotationAngle = 90.0f;
+        fenceIndex2++;
+    }
+
+    // Bottom side (right to left, move lower, inwards, and further to the left)
+    for (int i = 0; i <= (int)ENCLOSURE_WIDTH_2 + 1; i++) {
+        if (fenceIndex2 >= MAX_BUILDINGS) break;
+        buildings[fenceIndex2].model = fenceModel;
+        buildings[fenceIndex2].position = (Vector3){
+            startPos2.x + FENCE_SPACING + ((ENCLOSURE_WIDTH_2 + 1) * FENCE_SPACING) - (i * FENCE_SPACING) - FENCE_SPACING,
+            startPos2.y,
+            startPos2.z + ((ENCLOSURE_LENGTH_2) * FENCE_SPACING) + FENCE_SPACING
+        };
+        buildings[fenceIndex2].scale = FENCE_MODEL_SCALE_CONST;
+        buildings[fenceIndex2].rotationAngle = 180.0f;
+        fenceIndex2++;
+    }
+
+    // Left side (top to bottom, move one position to the inside)
+    for (int i = 0; i <= (int)ENCLOSURE_LENGTH_2; i++) {
+        if (fenceIndex2 >= MAX_BUILDINGS) break;
+        buildings[fenceIndex2].model = fenceModel;
+        buildings[fenceIndex2].position = (Vector3){
+            startPos2.x - FENCE_SPACING,
+            startPos2.y,
+            startPos2.z + (i * FENCE_SPACING)
+        };
+        buildings[fenceIndex2].scale = FENCE_MODEL_SCALE_CONST;
+        buildings[fenceIndex2].rotationAngle = 270.0f;
+        fenceIndex2++;
+    }
+
+    fenceIndex = fenceIndex2; // Update main fenceIndex for any further buildings
+
+    // Simplified levels, the fences share the levels of their model
+    for (int i = 0; i < MAX_BUILDINGS; i++) {
+        buildings[i].lods = AcquireModelLods(buildings[i].model, TextFormat("building %d", i));
+    }
+}
+
+// Initialize the human guide and its walk from the farmhouse to the barn (path ends are kept for the H reset key)
+void SetupHumanGuide(Vector3 *pathStart, Vector3 *pathEnd) {
+    InitHuman(&human);
+    
+    // Set up human path from farmhouse to barn - with proper offsets and debug messages
+    Vector3 farmhousePosition = buildings[4].position;  // FarmHouse position
+    Vector3 barnPosition = buildings[0].position;       // Barn position
+    
+    // Make sure farmhouse and barn positions are far enough apart
+    float pathDistance = Vector3Distance(farmhousePosition, barnPosition);
+    TraceLog(LOG_INFO, "Distance between farmhouse and barn: %.2f units", pathDistance);
+    
+    // Offset start position to be in front of farmhouse
+    farmhousePosition.x += 3.0f; // Move 3 units out from the farmhouse
+    farmhousePosition.y = 0.3f;  // Set consistent height above ground
+    
+    // Offset end position to be more to the right of the barn
+    barnPosition.x += 15.0f;  // Increased from 2.0f to move further right
+    barnPosition.z += 5.0f;   // Also shift a bit forward for better visibility
+    barnPosition.y = 0.3f;
+    
+    // Reduce the path length by 60%
+    Vector3 pathVector = Vector3Subtract(barnPosition, farmhousePosition);
+    float originalDistance = Vector3Length(pathVector);
+    
+    // Calculate 40% of the original distance (reducing path by 60%)
+    float newDistance = originalDistance * 0.4f;
+    
+    // Update barn position to be 40% of the original distance from farmhouse
+    Vector3 direction = Vector3Normalize(pathVector);
+    barnPosition = Vector3Add(farmhousePosition, Vector3Scale(direction, newDistance));
+    
+    TraceLog(LOG_INFO, "Path shortened from %.2f to %.2f units (40%% of original)", 
+             originalDistance, newDistance);
+    
+    TraceLog(LOG_INFO, "About to setup human path from farmhouse (%.2f, %.2f, %.2f) to barn (%.2f, %.2f, %.2f)",
+             farmhousePosition.x, farmhousePosition.y, farmhousePosition.z,
+             barnPosition.x, barnPosition.y, barnPosition.z);
+    
+    // Set up the path for the human
+    SetupHumanPath(&human, farmhousePosition, barnPosition);
+    
+    // Extra failsafe to ensure the human is active and has good speed
+    human.active = true;
+    human.state = HUMAN_STATE_WALKING;
+    human.stateTimer = 0.0f; // Start timer at 0
+    human.showDialog = false; // No dialog initially
+    human.speed = 0.15f; // Reduced speed from 0.3f for slower movement
+    
+    // Make sure direction is properly set
+    if (Vector3Length(human.direction) < 0.1f) {
+        // If direction isn't set correctly, use a default direction
+        human.direction = (Vector3){ 1.0f, 0.0f, 0.0f }; // Default direction: right
+        human.rotationAngle = 90.0f; // Facing East
+        TraceLog(LOG_WARNING, "Human direction not properly set, using default");
+    }
+    
+    TraceLog(LOG_INFO, "Human setup complete - active=%d, state=%d, direction=(%.2f, %.2f, %.2f), speed=%.2f",
+             human.active, human.state, human.direction.x, human.direction.y, human.direction.z, human.speed);
+    human.prevPosition = human.position;
+    human.prevRotationAngle = human.rotationAngle;
+
+    *pathStart = farmhousePosition;
+    *pathEnd = barnPosition;
+}
+
+// Add a road from a point list, binning it into the road query grid
+void AddCustomRoad(const char *name, const Vector3 *points, int numPoints) {
+    if ((totalCustomRoadsCount >= MAX_CUSTOM_ROADS) || (numPoints < 2)) return;
+    if (numPoints > MAX_PATH_POINTS) numPoints = MAX_PATH_POINTS;
+
+    CustomRoad* newRoad = &allCustomRoads[totalCustomRoadsCount];
+    snprintf(newRoad->name, sizeof(newRoad->name), "%s", name);
+    newRoad->numPoints = numPoints;
+    // Use memcpy to copy the points array
+    memcpy(newRoad->points, points, sizeof(Vector3) * newRoad->numPoints);
+    // Use individual segments to create the road path
+    GenerateRoadSegments(newRoad, roadWidth, roadTexture);
+    totalCustomRoadsCount++; // Increment the count of active roads
+    TraceLog(LOG_INFO, "Created road '%s' with %d points", newRoad->name, newRoad->numPoints);
+}
+
+// Add a random winding road across the farm, for scenarios asking for more than the authored roads
+void AddRandomRoad(const char *name) {
+    Vector3 points[SCENARIO_ROAD_POINTS];
+    points[0] = (Vector3){ (float)GetRandomValue(-90, 90), 0.15f, (float)GetRandomValue(-90, 90) };
+    float heading = GetRandomValue(0, 360)*DEG2RAD;
+    for (int i = 1; i < SCENARIO_ROAD_POINTS; i++) {
+        heading += GetRandomValue(-20, 20)*DEG2RAD;
+        // Turn back at the edge of the farm area
+        Vector3 ahead = { points[i - 1].x + cosf(heading)*SCENARIO_ROAD_STEP, 0.15f, points[i - 1].z + sinf(heading)*SCENARIO_ROAD_STEP };
+        if ((fabsf(ahead.x) > 100.0f) || (fabsf(ahead.z) > 100.0f)) heading += PI;
+        points[i] = (Vector3){ points[i - 1].x + cosf(heading)*SCENARIO_ROAD_STEP, 0.15f, points[i - 1].z + sinf(heading)*SCENARIO_ROAD_STEP };
+    }
+    AddCustomRoad(name, points, SCENARIO_ROAD_POINTS);
+}
+
+// Create the custom roads, binning each one into the road query grid: the authored roads first,
+// scenarios asking for more roads get random ones
+void SetupCustomRoads(void) {
+    // Roads are binned into the query grid as they are generated
+    InitRoadGrid(FIXED_TERRAIN_SIZE + 2*CHUNK_SIZE, ROAD_GRID_CELL_SIZE, ROAD_GRID_MAX_QUERY_DISTANCE);
+
+    const char *roadNames[DEFAULT_ROAD_COUNT] = { Farm_Entrance_name, secondRoadName, thirdRoadName, fourthRoadName, fifthRoadName };
+    const Vector3 *roadPoints[DEFAULT_ROAD_COUNT] = { Farm_Entrance_points, secondRoadPoints, thirdRoadPoints, fourthRoadPoints, fifthRoadPoints };
+    const int roadPointCounts[DEFAULT_ROAD_COUNT] = { Farm_Entrance_numPoints, secondRoadNumPoints, thirdRoadNumPoints,
+                                                      fourthRoadNumPoints, fifthRoadNumPoints };
+
+    int roadCount = GetScenarioCount(&scenario, "roads", DEFAULT_ROAD_COUNT);
+    if (roadCount > MAX_CUSTOM_ROADS) {
+        TraceLog(LOG_WARNING, "SCENARIO: %d roads requested, only %d fit", roadCount, MAX_CUSTOM_ROADS);
+        roadCount = MAX_CUSTOM_ROADS;
+    }
+    for (int i = 0; i < roadCount; i++) {
+        if (i < DEFAULT_ROAD_COUNT) AddCustomRoad(roadNames[i], roadPoints[i], roadPointCounts[i]);
+        else AddRandomRoad(TextFormat("Scenario Road %d", i + 1));
+    }
+}
+
+// Scatter the scenario's plants over the terrain, then clear the ones blocking roads (roads must exist)
+void SpawnInitialPlants(void) {
+    for (int t = 0; t < PLANT_TYPE_COUNT; t++) {
+        SpawnRandomPlants((PlantType)t, GetScenarioCount(&scenario, plantScenarioKeys[t], defaultPlantCounts[t]));
+    }
+
+    // Clear any plants that might be blocking roads
+    ClearPlantsNearRoads(3.0f);
+}
+
+// --- Startup Loading ---
+#define ASSET_LOADER_WORKERS 4
+#define ASSET_UPLOAD_TIME_SLICE 0.008   // Seconds of GPU uploads per loading screen frame
+
+// Queue every asset main() loads at startup, in the order they are used
+void RequestStartupAssets(void) {
+    RequestAsset("textures/rocky_terrain_02_diff_8k.jpg", ASSET_TEXTURE);
+    RequestAsset("textures/rocky_trail_diff_8k.jpg", ASSET_TEXTURE);
+    RequestAsset("inventory/food.png", ASSET_TEXTURE);
+    RequestAsset("inventory/egg.png", ASSET_TEXTURE);
+    RequestAsset("inventory/milk.png", ASSET_TEXTURE);
+    RequestAsset("inventory/steak.png", ASSET_TEXTURE);
+
+    RequestAsset("humans/walking_character.glb", ASSET_ANIMATED_MODEL);
+    RequestAsset("humans/idle_character.glb", ASSET_ANIMATED_MODEL);
+    RequestAsset("humans/looking_character.glb", ASSET_ANIMATED_MODEL);
+
+    RequestAsset("plants/tree.glb", ASSET_MODEL);
+    RequestAsset("plants/grass.glb", ASSET_MODEL);
+    RequestAsset("plants/flower.glb", ASSET_MODEL);
+    RequestAsset("plants/flower2.glb", ASSET_MODEL);
+    RequestAsset("plants/bushWithFlowers.glb", ASSET_MODEL);
+
+    // Every species is pre-spawned, see AcquireAnimalAssets()
+    for (int i = 0; i < ANIMAL_COUNT; i++) {
+        RequestAsset(TextFormat("animals/walking_%s.glb", animalAssetNames[i]), ASSET_ANIMATED_MODEL);
+        RequestAsset(TextFormat("animals/idle_%s.glb", animalAssetNames[i]), ASSET_ANIMATED_MODEL);
+    }
+
+    RequestAsset("buildings/barn.glb", ASSET_MODEL);
+    RequestAsset("buildings/horse_barn.glb", ASSET_MODEL);
+    RequestAsset("buildings/Bank.glb", ASSET_MODEL);
+    RequestAsset("buildings/constructionHouse.glb", ASSET_MODEL);
+    RequestAsset("buildings/FarmHouse.glb", ASSET_MODEL);
+    RequestAsset("buildings/ChickenCoop.glb", ASSET_MODEL);
+    RequestAsset("buildings/Fence.glb", ASSET_MODEL);
+
+    const char *soundNames[] = { "horse", "cat", "dog", "cow", "pig", "chicken" };
+    for (int i = 0; i < 6; i++) RequestAsset(TextFormat("sounds/%s.mp3", soundNames[i]), ASSET_SOUND);
+}
+
+// Function to draw the loading screen shown while the startup assets load
+void DrawLoadingScreen(float progress) {
+    int screenWidth = GetScreenWidth();
+    int screenHeight = GetScreenHeight();
+
+    BeginDrawing();
+    ClearBackground(BLACK);
+
+    const char* titleText = "Loading Grandpa's Farm...";
+    int titleFontSize = 40;
+    DrawText(titleText, screenWidth/2 - MeasureText(titleText, titleFontSize)/2, screenHeight/2 - 80, titleFontSize, WHITE);
+
+    int barWidth = screenWidth/3;
+    int barHeight = 24;
+    int barX = screenWidth/2 - barWidth/2;
+    int barY = screenHeight/2;
+    DrawRectangle(barX, barY, (int)(barWidth*progress), barHeight, DARKGREEN);
+    DrawRectangleLines(barX, barY, barWidth, barHeight, LIGHTGRAY);
+
+    const char* percentText = TextFormat("%i%%", (int)(progress*100.0f));
+    DrawText(percentText, screenWidth/2 - MeasureText(percentText, 20)/2, barY + barHeight + 15, 20, LIGHTGRAY);
+
+    EndDrawing();
+}
+
+#if defined(FARM_HEADLESS)
+// --- Headless Simulation ---
+// Built by the <workspace>_headless target: no window, GL context or audio device, every asset
+// comes back empty (see asset_loader.c) and only the simulation steps run, back to back
+
+#define HEADLESS_DEFAULT_TICKS 36000           // 10 simulated minutes
+#define HEADLESS_TIMESTEP SIMULATION_TIMESTEP
+
+// Play the farmer the headless simulation has no player for: feed the farm animals from the barn
+// at half hunger (buying food when it runs short), collect their products and sell them
+void UpdateHeadlessFarmer(void) {
+    const AnimalType farmAnimals[] = { ANIMAL_CHICKEN, ANIMAL_PIG, ANIMAL_COW };
+    for (int i = 0; i < 3; i++) {
+        AnimalType type = farmAnimals[i];
+        int count = animalCountByType[type];
+        if (count == 0) continue;
+
+        if (animalStats[type].hunger <= 50.0f) {
+            while (barnStorage.food < count && playerCoins >= PRICE_FOOD_BUY * 50) BuyFood();
+            if (barnStorage.food >= count) {
+                while (playerInventory.quantity < count && TakeFoodFromBarn()) { }
+                FeedAnimals(type);
+                if (playerInventory.type == ITEM_FOOD) StoreInventoryInBarn(ITEM_FOOD); // Leftovers go back
+            }
+        }
+
+        if (animalStats[type].productReady && CollectAnimalProducts(type)) {
+            InventoryItemType item = playerInventory.type;
+            StoreInventoryInBarn(item);
+            SellBarnProduct(item);
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    InitLogBackend();
+
+    // --ticks N: simulation steps to run, --seed S: fixed random seed for a repeatable run
+    // --scenario <file>, --set "<line>": entity counts and ramps (see scenario.h)
+    // --threads N: job pool workers besides the main thread (default: one per extra core), the result doesn't depend on it
+    int ticks = HEADLESS_DEFAULT_TICKS;
+    int jobWorkers = -1;
+    for (int i = 1; i < argc; i++) {
+        if ((strcmp(argv[i], "--ticks") == 0) && (i + 1 < argc)) ticks = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "--threads") == 0) && (i + 1 < argc)) jobWorkers = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "--seed") == 0) && (i + 1 < argc)) SetRandomSeed((unsigned int)strtoul(argv[++i], NULL, 10));
+        else if (((strcmp(argv[i], "--scenario") == 0) || (strcmp(argv[i], "--set") == 0)) && (i + 1 < argc)) i++; // See LoadScenarioFromArgs()
+        else TraceLog(LOG_WARNING, "Unknown command line argument: %s", argv[i]);
+    }
+    LoadScenarioFromArgs(argc, argv);
+    InitJobSystem(jobWorkers);
+
+    // Same world as the game, spawned around the player start
+    Camera camera = { 0 };
+    camera.position = (Vector3){ 0.0f, HUMAN_HEIGHT, 0.0f };
+
+    InitAnimalStats();
+    InitScenarioEntityPools();
+    InitCollisionGrids();
+    if (scenario.seed != 0) SetRandomSeed(scenario.seed);
+    SpawnInitialAnimals(camera);
+    SetupBuildings();
+    Vector3 farmhousePosition = { 0 };
+    Vector3 barnPosition = { 0 };
+    SetupHumanGuide(&farmhousePosition, &barnPosition);
+    SetupCustomRoads();
+    SpawnInitialPlants();
+    RegisterStaticColliders();
+
+    TraceLog(LOG_INFO, "HEADLESS: Simulating %d ticks of %.4f s (%d animals, %d plants) on %d threads", ticks, HEADLESS_TIMESTEP,
+             animalCount, plantCount, GetJobThreadCount());
+
+    double startTime = GetTime();
+    for (int tick = 0; tick < ticks; tick++) {
+        StepSimulation();
+        UpdateHeadlessFarmer();
+    }
+    double elapsed = GetTime() - startTime;
+
+    TraceLog(LOG_INFO, "HEADLESS: %d ticks (%.0f s simulated) in %.3f s, %.0f ticks/s", ticks, ticks*HEADLESS_TIMESTEP,
+             elapsed, (elapsed > 0.0) ? ticks/elapsed : 0.0);
+    TraceLog(LOG_INFO, "HEADLESS: Scenario '%s' ended with %d animals, %d plants", scenario.name, animalCount, plantCount);
+    TraceLog(LOG_INFO, "HEADLESS: Coins %.0f, barn food %d, eggs %d, milk %d, steak %d", playerCoins,
+             barnStorage.food, barnStorage.eggs, barnStorage.milk, barnStorage.steak);
+
+    UnloadCollisionGrids();
+    UnloadRoadGrid();
+    UnloadEntityPools();
+    UnloadJobSystem();
+    CloseLogBackend();
+    return 0;
+}
+#elif !defined(FARM_BENCH) // The bench target includes this file and brings its own main()
+int main(int argc, char *argv[])
+{
+    // Console output runs on a writer thread from the first message on
+    InitLogBackend();
+
+    // --trace: capture a Chrome trace from startup (loading included) until F5 or exit
+    // --benchmark <path file>: replay a camera path at a fixed timestep and write a frame report, then exit
+    // --seed S: random seed of the benchmark run
+    // --scenario <file>, --set "<line>": entity counts and ramps (see scenario.h)
+    // --time-scale S: start the farm at S times real time (0 starts paused)
+    // --threads N: job pool workers besides the main thread (default: one per extra core)
+    // --impostor-distance D: camera distance where trees and bushes turn into billboards
+    bool traceFromStartup = false;
+    int jobWorkers = -1;
+    const char *flythroughPathFile = NULL;
+    unsigned int flythroughSeed = FLYTHROUGH_SEED;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--trace") == 0) traceFromStartup = true;
+        else if ((strcmp(argv[i], "--benchmark") == 0) && (i + 1 < argc)) flythroughPathFile = argv[++i];
+        else if ((strcmp(argv[i], "--seed") == 0) && (i + 1 < argc)) flythroughSeed = (unsigned int)strtoul(argv[++i], NULL, 10);
+        else if (((strcmp(argv[i], "--scenario") == 0) || (strcmp(argv[i], "--set") == 0)) && (i + 1 < argc)) i++; // See LoadScenarioFromArgs()
+        else if ((strcmp(argv[i], "--time-scale") == 0) && (i + 1 < argc)) timeScale = fmaxf(0.0f, (float)atof(argv[++i]));
+        else if ((strcmp(argv[i], "--threads") == 0) && (i + 1 < argc)) jobWorkers = atoi(argv[++i]);
+        else if ((strcmp(argv[i], "--impostor-distance") == 0) && (i + 1 < argc)) impostorDistance = fmaxf(0.5f*IMPOSTOR_FADE_BAND, (float)atof(argv[++i]));
+        else TraceLog(LOG_WARNING, "Unknown command line argument: %s", argv[i]);
+    }
+
+    // const int screenWidth = 1512;
+    // const int screenHeight = 1080;
+    int currentMonitor = GetCurrentMonitor();
+    const int screenWidth = GetMonitorWidth(currentMonitor);
+    const int screenHeight = GetMonitorHeight(currentMonitor);
+
+    InitWindow(screenWidth, screenHeight, "VR Farming Simulator");
+    rlSetClipPlanes(1.0, 1500.0); // Adjust near/far clip planes for better depth precision
+
+    // Trace timestamps come from GetTime(), so capturing can only start once the window exists
+    SetTraceThreadName("Main thread");
+    if (traceFromStartup) StartTraceCapture();
+
+    // Benchmark runs replay identically: fixed seed (InitWindow() seeds from the clock), GL draws counted
+    if (flythroughPathFile != NULL) {
+        SetRandomSeed(flythroughSeed);
+        InitRenderStats();
+    }
+
+    // Define the camera
+    Camera camera = {0};
+    camera.position = (Vector3){0.0f, HUMAN_HEIGHT, 0.0f}; // Set camera at human height
+    camera.target = (Vector3){0.0f, HUMAN_HEIGHT, 1.0f};   // Look forward (will be updated)
+    camera.up = (Vector3){0.0f, 1.0f, 0.0f};
+    camera.fovy = 60.0f;
+    camera.projection = CAMERA_PERSPECTIVE;
+
+    int cameraMode = CAMERA_FIRST_PERSON; // Default to first person
+
+    // Update the texture loading part of your code
+    SearchAndSetResourceDir("resources");
+
+    // Camera paths and reports live in the working directory (resources/), like the E key export
+    CameraPath flythroughPath = { 0 };
+    if (flythroughPathFile != NULL) {
+        flythroughPath = LoadCameraPath(flythroughPathFile);
+        if (flythroughPath.count == 0) TraceLog(LOG_WARNING, "FLYTHROUGH: [%s] No camera path, benchmark disabled", flythroughPathFile);
+    }
+    bool flythroughMode = (flythroughPath.count > 0);
+    if (flythroughMode) timeScale = 1.0f; // One simulation step per benchmark frame
+
+    // Scenario files are read from the working directory too
+    LoadScenarioFromArgs(argc, argv);
+
+    // Load the startup assets in the background: workers read and decode the files while
+    // the main thread uploads the finished ones in time slices between loading screen frames
+    InitAssetLoader(ASSET_LOADER_WORKERS);
+    InitJobSystem(jobWorkers);
+    RequestStartupAssets();
+    while (!IsAssetLoaderDone() && !WindowShouldClose()) {
+        UpdateAssetLoader(ASSET_UPLOAD_TIME_SLICE);
+        DrawLoadingScreen(GetAssetLoaderProgress());
+    }
+    TraceLog(LOG_INFO, "STARTUP: Assets loaded %.2f s after window creation", GetTime());
+
+    // Change the filename to match your downloaded texture
+    Texture2D terrainTexture = LoadTextureAsset("textures/rocky_terrain_02_diff_8k.jpg");
+
+    // Load road texture
+    roadTexture = LoadTextureAsset("textures/rocky_trail_diff_8k.jpg"); // Initialize global roadTexture
+    if (roadTexture.id == 0) { // Check if road texture failed to load
+        TraceLog(LOG_ERROR, "Failed to load road texture: textures/rocky_trail_diff_8k.jpg");
+    }
+    
+    // Load inventory item textures
+    inventoryItemTextures[ITEM_FOOD] = LoadTextureAsset("inventory/food.png");
+    inventoryItemTextures[ITEM_EGG] = LoadTextureAsset("inventory/egg.png");
+    inventoryItemTextures[ITEM_MILK] = LoadTextureAsset("inventory/milk.png");
+    inventoryItemTextures[ITEM_STEAK] = LoadTextureAsset("inventory/steak.png");
+    
+    // Log loading of textures
+    TraceLog(LOG_INFO, "Loading inventory textures:");
+    TraceLog(LOG_INFO, "- Food texture ID: %d", inventoryItemTextures[ITEM_FOOD].id);
+    TraceLog(LOG_INFO, "- Egg texture ID: %d", inventoryItemTextures[ITEM_EGG].id);
+    TraceLog(LOG_INFO, "- Milk texture ID: %d", inventoryItemTextures[ITEM_MILK].id);
+    TraceLog(LOG_INFO, "- Steak texture ID: %d", inventoryItemTextures[ITEM_STEAK].id);
+    
+    // Check if textures loaded successfully
+    for (int i = 0; i < ITEM_TYPE_COUNT; i++) {
+        if (inventoryItemTextures[i].id == 0) {
+            TraceLog(LOG_WARNING, "Failed to load texture for item type %s", inventoryItemNames[i]);
+        }
+    }
+    
+    InitAnimalStats();
+
+    // Optimize texture quality for terrain
+    SetTextureFilter(terrainTexture, TEXTURE_FILTER_ANISOTROPIC_16X);
+    SetTextureWrap(terrainTexture, TEXTURE_WRAP_REPEAT);
 
-    int fenceIndex2 = fenceIndex; // Continue after the first enclosure
+    // Optimize texture quality for road
+    SetTextureFilter(roadTexture, TEXTURE_FILTER_ANISOTROPIC_16X);
+    SetTextureWrap(roadTexture, TEXTURE_WRAP_REPEAT);
 
-    // Top side (left to right, moved even more to the right)
-    for (int i = 0; i <= (int)ENCLOSURE_WIDTH_2 + 1; i++) {
-        if (fenceIndex2 >= MAX_BUILDINGS) break;
-        buildings[fenceIndex2].model = fenceModel;
-        buildings[fenceIndex2].position = (Vector3){
-            startPos2.x - (2 * FENCE_SPACING) + (i * FENCE_SPACING) + (2 * FENCE_SPACING),
-            startPos2.y,
-            startPos2.z - FENCE_SPACING
-        };
-        buildings[fenceIndex2].scale = FENCE_MODEL_SCALE_CONST;
-        buildings[fenceIndex2].rotationAngle = 0.0f;
-        fenceIndex2++;
-    }
+    // The fog shader is needed by everything created from here on
+    InitFog();
 
-    // Right side (top to bottom, moved further to the exterior)
-    for (int i = 0; i <= (int)ENCLOSURE_LENGTH_2; i++) {
-        if (fenceIndex2 >= MAX_BUILDINGS) break;
-        buildings[fenceIndex2].model = fenceModel;
-        buildings[fenceIndex2].position = (Vector3){
-            startPos2.x + ((ENCLOSURE_WIDTH_2 + 1) * FENCE_SPACING) + FENCE_SPACING,
-            startPos2.y,
-            startPos2.z + (i * FENCE_SPACING)
-        };
-        buildings[fenceIndex2].scale = FENCE_MODEL_SCALE_CONST;
-        buildings[fenceIndex2].rotationAngle = 90.0f;
-        fenceIndex2++;
-    }
+    // Initialize all terrain chunks at once with fixed layout
+    InitAllTerrainChunks(terrainTexture);
+    
+    // Allocate the animal, plant and cloud pools for the scenario
+    InitScenarioEntityPools();
 
-    // Bottom side (right to left, move lower, inwards, and further to the left)
-    for (int i = 0; i <= (int)ENCLOSURE_WIDTH_2 + 1; i++) {
-        if (fenceIndex2 >= MAX_BUILDINGS) break;
-        buildings[fenceIndex2].model = fenceModel;
-        buildings[fenceIndex2].position = (Vector3){
-            startPos2.x + FENCE_SPACING + ((ENCLOSURE_WIDTH_2 + 1) * FENCE_SPACING) - (i * FENCE_SPACING) - FENCE_SPACING,
-            startPos2.y,
-            startPos2.z + ((ENCLOSURE_LENGTH_2) * FENCE_SPACING) + FENCE_SPACING
-        };
-        buildings[fenceIndex2].scale = FENCE_MODEL_SCALE_CONST;
-        buildings[fenceIndex2].rotationAngle = 180.0f;
-        fenceIndex2++;
-    }
+    // --- Load Global Plant Models ---
+    // Ensure these paths are correct and models exist
+    globalTreeModel = LoadModelAsset("plants/tree.glb");
+    if (globalTreeModel.meshCount == 0) TraceLog(LOG_ERROR, "Failed to load tree.glb");
 
-    // Left side (top to bottom, move one position to the inside)
-    for (int i = 0; i <= (int)ENCLOSURE_LENGTH_2; i++) {
-        if (fenceIndex2 >= MAX_BUILDINGS) break;
-        buildings[fenceIndex2].model = fenceModel;
-        buildings[fenceIndex2].position = (Vector3){
-            startPos2.x - FENCE_SPACING,
-            startPos2.y,
-            startPos2.z + (i * FENCE_SPACING)
-        };
-        buildings[fenceIndex2].scale = FENCE_MODEL_SCALE_CONST;
-        buildings[fenceIndex2].rotationAngle = 270.0f;
-        fenceIndex2++;
-    }
+    globalGrassModel = LoadModelAsset("plants/grass.glb");
+    if (globalGrassModel.meshCount == 0) TraceLog(LOG_ERROR, "Failed to load grass.glb");
 
-    fenceIndex = fenceIndex2; // Update main fenceIndex for any further buildings
+    globalFlowerModel = LoadModelAsset("plants/flower.glb");
+    if (globalFlowerModel.meshCount == 0) TraceLog(LOG_ERROR, "Failed to load flower.glb");
+
+    globalFlowerModel_type2 = LoadModelAsset("plants/flower2.glb");
+    if (globalFlowerModel_type2.meshCount == 0) TraceLog(LOG_ERROR, "Failed to load flower2.glb");
+
+    globalBushWithFlowersModel = LoadModelAsset("plants/bushWithFlowers.glb"); // Load new bush model
+    if (globalBushWithFlowersModel.meshCount == 0) TraceLog(LOG_ERROR, "Failed to load bushWithFlowers.glb");
+
+    for (int t = 0; t < PLANT_TYPE_COUNT; t++) plantLods[t] = AcquireModelLods(*GetPlantModel((PlantType)t), TextFormat("plant type %d", t));
+    // --- End Load Global Plant Models ---
+
+    // Skinning shader must be ready before any animated model is loaded
+    InitSkinningShader();
+
+    // Collision grids must exist before the first animal is spawned
+    InitCollisionGrids();
+
+    // Scenario spawns repeat exactly with a seed, whatever ran before
+    if (scenario.seed != 0) SetRandomSeed(scenario.seed);
+    SpawnInitialAnimals(camera);
+    SetupBuildings();
+
+    // Orient camera to look at the farmhouse initially
+    Vector3 farmhouseLookAtPosition = buildings[4].position;
+    farmhouseLookAtPosition.y = HUMAN_HEIGHT; // Keep camera target at human height
+    camera.target = farmhouseLookAtPosition;
+
+    // Initialize the human character
+    Vector3 farmhousePosition = { 0 };
+    Vector3 barnPosition = { 0 };
+    SetupHumanGuide(&farmhousePosition, &barnPosition);
+
+    // Buildings are static from here on, fog them, cache their bounds for culling and merge their meshes
+    for (int i = 0; i < MAX_BUILDINGS; i++) ApplyFogShader(&buildings[i].model);
+    UpdateBuildingBounds();
+    BuildStaticWorld();
 
     // Load nature scene model
     // Model natureSceneModel = LoadModel("scenes/nature&mountains.glb");
@@ -3022,120 +5192,30 @@ int main(void)
     // float natureSceneScale2 = 1.0f;
 
     // --- Custom Road Initialization ---
-    // Example: Creating a custom road from the farm entrance points
-    if (totalCustomRoadsCount < MAX_CUSTOM_ROADS && Farm_Entrance_numPoints > 1) {
-        CustomRoad* newRoad = &allCustomRoads[totalCustomRoadsCount];
-        snprintf(newRoad->name, sizeof(newRoad->name), "%s", Farm_Entrance_name);
-        newRoad->numPoints = Farm_Entrance_numPoints;
-        // Use memcpy to copy the points array
-        memcpy(newRoad->points, Farm_Entrance_points, sizeof(Vector3) * newRoad->numPoints);
-        // Use individual segments to create the road path
-        GenerateRoadSegments(newRoad, roadWidth, roadTexture);
-        totalCustomRoadsCount++; // Increment the count of active roads
-        TraceLog(LOG_INFO, "Created road '%s' with %d points", newRoad->name, newRoad->numPoints);
-    }
-
-    // Add the second road
-    if (totalCustomRoadsCount < MAX_CUSTOM_ROADS && secondRoadNumPoints > 1) {
-        CustomRoad* newRoad = &allCustomRoads[totalCustomRoadsCount];
-        snprintf(newRoad->name, sizeof(newRoad->name), "%s", secondRoadName);
-        newRoad->numPoints = secondRoadNumPoints;
-        // Use memcpy to copy the points array
-        memcpy(newRoad->points, secondRoadPoints, sizeof(Vector3) * newRoad->numPoints);
-        // Use individual segments to create the road path
-        GenerateRoadSegments(newRoad, roadWidth, roadTexture);
-        totalCustomRoadsCount++; // Increment the count of active roads
-        TraceLog(LOG_INFO, "Created road '%s' with %d points", newRoad->name, newRoad->numPoints);
-    }
-
-    if (totalCustomRoadsCount < MAX_CUSTOM_ROADS && thirdRoadNumPoints > 1) {
-        CustomRoad* newRoad = &allCustomRoads[totalCustomRoadsCount];
-        snprintf(newRoad->name, sizeof(newRoad->name), "%s", thirdRoadName);
-        newRoad->numPoints = thirdRoadNumPoints;
-        // Use memcpy to copy the points array
-        memcpy(newRoad->points, thirdRoadPoints, sizeof(Vector3) * newRoad->numPoints);
-        // Use individual segments to create the road path
-        GenerateRoadSegments(newRoad, roadWidth, roadTexture);
-        totalCustomRoadsCount++; // Increment the count of active roads
-        TraceLog(LOG_INFO, "Created road '%s' with %d points", newRoad->name, newRoad->numPoints);
-    }
-
-    // Add the fourth road
-    if (totalCustomRoadsCount < MAX_CUSTOM_ROADS && fourthRoadNumPoints > 1) {
-        CustomRoad* newRoad = &allCustomRoads[totalCustomRoadsCount];
-        snprintf(newRoad->name, sizeof(newRoad->name), "%s", fourthRoadName);
-        newRoad->numPoints = fourthRoadNumPoints;
-        // Use memcpy to copy the points array
-        memcpy(newRoad->points, fourthRoadPoints, sizeof(Vector3) * newRoad->numPoints);
-        // Use individual segments to create the road path
-        GenerateRoadSegments(newRoad, roadWidth, roadTexture);
-        totalCustomRoadsCount++; // Increment the count of active roads
-        TraceLog(LOG_INFO, "Created road '%s' with %d points", newRoad->name, newRoad->numPoints);
-    }
-
-    // Add the fifth road
-    if (totalCustomRoadsCount < MAX_CUSTOM_ROADS && fifthRoadNumPoints > 1) {
-        CustomRoad* newRoad = &allCustomRoads[totalCustomRoadsCount];
-        snprintf(newRoad->name, sizeof(newRoad->name), "%s", fifthRoadName);
-        newRoad->numPoints = fifthRoadNumPoints;
-        // Use memcpy to copy the points array
-        memcpy(newRoad->points, fifthRoadPoints, sizeof(Vector3) * newRoad->numPoints);
-        // Use individual segments to create the road path
-        GenerateRoadSegments(newRoad, roadWidth, roadTexture);
-        totalCustomRoadsCount++; // Increment the count of active roads
-        TraceLog(LOG_INFO, "Created road '%s' with %d points", newRoad->name, newRoad->numPoints);
-    }
-    
-    // Spawn plants (numbers increased)
-    int numberOfTrees = NUMBER_OF_TREES; // Increased from 50
-    for (int i = 0; i < numberOfTrees; i++) {
-        Vector3 pos = GetRandomPlantPosition(FIXED_TERRAIN_SIZE);
-        float scale = GetRandomValue(80, 150) / 100.0f; // Random scale between 0.8 and 1.5
-        float rotation = GetRandomValue(0, 360);
-        SpawnPlant(PLANT_TREE, pos, scale, rotation);
-    }
-
-    int numberOfGrassPatches = NUMBER_OF_GRASS; // Increased from 100
-    for (int i = 0; i < numberOfGrassPatches; i++) {
-        Vector3 pos = GetRandomPlantPosition(FIXED_TERRAIN_SIZE);
-        float scale = GetRandomValue(50, 120) / 100.0f; // Random scale
-        float rotation = GetRandomValue(0, 360);
-        SpawnPlant(PLANT_GRASS, pos, scale, rotation);
-    }
-
-    int numberOfFlowers = NUMBER_OF_FLOWERS; // Increased from 80
-    for (int i = 0; i < numberOfFlowers; i++) {
-        Vector3 pos = GetRandomPlantPosition(FIXED_TERRAIN_SIZE);
-        float scale = GetRandomValue(70, 130) / 100.0f; // Random scale
-        float rotation = GetRandomValue(0, 360);
-        SpawnPlant(PLANT_FLOWER, pos, scale, rotation);
-    }
+    SetupCustomRoads();
 
-    int numberOfFlowerType2 = NUMBER_OF_FLOWER_TYPE2; // Added for new flower type
-    for (int i = 0; i < numberOfFlowerType2; i++) {
-        Vector3 pos = GetRandomPlantPosition(FIXED_TERRAIN_SIZE);
-        float scale = 0.003f; // Set fixed scale to 0.005f
-        float rotation = GetRandomValue(0, 360);
-        SpawnPlant(PLANT_FLOWER_TYPE2, pos, scale, rotation);
-    }
+    // Spawn plants (numbers increased)
+    SpawnInitialPlants();
 
-    int numberOfBushWithFlowers = NUMBER_OF_BUSH_WITH_FLOWERS;
-    for (int i = 0; i < numberOfBushWithFlowers; i++) {
-        Vector3 pos = GetRandomPlantPosition(FIXED_TERRAIN_SIZE);
-        float scale = GetRandomValue(80, 120) / 100.0f; // Random scale 0.8 to 1.2
-        float rotation = GetRandomValue(0, 360);
-        SpawnPlant(PLANT_BUSH_WITH_FLOWERS, pos, scale, rotation);
-    }
+    // Group the surviving plants into per-type instance buffers
+    InitVegetationRenderer();
+    InitImpostors();
+    BuildVegetationBatches();
 
-    // Clear any plants that might be blocking roads
-    ClearPlantsNearRoads(3.0f);
+    // Buildings and the surviving trees are static from here on
+    RegisterStaticColliders();
 
-    // Initialize the cloud system
+    // Initialize the cloud system (baked into static chunks) and the sky dome
     InitClouds(FIXED_TERRAIN_SIZE);
+    InitCloudRenderer();
+    InitSky();
 
     // Load animal sounds
     LoadAnimalSounds();
 
+    // Every startup asset has been taken, free the decoded sounds and stop the workers
+    UnloadAssetLoader();
+
     // Generate random columns for visualization
     float heights[MAX_COLUMNS] = {0};
     Vector3 positions[MAX_COLUMNS] = {0};
@@ -3149,22 +5229,61 @@ int main(void)
     }
 
     DisableCursor();
-    SetTargetFPS(60);
+    SetTargetFPS(flythroughMode ? 0 : 60); // Benchmark frames run unthrottled
+
+    bool firstFrameDrawn = false;
+    float resumeTimeScale = 1.0f; // Speed F6 resumes at
+
+    // Benchmark frames: warmup at the path start, then one measured frame per timestep until the path end
+    int flythroughFrame = 0;
+    int flythroughFrameCount = 0;
+    double flythroughFrameStart = 0.0;
+    if (flythroughMode) {
+        flythroughFrameCount = (int)ceilf(flythroughPath.length/(FLYTHROUGH_CAMERA_SPEED*FLYTHROUGH_TIMESTEP)) + 1;
+        BeginFlythroughReport(flythroughFrameCount);
+        TraceLog(LOG_INFO, "FLYTHROUGH: Replaying %d frames (seed %u)", flythroughFrameCount, flythroughSeed);
+    }
 
     while (!WindowShouldClose())
     {
+        // Flythrough: record the frame that just ended, stop after the last one
+        if (flythroughMode) {
+            double now = GetTime();
+            if (flythroughFrame > FLYTHROUGH_WARMUP_FRAMES) {
+                RecordFlythroughFrame((FlythroughFrame){ (float)((now - flythroughFrameStart)*1000.0), GetRenderDrawCalls(), GetRenderTriangles() });
+            }
+            if (flythroughFrame == FLYTHROUGH_WARMUP_FRAMES + flythroughFrameCount) {
+                ExportFlythroughReport(FLYTHROUGH_REPORT_FILE, flythroughPathFile, flythroughSeed, FLYTHROUGH_TIMESTEP);
+                break;
+            }
+            flythroughFrameStart = now;
+            ResetRenderStats();
+        }
+
+        // Real time of the frame, the benchmark runs exactly one simulation step per frame
+        float frameDelta = flythroughMode ? FLYTHROUGH_TIMESTEP : GetFrameTime();
+
+        BeginProfileFrame();
+        BeginProfileZone(PROFILE_ZONE_UPDATE);
+
         // Update camera
-        UpdateCameraCustom(&camera, cameraMode);
+        BeginProfileZone(PROFILE_ZONE_CAMERA);
+        if (flythroughMode) {
+            int measuredFrame = (flythroughFrame > FLYTHROUGH_WARMUP_FRAMES) ? flythroughFrame - FLYTHROUGH_WARMUP_FRAMES : 0;
+            GetCameraPathPose(flythroughPath, measuredFrame*FLYTHROUGH_CAMERA_SPEED*FLYTHROUGH_TIMESTEP, &camera.position, &camera.target);
+            flythroughFrame++;
+        } else {
+            UpdateCameraCustom(&camera, cameraMode, frameDelta);
+        }
+        EndProfileZone(PROFILE_ZONE_CAMERA);
 
         // Log human state at the start of the loop
-        TraceLog(LOG_INFO, "Loop Start: human.active = %d, human.state = %d, currentMenu = %d", human.active, human.state, currentMenu);
+        TraceLog(LOG_DEBUG, "Loop Start: human.active = %d, human.state = %d, currentMenu = %d", human.active, human.state, currentMenu);
 
-        // Update and play animal sounds
-        for (int i = 0; i < animalCount; i++) {
-            if (animals[i].active) {
-                PlayAnimalSound(&animals[i], camera);
-            }
-        }
+        // Update and play animal sounds (not in the benchmark, their timers run on the wall clock and draw random numbers)
+        BeginProfileZone(PROFILE_ZONE_SOUNDS);
+        if (!flythroughMode) PlayAnimalSounds(camera);
+        EndProfileZone(PROFILE_ZONE_SOUNDS);
 
         // --- Path Recording Logic ---
         if (IsKeyPressed(KEY_R)) {
@@ -3192,6 +5311,46 @@ int main(void)
             showDebugVisualization = !showDebugVisualization;
             TraceLog(LOG_INFO, "Debug visualization: %s", showDebugVisualization ? "ON" : "OFF");
         }
+
+        // Toggle the profiler overlay when F3 is pressed
+        if (IsKeyPressed(KEY_F3)) {
+            showProfilerOverlay = !showProfilerOverlay;
+            TraceLog(LOG_INFO, "Profiler overlay: %s", showProfilerOverlay ? "ON" : "OFF");
+        }
+
+        // Dump the profiler frame history to CSV when F4 is pressed
+        if (IsKeyPressed(KEY_F4)) {
+            ExportProfilerCsv(PROFILER_CSV_FILE);
+        }
+
+        // Start/stop a trace capture when F5 is pressed
+        if (IsKeyPressed(KEY_F5)) {
+            if (IsTraceCapturing()) StopTraceCapture(TRACE_CAPTURE_FILE);
+            else StartTraceCapture();
+        }
+
+        // Pause/resume the farm when F6 is pressed, cycle 1x/10x/100x when F7 is pressed
+        // (the benchmark keeps its fixed steps)
+        if (!flythroughMode && IsKeyPressed(KEY_F6)) {
+            if (timeScale == 0.0f) SetTimeScale(resumeTimeScale);
+            else {
+                resumeTimeScale = timeScale;
+                SetTimeScale(0.0f);
+            }
+        }
+        if (!flythroughMode && IsKeyPressed(KEY_F7)) {
+            int next = 0;
+            for (int i = 0; i < 3; i++) {
+                if (timeScale == timeScales[i]) next = (i + 1)%3;
+            }
+            SetTimeScale(timeScales[next]);
+        }
+
+        // Menus open and close in both the update and the draw code, report the change once per frame
+        if (currentMenu != tracedMenu) {
+            TraceMarker(TextFormat("Menu %s -> %s", GetMenuName(tracedMenu), GetMenuName(currentMenu)), "game");
+            tracedMenu = currentMenu;
+        }
         
         // Reset human character position when H is pressed
         if (IsKeyPressed(KEY_H)) {
@@ -3203,18 +5362,22 @@ int main(void)
             
             // Re-setup path
             SetupHumanPath(&human, farmhousePosition, barnPosition);
+            human.prevPosition = human.position; // Jump there instead of sliding
+            human.prevRotationAngle = human.rotationAngle;
             TraceLog(LOG_INFO, "Human character reset to starting position");
         }
 
         if (isRecordingPath && currentRecordingPointCount < MAX_PATH_POINTS) {
             if (currentRecordingPointCount == 0) {
                 // Always record the first point
+                currentRecordingTargets[currentRecordingPointCount] = camera.target;
                 currentRecordingBuffer[currentRecordingPointCount++] = camera.position;
                 TraceLog(LOG_INFO, "Recorded point %d: (%.2f, %.2f, %.2f)", currentRecordingPointCount, camera.position.x, camera.position.y, camera.position.z);
             } else {
                 // Record subsequent points if moved far enough
                 float distSq = Vector3DistanceSqr(camera.position, currentRecordingBuffer[currentRecordingPointCount - 1]);
                 if (distSq > minRecordDistanceSq) {
+                    currentRecordingTargets[currentRecordingPointCount] = camera.target;
                     currentRecordingBuffer[currentRecordingPointCount++] = camera.position;
                     TraceLog(LOG_INFO, "Recorded point %d: (%.2f, %.2f, %.2f)", currentRecordingPointCount, camera.position.x, camera.position.y, camera.position.z);
                 }
@@ -3234,6 +5397,8 @@ int main(void)
                 }
                 printf("};\\n");
                 printf("int recordedPathNumPoints = %d;\\n", currentRecordingPointCount);
+                // Also as a camera path file for the flythrough benchmark
+                SaveCameraPath(CAMERA_PATH_FILE, currentRecordingBuffer, currentRecordingTargets, currentRecordingPointCount);
                 // Optionally, clear the buffer after exporting if desired
                 // currentRecordingPointCount = 0; 
                 // isRecordingPath = false; // Or allow further recording/appending
@@ -3244,27 +5409,22 @@ int main(void)
         // --- End Path Recording Logic ---
 
         // Update terrain based on player position
+        BeginProfileZone(PROFILE_ZONE_TERRAIN_LOD);
         UpdateTerrainChunks(camera.position, terrainTexture);
+        EndProfileZone(PROFILE_ZONE_TERRAIN_LOD);
 
-        // Update animals
-        for (int i = 0; i < animalCount; i++) {
-            if (animals[i].active) {
-                UpdateAnimal(&animals[i], FIXED_TERRAIN_SIZE);
-            }
-        }
-        
-        // Update human character
-        UpdateHuman(&human, GetFrameTime());
+        // Advance the farm (animals, human guide, hunger and production) in fixed steps
+        UpdateSimulation(frameDelta);
 
         // --- Update Game Logic ---
-        float deltaTime = GetFrameTime();
         Vector3 playerPos = camera.position;
         bool interactionKeyPressed = IsKeyPressed(KEY_F); // Use F for interaction
 
         // --- Proximity Detection and Menu Activation ---
+        BeginProfileZone(PROFILE_ZONE_INTERACTION);
         // Disable other menus if human start menu is active
         if (!(human.active && human.state == HUMAN_STATE_IDLE_AT_INTERSECTION)) {
-            TraceLog(LOG_INFO, "Interaction logic check: human.active = %d, human.state = %d. Interaction logic WILL RUN.", human.active, human.state);
+            TraceLog(LOG_DEBUG, "Interaction logic check: human.active = %d, human.state = %d. Interaction logic WILL RUN.", human.active, human.state);
 
             // Reset prompt flags each frame this logic runs
             showBarnPrompt = false;
@@ -3296,7 +5456,7 @@ int main(void)
                     // Feeding Chickens
                     if (animalCountByType[ANIMAL_CHICKEN] > 0 && IsNearBuilding(playerPos, ENCLOSURE_CENTER_2, 15.0f)) { // Chicken enclosure - larger radius
                         showChickenInteractionPrompt = true;
-                        TraceLog(LOG_INFO, "Player is near chicken enclosure");
+                        TraceLog(LOG_DEBUG, "Player is near chicken enclosure");
                         
                         if (interactionKeyPressed) {
                             // Show the appropriate menu based on player's inventory and animal status
@@ -3313,7 +5473,7 @@ int main(void)
                     // Feeding Pigs
                     else if (animalCountByType[ANIMAL_PIG] > 0 && IsNearBuilding(playerPos, ENCLOSURE_CENTER_1, 15.0f)) { // Pig enclosure - larger radius
                         showPigInteractionPrompt = true;
-                        TraceLog(LOG_INFO, "Player is near pig enclosure");
+                        TraceLog(LOG_DEBUG, "Player is near pig enclosure");
                         
                         if (interactionKeyPressed) {
                             // Show the appropriate menu based on player's inventory and animal status
@@ -3331,18 +5491,17 @@ int main(void)
                     else if (animalCountByType[ANIMAL_COW] > 0) {
                         bool nearAnyCow = false;
                         Vector3 nearCowPosition;
-                        for (int i = 0; i < animalCount; i++) {
-                            if (animals[i].active && animals[i].type == ANIMAL_COW) {
-                                if (IsNearBuilding(playerPos, animals[i].position, 10.0f)) { // Larger radius
-                                    nearAnyCow = true;
-                                    nearCowPosition = animals[i].position;
-                                    break;
-                                }
+                        for (int i = 0; i < herds[ANIMAL_COW].count; i++) {
+                            Vector3 cowPosition = GetAnimalPosition(GetAnimalId(ANIMAL_COW, i));
+                            if (IsNearBuilding(playerPos, cowPosition, 10.0f)) { // Larger radius
+                                nearAnyCow = true;
+                                nearCowPosition = cowPosition;
+                                break;
                             }
                         }
                         if (nearAnyCow) {
                             showCowInteractionPrompt = true;
-                            TraceLog(LOG_INFO, "Player is near cow");
+                            TraceLog(LOG_DEBUG, "Player is near cow");
                             
                             if (interactionKeyPressed) {
                                 // Show the appropriate menu based on player's inventory and animal status
@@ -3364,93 +5523,103 @@ int main(void)
             }
         }
 
-        // Update Animal Hunger and Production (using AnimalCategoryStats)
-        for (int type = 0; type < ANIMAL_COUNT; type++) {
-            if (animalCountByType[type] == 0) continue; // Skip if no animals of this type
-
-            animalStats[type].timeSinceLastFed += deltaTime;
-
-            // Hunger depletion
-            if (animalStats[type].timeSinceLastFed >= HUNGER_DEPLETION_INTERVAL) {
-                animalStats[type].timeSinceLastFed = 0.0f; // Reset interval timer
-                float depletionRate = 0.0f;
-                switch(type) {
-                    case ANIMAL_CHICKEN: depletionRate = CHICKEN_HUNGER_DEPLETION_RATE; break;
-                    case ANIMAL_PIG:     depletionRate = PIG_HUNGER_DEPLETION_RATE; break;
-                    case ANIMAL_COW:     depletionRate = COW_HUNGER_DEPLETION_RATE; break;
-                }
-                animalStats[type].hunger -= depletionRate;
-                if (animalStats[type].hunger < 0) animalStats[type].hunger = 0;
-            }
-
-            // Production
-            if (animalStats[type].hunger > 20.0f) { // Animals only produce if hunger > 20%
-                 if (!animalStats[type].productReady) { // Only countdown if product is not already ready
-                    animalStats[type].productCooldownTimer -= deltaTime;
-                    if (animalStats[type].productCooldownTimer <= 0) {
-                        animalStats[type].productReady = true;
-                        // Cooldown will be reset when product is collected
-                        // Set a minimal timer to avoid immediate re-trigger if collection fails
-                        animalStats[type].productCooldownTimer = 0.1f; 
-                    }
-                }
-            } else {
-                // If hunger is too low, pause production timer but don't reset it completely.
-                // It will resume when animals are fed again. Product can still be ready if it became ready before hunger dropped.
-            }
-        }
+        EndProfileZone(PROFILE_ZONE_INTERACTION);
 
         // Draw the human start menu (full-screen dialog)
         if (human.active && human.state == HUMAN_STATE_IDLE_AT_INTERSECTION) {
             DrawHumanStartMenu(&human);
         }
 
+        EndProfileZone(PROFILE_ZONE_UPDATE);
+        BeginProfileZone(PROFILE_ZONE_DRAW);
+
         BeginDrawing();
         ClearBackground(SKY_COLOR); // Use sky color as background
 
+        // Frustum for this frame, every world draw list is culled against it (and the fog distance)
+        Frustum viewFrustum = GetCameraFrustum(camera);
+        UpdateFog(camera);
+        ResetCullStats();
+        ResetLodStats();
+
         BeginMode3D(camera);
 
+        // Sky first, everything else is drawn over it
+        BeginProfileZone(PROFILE_ZONE_DRAW_SKY);
+        DrawSky(camera);
+        EndProfileZone(PROFILE_ZONE_DRAW_SKY);
+
         // Draw terrain chunks
-        DrawTerrainChunks();
+        BeginProfileZone(PROFILE_ZONE_DRAW_TERRAIN);
+        DrawTerrainChunks(&viewFrustum);
+        EndProfileZone(PROFILE_ZONE_DRAW_TERRAIN);
         
         // Draw the road
+        BeginProfileZone(PROFILE_ZONE_DRAW_ROADS);
         DrawModelEx(roadModel, roadPosition, (Vector3){0.0f, 1.0f, 0.0f}, roadRotationAngle, (Vector3){1.0f, 1.0f, 1.0f}, WHITE);
 
         // Draw all custom roads
         DrawAllCustomRoads();
+        EndProfileZone(PROFILE_ZONE_DRAW_ROADS);
 
-        // Draw buildings
-        for (int i = 0; i < MAX_BUILDINGS; i++)
-        {
-            // Hide FarmHouse until purchased and remove constructionHouse after purchase
-            if ((i == 4 && !purchasedFarmhouse) || (i == 3 && purchasedFarmhouse)) continue;
-            if (buildings[i].model.meshCount > 0) { // Check if model is loaded
-                DrawModelEx(buildings[i].model, buildings[i].position, (Vector3){0.0f, 1.0f, 0.0f}, buildings[i].rotationAngle, (Vector3){buildings[i].scale, buildings[i].scale, buildings[i].scale}, WHITE);
-            }
-        }
+        // Draw buildings (FarmHouse hidden until purchased, constructionHouse removed after purchase)
+        BeginProfileZone(PROFILE_ZONE_DRAW_BUILDINGS);
+        DrawStaticWorld(camera, &viewFrustum);
+        EndProfileZone(PROFILE_ZONE_DRAW_BUILDINGS);
 
         // Draw plants
-        DrawPlants(camera); // Pass camera object
+        BeginProfileZone(PROFILE_ZONE_DRAW_PLANTS);
+        DrawPlants(camera, &viewFrustum); // Pass camera object
+        EndProfileZone(PROFILE_ZONE_DRAW_PLANTS);
 
         // Draw animals
-        DrawAnimals();
+        BeginProfileZone(PROFILE_ZONE_DRAW_ANIMALS);
+        DrawAnimals(camera, &viewFrustum);
+        EndProfileZone(PROFILE_ZONE_DRAW_ANIMALS);
         
         // Draw human character
+        BeginProfileZone(PROFILE_ZONE_DRAW_HUMAN);
         if (human.active) { // Only draw the 3D model if active
             DrawHuman(&human, camera);
         }
+        EndProfileZone(PROFILE_ZONE_DRAW_HUMAN);
         
         // Draw clouds
-        DrawClouds(camera);
+        BeginProfileZone(PROFILE_ZONE_DRAW_CLOUDS);
+        DrawClouds(camera, &viewFrustum);
+        EndProfileZone(PROFILE_ZONE_DRAW_CLOUDS);
 
         EndMode3D();
 
+        BeginProfileZone(PROFILE_ZONE_DRAW_HUD);
+
+        // Culling statistics (debug visualization only)
+        if (showDebugVisualization) {
+            CullStats cullStats = GetCullStats();
+            DrawRectangle(5, 5, 260, 65 + CULL_CATEGORY_COUNT*15, Fade(BLACK, 0.5f));
+            DrawText("Frustum culling (visible / culled):", 15, 10, 10, WHITE);
+            for (int c = 0; c < CULL_CATEGORY_COUNT; c++) {
+                DrawText(TextFormat("- %s: %d / %d", GetCullCategoryName((CullCategory)c), cullStats.visible[c], cullStats.culled[c]),
+                         15, 25 + c*15, 10, WHITE);
+            }
+            DrawText(TextFormat("Terrain: %d triangles, %d vertices", terrainTrianglesDrawn, terrainVerticesDrawn),
+                     15, 25 + CULL_CATEGORY_COUNT*15, 10, WHITE);
+
+            // Triangles of the objects drawn through LOD levels, against the same objects at full detail
+            LodStats lodStats = GetLodStats();
+            float lodSaved = (lodStats.fullTriangles > 0) ? 100.0f*(1.0f - (float)lodStats.triangles/(float)lodStats.fullTriangles) : 0.0f;
+            DrawText(TextFormat("LOD: %lld of %lld triangles (%.0f%% saved)", lodStats.triangles, lodStats.fullTriangles, lodSaved),
+                     15, 40 + CULL_CATEGORY_COUNT*15, 10, WHITE);
+            DrawText(TextFormat("- Objects per level: %d / %d / %d / %d", lodStats.objects[0], lodStats.objects[1], lodStats.objects[2], lodStats.objects[3]),
+                     15, 55 + CULL_CATEGORY_COUNT*15, 10, WHITE);
+        }
+
         // TEST: Draw a simple red square at top-left to see if any 2D drawing works after start menu closes
         if (!(human.active && human.state == HUMAN_STATE_IDLE_AT_INTERSECTION)) {
             // DrawRectangle(0, 0, 100, 100, RED); // Test red square
-            TraceLog(LOG_INFO, "TEST: Drawing RED square because human start menu is NOT active.");
+            TraceLog(LOG_DEBUG, "TEST: Drawing RED square because human start menu is NOT active.");
         } else {
-            TraceLog(LOG_INFO, "TEST: NOT drawing RED square because human start menu IS active.");
+            TraceLog(LOG_DEBUG, "TEST: NOT drawing RED square because human start menu IS active.");
         }
 
         // Draw crosshair in the center of the screen
@@ -3576,7 +5745,7 @@ int main(void)
         int hudBoxX = screenWidth - hudBoxWidth - 10;
         int hudBoxY = 10;
 
-        TraceLog(LOG_INFO, "Drawing Animal HUD: X=%d, Y=%d, W=%d, H=%d", hudBoxX, hudBoxY, hudBoxWidth, hudBoxHeight);
+        TraceLog(LOG_DEBUG, "Drawing Animal HUD: X=%d, Y=%d, W=%d, H=%d", hudBoxX, hudBoxY, hudBoxWidth, hudBoxHeight);
 
         DrawRectangle(hudBoxX, hudBoxY, hudBoxWidth, hudBoxHeight, Fade(DARKBLUE, 0.7f));
         DrawRectangleLines(hudBoxX, hudBoxY, hudBoxWidth, hudBoxHeight, SKYBLUE);
@@ -3617,12 +5786,17 @@ int main(void)
         int coinsBoxWidth = 110;
         int coinsBoxHeight = 40;
 
-        TraceLog(LOG_INFO, "Drawing Coins: X=%d, Y=%d, W=%d, H=%d", coinsBoxX, coinsBoxY, coinsBoxWidth, coinsBoxHeight);
+        TraceLog(LOG_DEBUG, "Drawing Coins: X=%d, Y=%d, W=%d, H=%d", coinsBoxX, coinsBoxY, coinsBoxWidth, coinsBoxHeight);
 
         DrawRectangle(coinsBoxX, coinsBoxY, coinsBoxWidth, coinsBoxHeight, Fade(GOLD, 0.7f));
         DrawRectangleLines(coinsBoxX, coinsBoxY, coinsBoxWidth, coinsBoxHeight, YELLOW);
         DrawText(TextFormat("Coins: %.0f", playerCoins), coinsBoxX + 10, coinsBoxY + 10, 20, BLACK);
 
+        // Simulation speed, under the coins whenever the farm doesn't run in real time
+        if (timeScale != 1.0f) {
+            DrawText((timeScale == 0.0f) ? "PAUSED" : TextFormat("%gx", timeScale), coinsBoxX + 10, coinsBoxY + coinsBoxHeight + 8, 20, YELLOW);
+        }
+
         // --- Draw Interaction Prompts --- (New Section)
         if (currentMenu == MENU_NONE && !(human.active && human.state == HUMAN_STATE_IDLE_AT_INTERSECTION)) {
             int promptY = screenHeight - 40; // Position prompts lower, above inventory
@@ -3640,6 +5814,9 @@ int main(void)
             }
         }
 
+        EndProfileZone(PROFILE_ZONE_DRAW_HUD);
+        BeginProfileZone(PROFILE_ZONE_DRAW_MENUS);
+
         // --- Draw Interaction Menus (Barn/Bank) ---
         if (currentMenu == MENU_BARN) {
             // First clear the screen and draw a full screen black background
@@ -3727,56 +5904,11 @@ int main(void)
             if (IsKeyPressed(KEY_DOWN)) menuSelectedItem = (menuSelectedItem + 1) % numBarnOptions;
             if (IsKeyPressed(KEY_ENTER)) { // F can also confirm in menu
                 switch (menuSelectedItem) {
-                    case 0: // Store Food
-                        if (playerInventory.type == ITEM_FOOD && playerInventory.quantity > 0) {
-                            barnStorage.food += playerInventory.quantity;
-                            TraceLog(LOG_INFO, "Stored %d food in barn. Barn total: %d", playerInventory.quantity, barnStorage.food);
-                            ClearInventory();
-                        } else {
-                             TraceLog(LOG_WARNING, "No food in inventory to store.");
-                        }
-                        break;
-                    case 1: // Take Food
-                        if (playerInventory.type == ITEM_NONE || playerInventory.type == ITEM_FOOD) {
-                            if (barnStorage.food > 0) {
-                                int amountToTake = (barnStorage.food >= 50) ? 50 : barnStorage.food;
-                                AddToInventory(ITEM_FOOD, amountToTake);
-                                barnStorage.food -= amountToTake;
-                                TraceLog(LOG_INFO, "Took %d food from barn. Barn remaining: %d", amountToTake, barnStorage.food);
-                            } else {
-                                TraceLog(LOG_WARNING, "No food in barn to take.");
-                            }
-                        } else {
-                            TraceLog(LOG_WARNING, "Inventory not empty or already contains a different item. Cannot take food.");
-                        }
-                        break;
-                    case 2: // Store Eggs
-                        if (playerInventory.type == ITEM_EGG && playerInventory.quantity > 0) {
-                            barnStorage.eggs += playerInventory.quantity;
-                            TraceLog(LOG_INFO, "Stored %d eggs in barn. Barn total: %d", playerInventory.quantity, barnStorage.eggs);
-                            ClearInventory();
-                        } else {
-                            TraceLog(LOG_WARNING, "No eggs in inventory to store.");
-                        }
-                        break;
-                    case 3: // Store Milk
-                        if (playerInventory.type == ITEM_MILK && playerInventory.quantity > 0) {
-                            barnStorage.milk += playerInventory.quantity;
-                            TraceLog(LOG_INFO, "Stored %d milk in barn. Barn total: %d", playerInventory.quantity, barnStorage.milk);
-                            ClearInventory();
-                        } else {
-                            TraceLog(LOG_WARNING, "No milk in inventory to store.");
-                        }
-                        break;
-                    case 4: // Store Steak
-                        if (playerInventory.type == ITEM_STEAK && playerInventory.quantity > 0) {
-                            barnStorage.steak += playerInventory.quantity;
-                            TraceLog(LOG_INFO, "Stored %d steak in barn. Barn total: %d", playerInventory.quantity, barnStorage.steak);
-                            ClearInventory();
-                        } else {
-                            TraceLog(LOG_WARNING, "No steak in inventory to store.");
-                        }
-                        break;
+                    case 0: StoreInventoryInBarn(ITEM_FOOD); break; // Store Food
+                    case 1: TakeFoodFromBarn(); break; // Take Food
+                    case 2: StoreInventoryInBarn(ITEM_EGG); break; // Store Eggs
+                    case 3: StoreInventoryInBarn(ITEM_MILK); break; // Store Milk
+                    case 4: StoreInventoryInBarn(ITEM_STEAK); break; // Store Steak
                     case 5: // Exit
                         currentMenu = MENU_NONE;
                         break;
@@ -3868,42 +6000,10 @@ int main(void)
                 TraceLog(LOG_INFO, "Bank menu option selected: %d", menuSelectedItem);
                 
                 switch (menuSelectedItem) {
-                    case 0: // Sell Eggs
-                        if (barnStorage.eggs > 0) {
-                            playerCoins += barnStorage.eggs * PRICE_EGG_SELL;
-                            TraceLog(LOG_INFO, "Sold %d eggs. Player coins: %.0f", barnStorage.eggs, playerCoins);
-                            barnStorage.eggs = 0;
-                        } else {
-                            TraceLog(LOG_WARNING, "No eggs in barn to sell.");
-                        }
-                        break;
-                    case 1: // Sell Milk
-                        if (barnStorage.milk > 0) {
-                            playerCoins += barnStorage.milk * PRICE_MILK_SELL;
-                            TraceLog(LOG_INFO, "Sold %d milk. Player coins: %.0f", barnStorage.milk, playerCoins);
-                            barnStorage.milk = 0;
-                        } else {
-                            TraceLog(LOG_WARNING, "No milk in barn to sell.");
-                        }
-                        break;
-                    case 2: // Sell Steak
-                        if (barnStorage.steak > 0) {
-                            playerCoins += barnStorage.steak * PRICE_STEAK_SELL;
-                            TraceLog(LOG_INFO, "Sold %d steak. Player coins: %.0f", barnStorage.steak, playerCoins);
-                            barnStorage.steak = 0;
-                        } else {
-                            TraceLog(LOG_WARNING, "No steak in barn to sell.");
-                        }
-                        break;
-                    case 3: // Buy Food
-                        if (playerCoins >= PRICE_FOOD_BUY * 50) {
-                            playerCoins -= PRICE_FOOD_BUY * 50;
-                            barnStorage.food += 50; // Add to barn, player can take it later
-                            TraceLog(LOG_INFO, "Bought 50 food. Player coins: %.0f. Barn food: %d", playerCoins, barnStorage.food);
-                        } else {
-                            TraceLog(LOG_WARNING, "Not enough coins to buy food.");
-                        }
-                        break;
+                    case 0: SellBarnProduct(ITEM_EGG); break; // Sell Eggs
+                    case 1: SellBarnProduct(ITEM_MILK); break; // Sell Milk
+                    case 2: SellBarnProduct(ITEM_STEAK); break; // Sell Steak
+                    case 3: BuyFood(); break; // Buy Food
                     case 4: // Buy Chicken
                         if (playerCoins >= PRICE_CHICKEN_BUY) {
                             playerCoins -= PRICE_CHICKEN_BUY;
@@ -4046,17 +6146,7 @@ int main(void)
             if (IsKeyPressed(KEY_UP)) menuSelectedItem = (menuSelectedItem - 1 + numOptions) % numOptions;
             if (IsKeyPressed(KEY_DOWN)) menuSelectedItem = (menuSelectedItem + 1) % numOptions;
             if (IsKeyPressed(KEY_ENTER)) {
-                if (menuSelectedItem == 0) { // Feed
-                    int foodNeeded = animalCountByType[typeToFeed];
-                    if (playerInventory.type == ITEM_FOOD && playerInventory.quantity >= foodNeeded) {
-                        RemoveFromInventory(ITEM_FOOD, foodNeeded);
-                        animalStats[typeToFeed].hunger = 100.0f;
-                        animalStats[typeToFeed].timeSinceLastFed = 0.0f; // Reset depletion timer
-                        TraceLog(LOG_INFO, "Fed %s. Consumed %d food.", animalName, foodNeeded);
-                    } else {
-                        TraceLog(LOG_WARNING, "Not enough food in inventory to feed %s.", animalName);
-                    }
-                }
+                if (menuSelectedItem == 0) FeedAnimals(typeToFeed); // Feed
                 currentMenu = MENU_NONE; // Close menu after action or cancel
             }
             if (IsKeyPressed(KEY_ESCAPE)) currentMenu = MENU_NONE;
@@ -4124,25 +6214,7 @@ int main(void)
             if (IsKeyPressed(KEY_UP)) menuSelectedItem = (menuSelectedItem - 1 + numOptions) % numOptions;
             if (IsKeyPressed(KEY_DOWN)) menuSelectedItem = (menuSelectedItem + 1) % numOptions;
             if (IsKeyPressed(KEY_ENTER)) {
-                if (menuSelectedItem == 0) { // Collect
-                    if (playerInventory.type == ITEM_NONE && animalStats[typeToCollect].productReady && numProducts > 0) {
-                        AddToInventory(itemToCollect, numProducts);
-                        animalStats[typeToCollect].productReady = false;
-                        // Reset cooldown based on type
-                        switch(typeToCollect) {
-                            case ANIMAL_CHICKEN: animalStats[typeToCollect].productCooldownTimer = CHICKEN_PRODUCTION_TIME; break;
-                            case ANIMAL_PIG:     animalStats[typeToCollect].productCooldownTimer = PIG_PRODUCTION_TIME; break;
-                            case ANIMAL_COW:     animalStats[typeToCollect].productCooldownTimer = COW_PRODUCTION_TIME; break;
-                            default: 
-                                // Handle other animal types or provide a default behavior
-                                TraceLog(LOG_WARNING, "Product collection cooldown not set for animal type: %d", typeToCollect);
-                                break;
-                        }
-                        TraceLog(LOG_INFO, "Collected %d %s.", numProducts, productName);
-                    } else {
-                        TraceLog(LOG_WARNING, "Cannot collect. Inventory not empty, products not ready, or no animals.");
-                    }
-                }
+                if (menuSelectedItem == 0) CollectAnimalProducts(typeToCollect); // Collect
                 currentMenu = MENU_NONE; // Close menu
             }
             if (IsKeyPressed(KEY_ESCAPE)) currentMenu = MENU_NONE;
@@ -4151,11 +6223,29 @@ int main(void)
 
         // Draw the human start menu (full-screen dialog)
         DrawHumanStartMenu(&human);
+        EndProfileZone(PROFILE_ZONE_DRAW_MENUS);
+
+        // Profiler overlay (drawn last so it stays on top of the menus)
+        if (showProfilerOverlay) DrawProfilerOverlay(GetScreenWidth() - PROFILER_OVERLAY_WIDTH - 5, 5);
 
+        EndProfileZone(PROFILE_ZONE_DRAW);
+
+        BeginProfileZone(PROFILE_ZONE_PRESENT);
         EndDrawing();
+        EndProfileZone(PROFILE_ZONE_PRESENT);
+
+        if (!firstFrameDrawn) {
+            TraceLog(LOG_INFO, "STARTUP: Time to first frame: %.2f s after window creation", GetTime());
+            firstFrameDrawn = true;
+        }
     } // End of while loop
 
+    // Write a capture still running at exit (started with --trace or F5)
+    StopTraceCapture(TRACE_CAPTURE_FILE);
+    UnloadCameraPath(flythroughPath);
+
     // De-Initialization
+    UnloadTerrainLods();
     UnloadTexture(terrainTexture);
     
     // Unload inventory item textures
@@ -4168,21 +6258,8 @@ int main(void)
     // Unload animal sounds
     UnloadAnimalSounds();
     
-    // Unload all animals
-    for (int i = 0; i < animalCount; i++) {
-        if (!animals[i].active) continue;
-        
-        UnloadModel(animals[i].walkingModel);
-        UnloadModel(animals[i].idleModel);
-        
-        if (animals[i].walkingAnim != NULL && animals[i].walkingAnimCount > 0) {
-            UnloadModelAnimations(animals[i].walkingAnim, animals[i].walkingAnimCount);
-        }
-        
-        if (animals[i].idleAnim != NULL && animals[i].idleAnimCount > 0) {
-            UnloadModelAnimations(animals[i].idleAnim, animals[i].idleAnimCount);
-        }
-    }
+    // Unload all animals (the registry frees each species once its last animal is released)
+    UnloadAnimalResources();
 
     // Unload custom road segments
     for (int i = 0; i < totalCustomRoadsCount; i++) {
@@ -4198,29 +6275,41 @@ int main(void)
     UnloadModel(roadModel);
 
     // Unload building models
+    UnloadStaticWorld();
     for (int i = 0; i < MAX_BUILDINGS; i++) {
+        ReleaseModelLods(buildings[i].model);
         UnloadModel(buildings[i].model);
     }
     
     // Unload plant resources
     UnloadPlantResources();
 
-    // Unload animal resources
-    UnloadAnimalResources();
-    
+    // Unload cloud chunks, the sky dome and the fog shader
+    UnloadClouds();
+    UnloadSky();
+    UnloadFog();
+
     // Unload human character resources
     UnloadHumanResources(&human);
 
+    UnloadSkinningShader();
+    UnloadCollisionGrids();
+    UnloadRoadGrid();
+    UnloadEntityPools();
+    UnloadJobSystem();
+
     CloseWindow();
+    CloseLogBackend();
     return 0;
 } // End of main function
+#endif // FARM_HEADLESS
 
 // Restoring UpdateCameraCustom function definition
-void UpdateCameraCustom(Camera *camera, int mode)
+void UpdateCameraCustom(Camera *camera, int mode, float deltaTime)
 {
     // Camera movement speed vectors
     Vector3 moveVec = { 0.0f, 0.0f, 0.0f };
-    float speed = CAMERA_MOVE_SPEED;
+    float speed = CAMERA_MOVE_SPEED*deltaTime; // Real frame time, the player walks at the same pace whatever the time scale
 
     // Keyboard inputs for all directions simultaneously
     if (IsKeyDown(KEY_W)) moveVec.z -= 1.0f;
@@ -4280,8 +6369,8 @@ void UpdateCameraCustom(Camera *camera, int mode)
             // Only update position if there's no collision with buildings
             if (!IsCollisionWithBuilding(newPosition, playerCollisionRadius, &collidedWithIndex)) {
                 // Check for collision with animals
-                int collidedAnimalIndex = -1;
-                bool animalCollision = IsCollisionWithAnimal(newPosition, playerCollisionRadius, &collidedAnimalIndex);
+                int collidedAnimalId = -1;
+                bool animalCollision = IsCollisionWithAnimal(newPosition, playerCollisionRadius, &collidedAnimalId);
                 
                 if (!animalCollision) {
                     // No collisions, apply the movement
@@ -4289,9 +6378,9 @@ void UpdateCameraCustom(Camera *camera, int mode)
                     camera->target = Vector3Add(camera->target, translation);
                 } else {
                     // We collided with an animal, but check if we're trying to move away from it
-                    if (collidedAnimalIndex >= 0) {
+                    if (collidedAnimalId >= 0) {
                         // Calculate direction from animal to player
-                        Vector3 animalToPlayer = Vector3Subtract(camera->position, animals[collidedAnimalIndex].position);
+                        Vector3 animalToPlayer = Vector3Subtract(camera->position, GetAnimalPosition(collidedAnimalId));
                         animalToPlayer.y = 0.0f; // Project onto horizontal plane
                         animalToPlayer = Vector3Normalize(animalToPlayer);
                         
@@ -4327,6 +6416,71 @@ void UpdateCameraCustom(Camera *camera, int mode)
         0.0f);                               // Zoom
 }
 
+// Get the collision radius of a building
+float GetBuildingCollisionRadius(int i) {
+    // Use a collision radius based on the building type/index
+    float buildingRadius;
+    if (i == 0) { // barn.glb (index 0)
+        buildingRadius = 6.0f; 
+    } else if (i == 1) { // horse_barn.glb (index 1)
+        buildingRadius = 5.0f; 
+    } else if (i == 2) { // Bank.glb (index 2)
+        buildingRadius = 10.0f; 
+    } else if (i == 3) { // constructionHouse.glb (index 3)
+        buildingRadius = 3.0f;  
+    } else if (i == 4) { // FarmHouse.glb (index 4)
+        buildingRadius = 2.0f;  
+    }else if (i == 5) { // FarmHouse.glb (index 4)
+        buildingRadius = 0.0f;  
+    } else { 
+        const float FENCE_MODEL_SCALE_CONST = 0.2f; 
+        if (buildings[i].scale == FENCE_MODEL_SCALE_CONST) { // Likely a fence
+            buildingRadius = 1.0f; 
+        } else {
+            // Generic scaling for other unknown buildings.
+            buildingRadius = buildings[i].scale * 20.0f; // This factor might need tuning
+            if (buildingRadius < 1.5f) buildingRadius = 1.5f; 
+        }
+    }
+    return buildingRadius;
+}
+
+// Get the collision radius of a tree
+float GetTreeCollisionRadius(const Plant *plant) {
+    return plant->scale * 1.7f; // Adjust as needed
+}
+
+// Create the collision grids, must be called before any animal is spawned
+void InitCollisionGrids(void) {
+    buildingGrid = LoadSpatialHash(COLLISION_CELL_SIZE, 256, MAX_BUILDINGS*4);
+    treeGrid = LoadSpatialHash(COLLISION_CELL_SIZE, 1024, maxPlants);
+    animalGrid = LoadSpatialHash(COLLISION_CELL_SIZE, 256, maxAnimals);
+}
+
+// Register buildings and trees in the static grids, call again whenever they change
+void RegisterStaticColliders(void) {
+    ClearSpatialHash(&buildingGrid);
+    for (int i = 0; i < MAX_BUILDINGS; i++) {
+        if (buildings[i].scale == 0.0f) continue; // Skip unused slots (headless buildings have no meshes but still collide)
+        SpatialHashInsertCircle(&buildingGrid, i, buildings[i].position, GetBuildingCollisionRadius(i));
+    }
+
+    ClearSpatialHash(&treeGrid);
+    for (int i = 0; i < plantCount; i++) {
+        if (!plants[i].active || plants[i].type != PLANT_TREE) continue;
+        SpatialHashInsertCircle(&treeGrid, i, plants[i].position, GetTreeCollisionRadius(&plants[i]));
+    }
+
+    TraceLog(LOG_INFO, "Collision grids: %d building cells, %d tree cells", buildingGrid.entryCount, treeGrid.entryCount);
+}
+
+// Unload the collision grids
+void UnloadCollisionGrids(void) {
+    UnloadSpatialHash(&buildingGrid);
+    UnloadSpatialHash(&treeGrid);
+    UnloadSpatialHash(&animalGrid);
+}
+
 // Function to check if an animal is colliding with a building or tree
 bool IsCollisionWithBuilding(Vector3 position, float radius, int* buildingIndex) {
     // First check if we're in the bank area or on the road to the bank
@@ -4335,9 +6489,13 @@ bool IsCollisionWithBuilding(Vector3 position, float radius, int* buildingIndex)
         return false; // No collision in bank area
     }
     
-    // First check buildings
-    for (int i = 0; i < MAX_BUILDINGS; i++) {
-        if (buildings[i].model.meshCount == 0) continue; // Skip uninitialized buildings
+    // First check buildings (only the ones registered in the cells around the position)
+    int buffer[COLLISION_QUERY_IDS];
+    int *candidates = NULL;
+    int candidateCount = QueryCollisionGrid(&buildingGrid, position, radius, buffer, COLLISION_QUERY_IDS, &candidates);
+    bool collided = false;
+    for (int c = 0; (c < candidateCount) && !collided; c++) {
+        int i = candidates[c];
 
         // Note: Skipping specific buildings like the chicken coop for animal collision 
         // needs a robust identification method (e.g., a type field in Building struct or a known index).
@@ -4347,52 +6505,31 @@ bool IsCollisionWithBuilding(Vector3 position, float radius, int* buildingIndex)
         // Calculate distance between position and building center
         float distance = Vector3Distance(position, buildings[i].position);
         
-        // Use a collision radius based on the building type/index
-        float buildingRadius;
-        if (i == 0) { // barn.glb (index 0)
-            buildingRadius = 6.0f; 
-        } else if (i == 1) { // horse_barn.glb (index 1)
-            buildingRadius = 5.0f; 
-        } else if (i == 2) { // Bank.glb (index 2)
-            buildingRadius = 10.0f; 
-        } else if (i == 3) { // constructionHouse.glb (index 3)
-            buildingRadius = 3.0f;  
-        } else if (i == 4) { // FarmHouse.glb (index 4)
-            buildingRadius = 2.0f;  
-        }else if (i == 5) { // FarmHouse.glb (index 4)
-            buildingRadius = 0.0f;  
-        } else { 
-            const float FENCE_MODEL_SCALE_CONST = 0.2f; 
-            if (buildings[i].scale == FENCE_MODEL_SCALE_CONST) { // Likely a fence
-                buildingRadius = 1.0f; 
-            } else {
-                // Generic scaling for other unknown buildings.
-                buildingRadius = buildings[i].scale * 20.0f; // This factor might need tuning
-                if (buildingRadius < 1.5f) buildingRadius = 1.5f; 
-            }
-        }
-        
         // Check for collision
-        if (distance < (radius + buildingRadius)) {
+        if (distance < (radius + GetBuildingCollisionRadius(i))) {
             if (buildingIndex != NULL) *buildingIndex = i;
-            return true;
+            collided = true;
         }
     }
+    if (candidates != buffer) MemFree(candidates);
+    if (collided) return true;
 
     // Then check trees (as they are also obstacles)
-    for (int i = 0; i < plantCount; i++) {
+    candidateCount = QueryCollisionGrid(&treeGrid, position, radius, buffer, COLLISION_QUERY_IDS, &candidates);
+    for (int c = 0; (c < candidateCount) && !collided; c++) {
+        int i = candidates[c];
         if (!plants[i].active || plants[i].type != PLANT_TREE) continue;
 
         float distance = Vector3Distance(position, plants[i].position);
-        float treeRadius = plants[i].scale * 1.7f; // Adjust as needed
         
-        if (distance < (radius + treeRadius)) {
+        if (distance < (radius + GetTreeCollisionRadius(&plants[i]))) {
             if (buildingIndex != NULL) *buildingIndex = -1; // Use -1 to indicate tree collision
-            return true;
+            collided = true;
         }
     }
+    if (candidates != buffer) MemFree(candidates);
     
-    return false;
+    return collided;
 }
 
 // Forward declaration for DrawTextRec to enable word wrap text drawing
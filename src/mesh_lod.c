@@ -0,0 +1,580 @@
+#include "mesh_lod.h"
+#include "job_system.h"
+#include "raymath.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LOD_TRIANGLE_RATIO 0.5f     // Triangle target of a level relative to the previous one
+#define LOD_ERROR_LIMIT 0.01f       // Error limit of level 1 relative to the mesh radius, doubled for every further level (about one pixel at the switch size)
+#define LOD_MIN_TRIANGLES 256       // Models with fewer triangles keep full detail only
+#define LOD_MIN_SAVING 0.8f         // A level must drop at least 20% of the triangles of the previous one
+#define LOD_BORDER_WEIGHT 10.0      // Weight of the planes holding open borders in place
+#define LOD_MAX_PASSES 128          // Collapse passes per simplification at most
+
+// Sum of squared distances to a set of planes (a, b, c, d) as a symmetric 4x4 matrix. The planes
+// aren't weighted by area: the square root of the sum bounds the distance to every single plane,
+// so the error limit holds next to large flat faces too.
+typedef struct {
+    double a2, ab, ac, ad, b2, bc, bd, c2, cd, d2;
+} Quadric;
+
+// Edge collapse candidate: move vertex from onto vertex to
+typedef struct {
+    int from;
+    int to;
+    float error;
+} Collapse;
+
+// Open addressing table from edges (vertex pairs) to the number of triangles using them
+typedef struct {
+    unsigned long long *keys;   // Smaller vertex in the high half, 0 marks a free slot
+    int *counts;
+    unsigned int mask;
+} EdgeTable;
+
+static LodStats lodStats = { 0 };
+
+//----------------------------------------------------------------------------------
+// Quadrics
+//----------------------------------------------------------------------------------
+static void AddPlaneQuadric(Quadric *q, Vector3 normal, Vector3 point, double weight) {
+    double a = normal.x, b = normal.y, c = normal.z;
+    double d = -(a*point.x + b*point.y + c*point.z);
+
+    q->a2 += weight*a*a; q->ab += weight*a*b; q->ac += weight*a*c; q->ad += weight*a*d;
+    q->b2 += weight*b*b; q->bc += weight*b*c; q->bd += weight*b*d;
+    q->c2 += weight*c*c; q->cd += weight*c*d;
+    q->d2 += weight*d*d;
+}
+
+static void AddQuadric(Quadric *q, const Quadric *r) {
+    q->a2 += r->a2; q->ab += r->ab; q->ac += r->ac; q->ad += r->ad;
+    q->b2 += r->b2; q->bc += r->bc; q->bd += r->bd;
+    q->c2 += r->c2; q->cd += r->cd;
+    q->d2 += r->d2;
+}
+
+// Get the summed squared distance of a point to the planes of two quadrics
+static float GetCollapseError(const Quadric *q, const Quadric *r, Vector3 p) {
+    double x = p.x, y = p.y, z = p.z;
+    double a2 = q->a2 + r->a2, ab = q->ab + r->ab, ac = q->ac + r->ac, ad = q->ad + r->ad;
+    double b2 = q->b2 + r->b2, bc = q->bc + r->bc, bd = q->bd + r->bd;
+    double c2 = q->c2 + r->c2, cd = q->cd + r->cd, d2 = q->d2 + r->d2;
+
+    double error = a2*x*x + 2.0*ab*x*y + 2.0*ac*x*z + 2.0*ad*x +
+                   b2*y*y + 2.0*bc*y*z + 2.0*bd*y +
+                   c2*z*z + 2.0*cd*z + d2;
+    return (float)fabs(error);
+}
+
+//----------------------------------------------------------------------------------
+// Edge table
+//----------------------------------------------------------------------------------
+static EdgeTable LoadEdgeTable(int edgeCount) {
+    EdgeTable table = { 0 };
+    unsigned int capacity = 16;
+    while (capacity < (unsigned int)edgeCount*2) capacity *= 2;
+    table.keys = (unsigned long long *)MemAlloc(capacity*sizeof(unsigned long long));
+    table.counts = (int *)MemAlloc(capacity*sizeof(int));
+    table.mask = capacity - 1;
+    return table;
+}
+
+static void UnloadEdgeTable(EdgeTable *table) {
+    MemFree(table->keys);
+    MemFree(table->counts);
+    *table = (EdgeTable){ 0 };
+}
+
+// Get the slot of an edge, a free slot if it isn't in the table
+static unsigned int FindEdgeSlot(const EdgeTable *table, int a, int b) {
+    if (a > b) {
+        int tmp = a;
+        a = b;
+        b = tmp;
+    }
+    unsigned long long key = ((unsigned long long)a << 32) | (unsigned int)b;  // Never 0, b > a >= 0
+    unsigned int slot = (unsigned int)((key*0x9E3779B97F4A7C15ull) >> 32) & table->mask;
+    while ((table->keys[slot] != 0) && (table->keys[slot] != key)) slot = (slot + 1) & table->mask;
+    return slot;
+}
+
+static void AddEdge(EdgeTable *table, int a, int b) {
+    unsigned int slot = FindEdgeSlot(table, a, b);
+    table->keys[slot] = (a < b) ? (((unsigned long long)a << 32) | (unsigned int)b) : (((unsigned long long)b << 32) | (unsigned int)a);
+    table->counts[slot]++;
+}
+
+// Check if an edge is used by a single triangle
+static bool IsBorderEdge(const EdgeTable *table, int a, int b) {
+    return table->counts[FindEdgeSlot(table, a, b)] == 1;
+}
+
+//----------------------------------------------------------------------------------
+// Simplification
+//----------------------------------------------------------------------------------
+static Vector3 GetTriangleNormal(Vector3 a, Vector3 b, Vector3 c) {
+    return Vector3CrossProduct(Vector3Subtract(b, a), Vector3Subtract(c, a));
+}
+
+// Give every distinct vertex position an id, returns the number of distinct positions
+static int WeldPositions(const float *vertices, int vertexCount, int *weld, int *firstVertex) {
+    unsigned int capacity = 16;
+    while (capacity < (unsigned int)vertexCount*2) capacity *= 2;
+    int *table = (int *)MemAlloc(capacity*sizeof(int));
+    memset(table, 0xff, capacity*sizeof(int));
+
+    int count = 0;
+    for (int v = 0; v < vertexCount; v++) {
+        unsigned int bits[3];
+        memcpy(bits, &vertices[v*3], sizeof(bits));
+        unsigned int slot = ((bits[0]*73856093u) ^ (bits[1]*19349663u) ^ (bits[2]*83492791u)) & (capacity - 1);
+
+        while ((table[slot] != -1) && (memcmp(&vertices[firstVertex[table[slot]]*3], &vertices[v*3], 3*sizeof(float)) != 0)) {
+            slot = (slot + 1) & (capacity - 1);
+        }
+        if (table[slot] == -1) {
+            table[slot] = count;
+            firstVertex[count++] = v;
+        }
+        weld[v] = table[slot];
+    }
+
+    MemFree(table);
+    return count;
+}
+
+static int CompareCollapses(const void *a, const void *b) {
+    const Collapse *ca = (const Collapse *)a;
+    const Collapse *cb = (const Collapse *)b;
+    if (ca->error != cb->error) return (ca->error < cb->error) ? -1 : 1;
+    if (ca->from != cb->from) return (ca->from < cb->from) ? -1 : 1;   // Same order on every platform
+    return (ca->to < cb->to) ? -1 : (ca->to > cb->to);
+}
+
+// Get the vertex standing in for a collapsed corner among the vertices at its new position: the one
+// with the closest texture coordinates, so each side of a UV seam keeps its own
+static int GetReplacementVertex(Mesh mesh, const int *candidates, int candidateCount, int vertex) {
+    if (mesh.texcoords == NULL) return candidates[0];
+
+    int best = candidates[0];
+    float bestDistance = 0.0f;
+    for (int i = 0; i < candidateCount; i++) {
+        float du = mesh.texcoords[candidates[i]*2] - mesh.texcoords[vertex*2];
+        float dv = mesh.texcoords[candidates[i]*2 + 1] - mesh.texcoords[vertex*2 + 1];
+        float distance = du*du + dv*dv;
+        if ((i == 0) || (distance < bestDistance)) {
+            best = candidates[i];
+            bestDistance = distance;
+        }
+    }
+    return best;
+}
+
+// Copy the attributes of the listed vertices into a new array (NULL stays NULL)
+static void *GatherVertexData(const void *data, int elementSize, const int *vertices, int count) {
+    if (data == NULL) return NULL;
+
+    unsigned char *result = (unsigned char *)MemAlloc(count*elementSize);
+    for (int i = 0; i < count; i++) memcpy(result + i*elementSize, (const unsigned char *)data + vertices[i]*elementSize, elementSize);
+    return result;
+}
+
+// Simplify a mesh to about targetTriangles, moving no surface more than maxError (mesh units).
+// Collapses run in passes over the edges sorted by error, a collapse locks the vertices around it
+// for the rest of the pass so the checks of the next ones see current triangles. A collapse is
+// skipped if it would flip a triangle or pull an open border inwards. Returns an empty mesh if
+// the result doesn't fit 16-bit indices.
+Mesh SimplifyMesh(Mesh mesh, int targetTriangles, float maxError, float *resultError) {
+    Mesh result = { 0 };
+    if (resultError != NULL) *resultError = 0.0f;
+
+    int indexCount = (mesh.indices != NULL) ? mesh.triangleCount*3 : mesh.vertexCount - mesh.vertexCount%3;
+    if ((mesh.vertices == NULL) || (indexCount == 0)) return result;
+
+    // Topology works on welded positions, the corners remember their original vertices
+    int *weld = (int *)MemAlloc(mesh.vertexCount*sizeof(int));
+    int *firstVertex = (int *)MemAlloc(mesh.vertexCount*sizeof(int));
+    int positionCount = WeldPositions(mesh.vertices, mesh.vertexCount, weld, firstVertex);
+
+    Vector3 *positions = (Vector3 *)MemAlloc(positionCount*sizeof(Vector3));
+    for (int p = 0; p < positionCount; p++) {
+        positions[p] = (Vector3){ mesh.vertices[firstVertex[p]*3], mesh.vertices[firstVertex[p]*3 + 1], mesh.vertices[firstVertex[p]*3 + 2] };
+    }
+
+    int *corners = (int *)MemAlloc(indexCount*sizeof(int));    // Original vertex of every corner
+    int *triangles = (int *)MemAlloc(indexCount*sizeof(int));  // Welded position of every corner, -1 for removed triangles
+    int triangleCount = 0;
+    for (int t = 0; t < indexCount/3; t++) {
+        int v[3];
+        for (int c = 0; c < 3; c++) v[c] = (mesh.indices != NULL) ? mesh.indices[t*3 + c] : t*3 + c;
+        int a = weld[v[0]], b = weld[v[1]], c = weld[v[2]];
+        if ((a == b) || (b == c) || (a == c)) continue;
+
+        for (int k = 0; k < 3; k++) corners[triangleCount*3 + k] = v[k];
+        triangles[triangleCount*3] = a;
+        triangles[triangleCount*3 + 1] = b;
+        triangles[triangleCount*3 + 2] = c;
+        triangleCount++;
+    }
+
+    // Planes of the triangles around every position
+    Quadric *quadrics = (Quadric *)MemAlloc(positionCount*sizeof(Quadric));
+    for (int t = 0; t < triangleCount; t++) {
+        const int *tri = &triangles[t*3];
+        Vector3 normal = GetTriangleNormal(positions[tri[0]], positions[tri[1]], positions[tri[2]]);
+        float length = Vector3Length(normal);
+        if (length == 0.0f) continue;
+        normal = Vector3Scale(normal, 1.0f/length);
+        for (int c = 0; c < 3; c++) AddPlaneQuadric(&quadrics[tri[c]], normal, positions[tri[0]], 1.0);
+    }
+
+    // Open borders get planes through the edge, perpendicular to the triangle
+    EdgeTable edges = LoadEdgeTable(triangleCount*3);
+    for (int t = 0; t < triangleCount; t++) {
+        for (int c = 0; c < 3; c++) AddEdge(&edges, triangles[t*3 + c], triangles[t*3 + (c + 1)%3]);
+    }
+    for (int t = 0; t < triangleCount; t++) {
+        const int *tri = &triangles[t*3];
+        Vector3 normal = Vector3Normalize(GetTriangleNormal(positions[tri[0]], positions[tri[1]], positions[tri[2]]));
+        for (int c = 0; c < 3; c++) {
+            int a = tri[c], b = tri[(c + 1)%3];
+            if (!IsBorderEdge(&edges, a, b)) continue;
+            Vector3 edge = Vector3Subtract(positions[b], positions[a]);
+            Vector3 borderNormal = Vector3Normalize(Vector3CrossProduct(edge, normal));
+            AddPlaneQuadric(&quadrics[a], borderNormal, positions[a], LOD_BORDER_WEIGHT);
+            AddPlaneQuadric(&quadrics[b], borderNormal, positions[a], LOD_BORDER_WEIGHT);
+        }
+    }
+    UnloadEdgeTable(&edges);
+
+    int *adjacencyOffsets = (int *)MemAlloc((positionCount + 1)*sizeof(int));
+    int *adjacency = (int *)MemAlloc(triangleCount*3*sizeof(int));
+    bool *border = (bool *)MemAlloc(positionCount*sizeof(bool));
+    bool *locked = (bool *)MemAlloc(positionCount*sizeof(bool));
+    Collapse *collapses = (Collapse *)MemAlloc(triangleCount*3*sizeof(Collapse));
+    float maxErrorSqr = maxError*maxError;
+    float reachedError = 0.0f;
+    if (targetTriangles < 1) targetTriangles = 1;
+
+    for (int pass = 0; (pass < LOD_MAX_PASSES) && (triangleCount > targetTriangles); pass++) {
+        // Triangles around every position
+        memset(adjacencyOffsets, 0, (positionCount + 1)*sizeof(int));
+        for (int k = 0; k < triangleCount*3; k++) adjacencyOffsets[triangles[k] + 1]++;
+        for (int p = 0; p < positionCount; p++) adjacencyOffsets[p + 1] += adjacencyOffsets[p];
+        for (int k = 0; k < triangleCount*3; k++) adjacency[adjacencyOffsets[triangles[k]]++] = k/3;
+        for (int p = positionCount; p > 0; p--) adjacencyOffsets[p] = adjacencyOffsets[p - 1];
+        adjacencyOffsets[0] = 0;
+
+        // Border positions of the current triangles
+        EdgeTable passEdges = LoadEdgeTable(triangleCount*3);
+        for (int t = 0; t < triangleCount; t++) {
+            for (int c = 0; c < 3; c++) AddEdge(&passEdges, triangles[t*3 + c], triangles[t*3 + (c + 1)%3]);
+        }
+        memset(border, 0, positionCount*sizeof(bool));
+        for (int t = 0; t < triangleCount; t++) {
+            for (int c = 0; c < 3; c++) {
+                int a = triangles[t*3 + c], b = triangles[t*3 + (c + 1)%3];
+                if (IsBorderEdge(&passEdges, a, b)) border[a] = border[b] = true;
+            }
+        }
+
+        // Cheapest allowed direction of every edge (inner edges are seen from both triangles, taken once)
+        int collapseCount = 0;
+        for (int t = 0; t < triangleCount; t++) {
+            for (int c = 0; c < 3; c++) {
+                int a = triangles[t*3 + c], b = triangles[t*3 + (c + 1)%3];
+                bool borderEdge = IsBorderEdge(&passEdges, a, b);
+                if ((a > b) && !borderEdge) continue;
+
+                // A border position may only slide along the border
+                bool aToB = !border[a] || borderEdge;
+                bool bToA = !border[b] || borderEdge;
+                float errorAToB = aToB ? GetCollapseError(&quadrics[a], &quadrics[b], positions[b]) : 0.0f;
+                float errorBToA = bToA ? GetCollapseError(&quadrics[a], &quadrics[b], positions[a]) : 0.0f;
+                if (aToB && (!bToA || (errorAToB <= errorBToA))) collapses[collapseCount++] = (Collapse){ a, b, errorAToB };
+                else if (bToA) collapses[collapseCount++] = (Collapse){ b, a, errorBToA };
+            }
+        }
+        UnloadEdgeTable(&passEdges);
+        qsort(collapses, collapseCount, sizeof(Collapse), CompareCollapses);
+
+        memset(locked, 0, positionCount*sizeof(bool));
+        int liveCount = triangleCount;
+        int collapsed = 0;
+        for (int i = 0; (i < collapseCount) && (liveCount > targetTriangles); i++) {
+            Collapse collapse = collapses[i];
+            if (collapse.error > maxErrorSqr) break;
+            if (locked[collapse.from] || locked[collapse.to]) continue;
+
+            // Triangles on the edge disappear, the others must keep facing the same way
+            int removed = 0;
+            bool flips = false;
+            for (int k = adjacencyOffsets[collapse.from]; (k < adjacencyOffsets[collapse.from + 1]) && !flips; k++) {
+                const int *tri = &triangles[adjacency[k]*3];
+                if ((tri[0] == collapse.to) || (tri[1] == collapse.to) || (tri[2] == collapse.to)) {
+                    removed++;
+                    continue;
+                }
+
+                Vector3 before[3], after[3];
+                for (int c = 0; c < 3; c++) {
+                    before[c] = positions[tri[c]];
+                    after[c] = (tri[c] == collapse.from) ? positions[collapse.to] : before[c];
+                }
+                Vector3 normalBefore = GetTriangleNormal(before[0], before[1], before[2]);
+                Vector3 normalAfter = GetTriangleNormal(after[0], after[1], after[2]);
+                flips = (Vector3DotProduct(normalBefore, normalAfter) <= 0.0f);
+            }
+            if (flips || (removed == 0) || (liveCount - removed < 1)) continue;
+
+            for (int k = adjacencyOffsets[collapse.from]; k < adjacencyOffsets[collapse.from + 1]; k++) {
+                int *tri = &triangles[adjacency[k]*3];
+                bool onEdge = (tri[0] == collapse.to) || (tri[1] == collapse.to) || (tri[2] == collapse.to);
+                for (int c = 0; c < 3; c++) {
+                    locked[tri[c]] = true;
+                    if (tri[c] == collapse.from) tri[c] = collapse.to;
+                }
+                if (onEdge) tri[0] = tri[1] = tri[2] = -1;
+            }
+
+            AddQuadric(&quadrics[collapse.to], &quadrics[collapse.from]);
+            if (collapse.error > reachedError) reachedError = collapse.error;
+            liveCount -= removed;
+            collapsed++;
+        }
+        if (collapsed == 0) break;
+
+        // Drop the removed triangles, the adjacency is rebuilt by the next pass
+        int kept = 0;
+        for (int t = 0; t < triangleCount; t++) {
+            if (triangles[t*3] == -1) continue;
+            memmove(&triangles[kept*3], &triangles[t*3], 3*sizeof(int));
+            memmove(&corners[kept*3], &corners[t*3], 3*sizeof(int));
+            kept++;
+        }
+        triangleCount = kept;
+    }
+
+    // Every corner takes a vertex at its final position, the used vertices are copied in order of use
+    int *positionVertexOffsets = adjacencyOffsets;   // Reused: vertices at every position
+    int *positionVertices = (int *)MemAlloc(mesh.vertexCount*sizeof(int));
+    memset(positionVertexOffsets, 0, (positionCount + 1)*sizeof(int));
+    for (int v = 0; v < mesh.vertexCount; v++) positionVertexOffsets[weld[v] + 1]++;
+    for (int p = 0; p < positionCount; p++) positionVertexOffsets[p + 1] += positionVertexOffsets[p];
+    for (int v = 0; v < mesh.vertexCount; v++) positionVertices[positionVertexOffsets[weld[v]]++] = v;
+    for (int p = positionCount; p > 0; p--) positionVertexOffsets[p] = positionVertexOffsets[p - 1];
+    positionVertexOffsets[0] = 0;
+
+    int *remap = (int *)MemAlloc(mesh.vertexCount*sizeof(int));
+    memset(remap, 0xff, mesh.vertexCount*sizeof(int));
+    int *usedVertices = (int *)MemAlloc(mesh.vertexCount*sizeof(int));
+    unsigned short *indices = (unsigned short *)MemAlloc(triangleCount*3*sizeof(unsigned short));
+    int usedCount = 0;
+    bool fits = true;
+
+    for (int k = 0; (k < triangleCount*3) && fits; k++) {
+        int vertex = corners[k];
+        int position = triangles[k];
+        if (weld[vertex] != position) {
+            int first = positionVertexOffsets[position];
+            vertex = GetReplacementVertex(mesh, &positionVertices[first], positionVertexOffsets[position + 1] - first, vertex);
+        }
+
+        if (remap[vertex] == -1) {
+            if (usedCount == 65536) fits = false;
+            remap[vertex] = usedCount;
+            usedVertices[usedCount++] = vertex;
+        }
+        indices[k] = (unsigned short)remap[vertex];
+    }
+
+    if (fits) {
+        result.vertexCount = usedCount;
+        result.triangleCount = triangleCount;
+        result.indices = indices;
+        result.vertices = (float *)GatherVertexData(mesh.vertices, 3*sizeof(float), usedVertices, usedCount);
+        result.texcoords = (float *)GatherVertexData(mesh.texcoords, 2*sizeof(float), usedVertices, usedCount);
+        result.texcoords2 = (float *)GatherVertexData(mesh.texcoords2, 2*sizeof(float), usedVertices, usedCount);
+        result.normals = (float *)GatherVertexData(mesh.normals, 3*sizeof(float), usedVertices, usedCount);
+        result.tangents = (float *)GatherVertexData(mesh.tangents, 4*sizeof(float), usedVertices, usedCount);
+        result.colors = (unsigned char *)GatherVertexData(mesh.colors, 4*sizeof(unsigned char), usedVertices, usedCount);
+        result.animVertices = (float *)GatherVertexData(mesh.animVertices, 3*sizeof(float), usedVertices, usedCount);
+        result.animNormals = (float *)GatherVertexData(mesh.animNormals, 3*sizeof(float), usedVertices, usedCount);
+        result.boneIds = (unsigned char *)GatherVertexData(mesh.boneIds, 4*sizeof(unsigned char), usedVertices, usedCount);
+        result.boneWeights = (float *)GatherVertexData(mesh.boneWeights, 4*sizeof(float), usedVertices, usedCount);
+        result.boneCount = mesh.boneCount;
+        if (resultError != NULL) *resultError = sqrtf(reachedError);
+    } else {
+        MemFree(indices);
+    }
+
+    MemFree(usedVertices);
+    MemFree(remap);
+    MemFree(positionVertices);
+    MemFree(collapses);
+    MemFree(locked);
+    MemFree(border);
+    MemFree(adjacency);
+    MemFree(adjacencyOffsets);
+    MemFree(quadrics);
+    MemFree(positions);
+    MemFree(firstVertex);
+    MemFree(weld);
+    MemFree(corners);
+    MemFree(triangles);
+    return result;
+}
+
+//----------------------------------------------------------------------------------
+// Model levels
+//----------------------------------------------------------------------------------
+// Simplification job of one level, every mesh of the model is a separate item
+typedef struct {
+    const Mesh *sources;
+    Mesh *results;
+    const int *targets;
+    float maxError;
+} SimplifyJob;
+
+// Job: simplify the meshes [begin, end) of a model
+static void SimplifyMeshes(void *data, int begin, int end) {
+    const SimplifyJob *job = (const SimplifyJob *)data;
+    for (int m = begin; m < end; m++) job->results[m] = SimplifyMesh(job->sources[m], job->targets[m], job->maxError, NULL);
+}
+
+// Generate and upload the simplified levels of a model (main thread, the meshes are simplified on
+// the job pool). Every level is simplified from the full detail meshes with a target of half the
+// previous level and a doubled error limit, levels stop once the limit keeps most triangles.
+ModelLods GenModelLods(Model model, int maxLevels) {
+    ModelLods lods = { 0 };
+    lods.meshCount = model.meshCount;
+    lods.levels[0] = model.meshes;
+    lods.levelCount = 1;
+    if (model.meshCount == 0) return lods;
+
+    BoundingBox bounds = GetModelBoundingBox(model);
+    lods.radius = 0.5f*Vector3Distance(bounds.min, bounds.max);
+
+    // The error limit is in mesh units, before model.transform
+    BoundingBox meshBounds = GetMeshBoundingBox(model.meshes[0]);
+    for (int m = 0; m < model.meshCount; m++) {
+        lods.triangleCounts[0] += model.meshes[m].triangleCount;
+        BoundingBox box = GetMeshBoundingBox(model.meshes[m]);
+        meshBounds.min = Vector3Min(meshBounds.min, box.min);
+        meshBounds.max = Vector3Max(meshBounds.max, box.max);
+    }
+    float meshRadius = 0.5f*Vector3Distance(meshBounds.min, meshBounds.max);
+    if (maxLevels > MAX_MODEL_LODS) maxLevels = MAX_MODEL_LODS;
+    if (lods.triangleCounts[0] < LOD_MIN_TRIANGLES) return lods;
+
+    int *targets = (int *)MemAlloc(model.meshCount*sizeof(int));
+    for (int level = 1; level < maxLevels; level++) {
+        const Mesh *previous = lods.levels[level - 1];
+        for (int m = 0; m < model.meshCount; m++) targets[m] = (int)(previous[m].triangleCount*LOD_TRIANGLE_RATIO);
+
+        Mesh *meshes = (Mesh *)MemAlloc(model.meshCount*sizeof(Mesh));
+        SimplifyJob job = { model.meshes, meshes, targets, meshRadius*LOD_ERROR_LIMIT*(float)(1 << (level - 1)) };
+        RunParallelFor(model.meshCount, 1, SimplifyMeshes, &job);
+
+        int triangles = 0;
+        bool failed = false;
+        for (int m = 0; m < model.meshCount; m++) {
+            if (meshes[m].vertexCount == 0) failed = true;
+            triangles += meshes[m].triangleCount;
+        }
+
+        // Not uploaded yet, UnloadMesh() only frees the arrays
+        if (failed || (triangles > LOD_MIN_SAVING*lods.triangleCounts[level - 1])) {
+            for (int m = 0; m < model.meshCount; m++) UnloadMesh(meshes[m]);
+            MemFree(meshes);
+            break;
+        }
+
+        // Skinned levels pose with the bone matrices of the full detail meshes (not owned)
+        for (int m = 0; m < model.meshCount; m++) {
+            meshes[m].boneMatrices = model.meshes[m].boneMatrices;
+            meshes[m].boneCount = model.meshes[m].boneCount;
+            UploadMesh(&meshes[m], false);
+        }
+
+        lods.levels[level] = meshes;
+        lods.triangleCounts[level] = triangles;
+        lods.levelCount++;
+    }
+    MemFree(targets);
+
+    return lods;
+}
+
+// Unload the simplified levels (the full detail meshes stay with the model)
+void UnloadModelLods(ModelLods *lods) {
+    for (int level = 1; level < lods->levelCount; level++) {
+        for (int m = 0; m < lods->meshCount; m++) {
+            lods->levels[level][m].boneMatrices = NULL;  // Owned by the full detail mesh
+            UnloadMesh(lods->levels[level][m]);
+        }
+        MemFree(lods->levels[level]);
+    }
+    *lods = (ModelLods){ 0 };
+}
+
+//----------------------------------------------------------------------------------
+// Level selection
+//----------------------------------------------------------------------------------
+// Get the level for an object of a bounding radius at a camera distance (world units): the
+// projected radius is compared to LOD_SCREEN_SIZE, halved for every further level
+int GetLodLevel(int levelCount, float radius, float distance, float fovy) {
+    if ((levelCount <= 1) || (distance <= radius)) return 0;
+
+    float size = radius/(distance*tanf(0.5f*fovy*DEG2RAD));
+    float threshold = LOD_SCREEN_SIZE;
+    int level = 0;
+    while ((level < levelCount - 1) && (size < threshold)) {
+        level++;
+        threshold *= 0.5f;
+    }
+    return level;
+}
+
+// Get the level for a model drawn at a position and scale (0 without LODs)
+int GetModelLodLevel(const ModelLods *lods, Vector3 position, float scale, Camera camera) {
+    if (lods == NULL) return 0;
+    return GetLodLevel(lods->levelCount, lods->radius*scale, Vector3Distance(camera.position, position), camera.fovy);
+}
+
+// Get a copy of the model drawing the meshes of a level (clamped to the levels there are)
+Model GetModelLod(Model model, const ModelLods *lods, int level) {
+    if ((lods == NULL) || (level <= 0)) return model;
+    if (level >= lods->levelCount) level = lods->levelCount - 1;
+    model.meshes = lods->levels[level];
+    return model;
+}
+
+//----------------------------------------------------------------------------------
+// Statistics
+//----------------------------------------------------------------------------------
+// Clear the counts, call once per frame before drawing
+void ResetLodStats(void) {
+    lodStats = (LodStats){ 0 };
+}
+
+// Count objects drawn at a level, with their triangles at that level and at full detail
+void RecordLodDraw(int level, int count, int triangles, int fullTriangles) {
+    lodStats.objects[level] += count;
+    lodStats.triangles += (long long)triangles*count;
+    lodStats.fullTriangles += (long long)fullTriangles*count;
+}
+
+// Count instances of a model drawn at a level (ignored without LODs)
+void RecordModelLodDraw(const ModelLods *lods, int level, int count) {
+    if (lods == NULL) return;
+    RecordLodDraw(level, count, lods->triangleCounts[level], lods->triangleCounts[0]);
+}
+
+// Get the counts gathered since the last reset
+LodStats GetLodStats(void) {
+    return lodStats;
+}
@@ -0,0 +1,48 @@
+// Mesh levels of detail from quadric error simplification
+// SimplifyMesh() collapses edges in order of their quadric error (the summed squared distance to
+// the planes of the triangles around them) until a triangle target or an error limit is reached.
+// Collapses only move a vertex onto one of its neighbours, so every simplified vertex is a copy of
+// an original one: normals, texture coordinates, colors and bone ids/weights stay valid, and a
+// skinned level poses with the bone matrices of the full detail mesh.
+//
+// GenModelLods() builds up to MAX_MODEL_LODS levels of a model at load time, each keeping about
+// half the triangles of the previous one, and the Get*Lod*() functions pick the level for the size
+// an object has on screen. Open borders (leaf cards, petals, fence boards) are held in place.
+
+#ifndef MESH_LOD_H
+#define MESH_LOD_H
+
+#include "raylib.h"
+
+#define MAX_MODEL_LODS 4            // Full detail plus up to 3 simplified levels
+#define LOD_SCREEN_SIZE 0.25f       // Projected radius (fraction of half the screen height) below which level 1 is used, halved for every further level
+
+typedef struct {
+    int levelCount;                     // Levels including the full detail meshes (1: no simplified levels)
+    int meshCount;
+    Mesh *levels[MAX_MODEL_LODS];       // levels[0] is the model's own mesh array, the others belong to the LODs
+    int triangleCounts[MAX_MODEL_LODS]; // Triangles of the whole model at each level
+    float radius;                       // Bounding sphere radius of the model (model.transform applied)
+} ModelLods;
+
+// Objects and triangles drawn through LOD levels in the current frame
+typedef struct {
+    int objects[MAX_MODEL_LODS];        // Objects drawn at each level
+    long long triangles;                // Triangles drawn
+    long long fullTriangles;            // Triangles the same objects have at full detail
+} LodStats;
+
+Mesh SimplifyMesh(Mesh mesh, int targetTriangles, float maxError, float *resultError); // Simplify a mesh to about targetTriangles, moving no surface more than maxError (CPU arrays only, not uploaded)
+ModelLods GenModelLods(Model model, int maxLevels);                // Generate and upload the simplified levels of a model (main thread, the meshes are simplified on the job pool)
+void UnloadModelLods(ModelLods *lods);                             // Unload the simplified levels (the full detail meshes stay with the model)
+
+int GetLodLevel(int levelCount, float radius, float distance, float fovy); // Get the level for an object of a bounding radius at a camera distance
+int GetModelLodLevel(const ModelLods *lods, Vector3 position, float scale, Camera camera); // Get the level for a model drawn at a position and scale (0 without LODs)
+Model GetModelLod(Model model, const ModelLods *lods, int level);  // Get a copy of the model drawing the meshes of a level (clamped to the levels there are)
+
+void ResetLodStats(void);                                          // Clear the counts, call once per frame before drawing
+void RecordLodDraw(int level, int count, int triangles, int fullTriangles); // Count objects drawn at a level, with their triangles at that level and at full detail
+void RecordModelLodDraw(const ModelLods *lods, int level, int count); // Count instances of a model drawn at a level (ignored without LODs)
+LodStats GetLodStats(void);                                        // Get the counts gathered since the last reset
+
+#endif // MESH_LOD_H
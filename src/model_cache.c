@@ -0,0 +1,495 @@
+#include "model_cache.h"
+#include "raymath.h"
+#include "rlgl.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// Web builds always load glTF (no writable resources directory, no mmap)
+#if defined(PLATFORM_WEB)
+    #define MODEL_CACHE_ENABLED 0
+#else
+    #define MODEL_CACHE_ENABLED 1
+    #if defined(__unix__) || defined(__APPLE__)
+        #define MODEL_CACHE_MMAP 1
+        #include <fcntl.h>
+        #include <sys/mman.h>
+        #include <sys/stat.h>
+        #include <unistd.h>
+    #else
+        #define MODEL_CACHE_MMAP 0  // Read the whole file instead
+    #endif
+#endif
+
+#define MODEL_CACHE_VERSION 1       // Bump when the layout below (or raylib's Mesh/ModelAnimation) changes
+#define MODEL_CACHE_DIRECTORY "cache"
+
+#ifndef MAX_MATERIAL_MAPS
+    #define MAX_MATERIAL_MAPS 12    // Maps per material, must match raylib's config.h
+#endif
+
+typedef enum {
+    CACHE_KIND_MODEL = 1,
+    CACHE_KIND_ANIMATIONS = 2
+} CacheKind;
+
+typedef struct {
+    char magic[4];               // "VFMC"
+    uint32_t version;
+    uint64_t sourceHash;         // FNV-1a of the source file
+    uint32_t kind;               // CacheKind
+    uint32_t reserved;
+} CacheHeader;
+
+// Growing output buffer used while baking
+typedef struct {
+    unsigned char *data;
+    int size;
+    int capacity;
+} CacheWriter;
+
+// Bounds checked cursor over a cache file, any overrun marks the cache as invalid
+typedef struct {
+    const unsigned char *data;
+    int size;
+    int offset;
+    bool failed;
+} CacheReader;
+
+// Cache file contents, mapped when possible
+typedef struct {
+    unsigned char *data;
+    int size;
+    bool mapped;
+} CacheFile;
+
+#if MODEL_CACHE_ENABLED
+// Hash a source file (FNV-1a, 64 bit)
+static uint64_t HashFileData(const unsigned char *data, int size) {
+    uint64_t hash = 14695981039346656037ull;
+    for (int i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// Hash the current source file, false if it can not be read
+static bool GetSourceHash(const char *fileName, uint64_t *hash) {
+    int dataSize = 0;
+    unsigned char *data = LoadFileData(fileName, &dataSize);
+    if (data == NULL) return false;
+
+    *hash = HashFileData(data, dataSize);
+    UnloadFileData(data);
+    return true;
+}
+
+// Get the cache file path of a source file (thread safe, no TextFormat)
+static void GetCachePath(const char *fileName, const char *suffix, char *path, int pathSize) {
+    int length = snprintf(path, pathSize, MODEL_CACHE_DIRECTORY "/%s%s", fileName, suffix);
+    for (int i = (int)strlen(MODEL_CACHE_DIRECTORY "/"); (i < length) && (i < pathSize); i++) {
+        if ((path[i] == '/') || (path[i] == '\\') || (path[i] == ':')) path[i] = '_';
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Writing
+//----------------------------------------------------------------------------------
+static void WriteBytes(CacheWriter *writer, const void *data, int size) {
+    if (writer->size + size > writer->capacity) {
+        int newCapacity = (writer->capacity > 0) ? writer->capacity : 4096;
+        while (newCapacity < writer->size + size) newCapacity *= 2;
+        unsigned char *newData = (unsigned char *)MemRealloc(writer->data, newCapacity);
+        if (newData == NULL) return;
+        writer->data = newData;
+        writer->capacity = newCapacity;
+    }
+
+    if (size > 0) memcpy(writer->data + writer->size, data, size);
+    writer->size += size;
+}
+
+static void WriteInt(CacheWriter *writer, int value) {
+    WriteBytes(writer, &value, sizeof(int));
+}
+
+// Write an optional array as its byte size (0 if missing) followed by the bytes
+static void WriteArray(CacheWriter *writer, const void *data, int size) {
+    WriteInt(writer, (data != NULL) ? size : 0);
+    if (data != NULL) WriteBytes(writer, data, size);
+}
+
+static void WriteHeader(CacheWriter *writer, uint64_t sourceHash, CacheKind kind) {
+    CacheHeader header = { { 'V', 'F', 'M', 'C' }, MODEL_CACHE_VERSION, sourceHash, kind, 0 };
+    WriteBytes(writer, &header, sizeof(CacheHeader));
+}
+
+// Write the baked buffer to the cache directory
+static void SaveCacheFile(const char *path, CacheWriter *writer) {
+    if (!DirectoryExists(MODEL_CACHE_DIRECTORY)) MakeDirectory(MODEL_CACHE_DIRECTORY);
+
+    if ((writer->data != NULL) && SaveFileData(path, writer->data, writer->size)) TraceLog(LOG_INFO, "CACHE: [%s] Baked (%i bytes)", path, writer->size);
+    else TraceLog(LOG_WARNING, "CACHE: [%s] Failed to write cache", path);
+
+    MemFree(writer->data);
+    *writer = (CacheWriter){ 0 };
+}
+
+//----------------------------------------------------------------------------------
+// Reading
+//----------------------------------------------------------------------------------
+static CacheFile OpenCacheFile(const char *path) {
+    CacheFile file = { 0 };
+
+#if MODEL_CACHE_MMAP
+    int fd = open(path, O_RDONLY);
+    if (fd == -1) return file;
+
+    struct stat info;
+    if ((fstat(fd, &info) == 0) && (info.st_size > 0)) {
+        void *data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            file.data = (unsigned char *)data;
+            file.size = (int)info.st_size;
+            file.mapped = true;
+        }
+    }
+    close(fd);  // The mapping stays valid
+#else
+    if (FileExists(path)) file.data = LoadFileData(path, &file.size);
+#endif
+
+    return file;
+}
+
+static void CloseCacheFile(CacheFile *file) {
+#if MODEL_CACHE_MMAP
+    if (file->mapped) munmap(file->data, (size_t)file->size);
+    else MemFree(file->data);
+#else
+    UnloadFileData(file->data);
+#endif
+    *file = (CacheFile){ 0 };
+}
+
+// Get a pointer to the next bytes of the file, NULL if the file is too short
+static const void *ReadBytes(CacheReader *reader, int size) {
+    if (reader->failed || (size < 0) || (reader->offset + size > reader->size)) {
+        reader->failed = true;
+        return NULL;
+    }
+
+    const void *data = reader->data + reader->offset;
+    reader->offset += size;
+    return data;
+}
+
+static int ReadInt(CacheReader *reader) {
+    int value = 0;
+    const void *data = ReadBytes(reader, sizeof(int));
+    if (data != NULL) memcpy(&value, data, sizeof(int));
+    return value;
+}
+
+// Read an optional array written by WriteArray() into its own allocation (raylib frees mesh arrays itself)
+static void *ReadArray(CacheReader *reader, int expectedSize) {
+    int size = ReadInt(reader);
+    if (size == 0) return NULL;
+    if (size != expectedSize) {
+        reader->failed = true;
+        return NULL;
+    }
+
+    const void *data = ReadBytes(reader, size);
+    if (data == NULL) return NULL;
+
+    void *copy = MemAlloc(size);
+    if (copy != NULL) memcpy(copy, data, size);
+    return copy;
+}
+
+// Check the header of a mapped cache file against the current source
+static bool ReadHeader(CacheReader *reader, uint64_t sourceHash, CacheKind kind) {
+    const CacheHeader *header = (const CacheHeader *)ReadBytes(reader, sizeof(CacheHeader));
+    if (header == NULL) return false;
+
+    return (memcmp(header->magic, "VFMC", 4) == 0) && (header->version == MODEL_CACHE_VERSION) &&
+           (header->sourceHash == sourceHash) && (header->kind == (uint32_t)kind);
+}
+
+//----------------------------------------------------------------------------------
+// Models
+//----------------------------------------------------------------------------------
+static void SaveModelCache(const char *path, uint64_t sourceHash, Model model) {
+    CacheWriter writer = { 0 };
+    WriteHeader(&writer, sourceHash, CACHE_KIND_MODEL);
+
+    WriteBytes(&writer, &model.transform, sizeof(Matrix));
+    WriteInt(&writer, model.meshCount);
+    WriteInt(&writer, model.materialCount);
+    WriteInt(&writer, model.boneCount);
+
+    for (int i = 0; i < model.meshCount; i++) {
+        Mesh mesh = model.meshes[i];
+        int vc = mesh.vertexCount;
+        WriteInt(&writer, mesh.vertexCount);
+        WriteInt(&writer, mesh.triangleCount);
+        WriteInt(&writer, mesh.boneCount);
+        WriteArray(&writer, mesh.vertices, vc*3*sizeof(float));
+        WriteArray(&writer, mesh.texcoords, vc*2*sizeof(float));
+        WriteArray(&writer, mesh.texcoords2, vc*2*sizeof(float));
+        WriteArray(&writer, mesh.normals, vc*3*sizeof(float));
+        WriteArray(&writer, mesh.tangents, vc*4*sizeof(float));
+        WriteArray(&writer, mesh.colors, vc*4*sizeof(unsigned char));
+        WriteArray(&writer, mesh.indices, mesh.triangleCount*3*sizeof(unsigned short));
+        WriteArray(&writer, mesh.boneIds, vc*4*sizeof(unsigned char));
+        WriteArray(&writer, mesh.boneWeights, vc*4*sizeof(float));
+    }
+    WriteArray(&writer, model.meshMaterial, model.meshCount*sizeof(int));
+
+    // Materials keep their texture pixels, read back from the GPU
+    for (int i = 0; i < model.materialCount; i++) {
+        Material material = model.materials[i];
+        WriteBytes(&writer, material.params, 4*sizeof(float));
+
+        for (int m = 0; m < MAX_MATERIAL_MAPS; m++) {
+            MaterialMap map = material.maps[m];
+            WriteBytes(&writer, &map.color, sizeof(Color));
+            WriteBytes(&writer, &map.value, sizeof(float));
+
+            Image image = { 0 };
+            if ((map.texture.id > 0) && (map.texture.id != rlGetTextureIdDefault())) image = LoadImageFromTexture(map.texture);
+
+            WriteInt(&writer, image.width);
+            WriteInt(&writer, image.height);
+            WriteInt(&writer, image.format);
+            WriteArray(&writer, image.data, GetPixelDataSize(image.width, image.height, image.format));
+            UnloadImage(image);
+        }
+    }
+
+    WriteArray(&writer, model.bones, model.boneCount*sizeof(BoneInfo));
+    WriteArray(&writer, model.bindPose, model.boneCount*sizeof(Transform));
+
+    SaveCacheFile(path, &writer);
+}
+
+static bool LoadModelCache(const char *path, uint64_t sourceHash, Model *result) {
+    CacheFile file = OpenCacheFile(path);
+    if (file.data == NULL) return false;
+
+    CacheReader reader = { file.data, file.size, 0, false };
+    if (!ReadHeader(&reader, sourceHash, CACHE_KIND_MODEL)) {
+        TraceLog(LOG_INFO, "CACHE: [%s] Stale cache, rebaking", path);
+        CloseCacheFile(&file);
+        return false;
+    }
+
+    Model model = { 0 };
+    const Matrix *transform = (const Matrix *)ReadBytes(&reader, sizeof(Matrix));
+    if (transform != NULL) memcpy(&model.transform, transform, sizeof(Matrix));
+    model.meshCount = ReadInt(&reader);
+    model.materialCount = ReadInt(&reader);
+    model.boneCount = ReadInt(&reader);
+
+    if (!reader.failed && (model.meshCount > 0) && (model.materialCount > 0) && (model.boneCount >= 0)) {
+        model.meshes = (Mesh *)MemAlloc(model.meshCount*sizeof(Mesh));
+        model.materials = (Material *)MemAlloc(model.materialCount*sizeof(Material));
+    }
+    else reader.failed = true;
+
+    for (int i = 0; (i < model.meshCount) && !reader.failed; i++) {
+        Mesh *mesh = &model.meshes[i];
+        mesh->vertexCount = ReadInt(&reader);
+        mesh->triangleCount = ReadInt(&reader);
+        mesh->boneCount = ReadInt(&reader);
+
+        int vc = mesh->vertexCount;
+        mesh->vertices = (float *)ReadArray(&reader, vc*3*sizeof(float));
+        mesh->texcoords = (float *)ReadArray(&reader, vc*2*sizeof(float));
+        mesh->texcoords2 = (float *)ReadArray(&reader, vc*2*sizeof(float));
+        mesh->normals = (float *)ReadArray(&reader, vc*3*sizeof(float));
+        mesh->tangents = (float *)ReadArray(&reader, vc*4*sizeof(float));
+        mesh->colors = (unsigned char *)ReadArray(&reader, vc*4*sizeof(unsigned char));
+        mesh->indices = (unsigned short *)ReadArray(&reader, mesh->triangleCount*3*sizeof(unsigned short));
+        mesh->boneIds = (unsigned char *)ReadArray(&reader, vc*4*sizeof(unsigned char));
+        mesh->boneWeights = (float *)ReadArray(&reader, vc*4*sizeof(float));
+
+        // Skinned meshes get the same CPU animation buffers LoadGLTF() creates
+        if ((mesh->boneIds != NULL) && (mesh->boneCount > 0) && !reader.failed) {
+            mesh->animVertices = (float *)MemAlloc(vc*3*sizeof(float));
+            memcpy(mesh->animVertices, mesh->vertices, vc*3*sizeof(float));
+            mesh->animNormals = (float *)MemAlloc(vc*3*sizeof(float));
+            if (mesh->normals != NULL) memcpy(mesh->animNormals, mesh->normals, vc*3*sizeof(float));
+            mesh->boneMatrices = (Matrix *)MemAlloc(mesh->boneCount*sizeof(Matrix));
+            for (int b = 0; b < mesh->boneCount; b++) mesh->boneMatrices[b] = MatrixIdentity();
+        }
+    }
+    if (!reader.failed) model.meshMaterial = (int *)ReadArray(&reader, model.meshCount*sizeof(int));
+
+    for (int i = 0; (i < model.materialCount) && !reader.failed; i++) {
+        Material *material = &model.materials[i];
+        *material = LoadMaterialDefault();
+        const float *params = (const float *)ReadBytes(&reader, 4*sizeof(float));
+        if (params != NULL) memcpy(material->params, params, 4*sizeof(float));
+
+        for (int m = 0; (m < MAX_MATERIAL_MAPS) && !reader.failed; m++) {
+            MaterialMap *map = &material->maps[m];
+            const void *color = ReadBytes(&reader, sizeof(Color));
+            const void *value = ReadBytes(&reader, sizeof(float));
+            if (color != NULL) memcpy(&map->color, color, sizeof(Color));
+            if (value != NULL) memcpy(&map->value, value, sizeof(float));
+
+            Image image = { 0 };
+            image.width = ReadInt(&reader);
+            image.height = ReadInt(&reader);
+            image.format = ReadInt(&reader);
+            image.mipmaps = 1;
+
+            // Pixels are uploaded straight from the mapped file
+            int size = ReadInt(&reader);
+            if (size > 0) {
+                image.data = (void *)ReadBytes(&reader, size);
+                if ((image.data != NULL) && (size == GetPixelDataSize(image.width, image.height, image.format))) map->texture = LoadTextureFromImage(image);
+                else reader.failed = true;
+            }
+        }
+    }
+
+    if (!reader.failed) model.bones = (BoneInfo *)ReadArray(&reader, model.boneCount*sizeof(BoneInfo));
+    if (!reader.failed) model.bindPose = (Transform *)ReadArray(&reader, model.boneCount*sizeof(Transform));
+
+    CloseCacheFile(&file);
+
+    if (reader.failed) {
+        TraceLog(LOG_WARNING, "CACHE: [%s] Corrupted cache, rebaking", path);
+        for (int i = 0; i < model.materialCount; i++) {
+            if (model.materials[i].maps == NULL) continue;
+            for (int m = 0; m < MAX_MATERIAL_MAPS; m++) {
+                if (model.materials[i].maps[m].texture.id != rlGetTextureIdDefault()) UnloadTexture(model.materials[i].maps[m].texture);
+            }
+        }
+        UnloadModel(model);
+        return false;
+    }
+
+    for (int i = 0; i < model.meshCount; i++) UploadMesh(&model.meshes[i], false);
+
+    *result = model;
+    return true;
+}
+
+//----------------------------------------------------------------------------------
+// Animations
+//----------------------------------------------------------------------------------
+static void SaveAnimationsCache(const char *path, uint64_t sourceHash, ModelAnimation *anims, int animCount) {
+    CacheWriter writer = { 0 };
+    WriteHeader(&writer, sourceHash, CACHE_KIND_ANIMATIONS);
+
+    WriteInt(&writer, animCount);
+    for (int i = 0; i < animCount; i++) {
+        WriteInt(&writer, anims[i].boneCount);
+        WriteInt(&writer, anims[i].frameCount);
+        WriteBytes(&writer, anims[i].name, sizeof(anims[i].name));
+        WriteArray(&writer, anims[i].bones, anims[i].boneCount*sizeof(BoneInfo));
+        for (int f = 0; f < anims[i].frameCount; f++) WriteBytes(&writer, anims[i].framePoses[f], anims[i].boneCount*sizeof(Transform));
+    }
+
+    SaveCacheFile(path, &writer);
+}
+
+static ModelAnimation *LoadAnimationsCache(const char *path, uint64_t sourceHash, int *animCount) {
+    CacheFile file = OpenCacheFile(path);
+    if (file.data == NULL) return NULL;
+
+    CacheReader reader = { file.data, file.size, 0, false };
+    if (!ReadHeader(&reader, sourceHash, CACHE_KIND_ANIMATIONS)) {
+        TraceLog(LOG_INFO, "CACHE: [%s] Stale cache, rebaking", path);
+        CloseCacheFile(&file);
+        return NULL;
+    }
+
+    int count = ReadInt(&reader);
+    ModelAnimation *anims = (!reader.failed && (count > 0)) ? (ModelAnimation *)MemAlloc(count*sizeof(ModelAnimation)) : NULL;
+    if (anims == NULL) reader.failed = true;
+
+    for (int i = 0; (i < count) && !reader.failed; i++) {
+        ModelAnimation *anim = &anims[i];
+        anim->boneCount = ReadInt(&reader);
+        anim->frameCount = ReadInt(&reader);
+        const void *name = ReadBytes(&reader, sizeof(anim->name));
+        if (name != NULL) memcpy(anim->name, name, sizeof(anim->name));
+        anim->bones = (BoneInfo *)ReadArray(&reader, anim->boneCount*sizeof(BoneInfo));
+        if (reader.failed || (anim->frameCount <= 0)) {
+            anim->frameCount = 0;   // No poses allocated yet
+            reader.failed = true;
+            break;
+        }
+
+        // Same layout as LoadModelAnimationsGLTF(), UnloadModelAnimation() frees it
+        anim->framePoses = (Transform **)MemAlloc(anim->frameCount*sizeof(Transform *));
+        for (int f = 0; (f < anim->frameCount) && !reader.failed; f++) {
+            const void *poses = ReadBytes(&reader, anim->boneCount*sizeof(Transform));
+            anim->framePoses[f] = (Transform *)MemAlloc(anim->boneCount*sizeof(Transform));
+            if (poses != NULL) memcpy(anim->framePoses[f], poses, anim->boneCount*sizeof(Transform));
+        }
+    }
+
+    CloseCacheFile(&file);
+
+    if (reader.failed) {
+        TraceLog(LOG_WARNING, "CACHE: [%s] Corrupted cache, rebaking", path);
+        if (anims != NULL) UnloadModelAnimations(anims, count); // Entries never read are zeroed
+        return NULL;
+    }
+
+    *animCount = count;
+    return anims;
+}
+#endif
+
+// Load a model from its baked cache, baking it on a miss (main thread, uses the GPU)
+Model LoadModelCached(const char *fileName) {
+#if MODEL_CACHE_ENABLED
+    uint64_t sourceHash = 0;
+    if (!GetSourceHash(fileName, &sourceHash)) return LoadModel(fileName);
+
+    char path[512] = { 0 };
+    GetCachePath(fileName, ".model.vfc", path, sizeof(path));
+
+    Model model = { 0 };
+    if (LoadModelCache(path, sourceHash, &model)) {
+        TraceLog(LOG_INFO, "CACHE: [%s] Model loaded from cache", fileName);
+        return model;
+    }
+
+    model = LoadModel(fileName);
+    if (model.meshCount > 0) SaveModelCache(path, sourceHash, model);
+    return model;
+#else
+    return LoadModel(fileName);
+#endif
+}
+
+// Load animations from their baked cache, baking them on a miss (any thread)
+ModelAnimation *LoadModelAnimationsCached(const char *fileName, int *animCount) {
+    *animCount = 0;
+#if MODEL_CACHE_ENABLED
+    uint64_t sourceHash = 0;
+    if (!GetSourceHash(fileName, &sourceHash)) return LoadModelAnimations(fileName, animCount);
+
+    char path[512] = { 0 };
+    GetCachePath(fileName, ".anim.vfc", path, sizeof(path));
+
+    ModelAnimation *anims = LoadAnimationsCache(path, sourceHash, animCount);
+    if (anims != NULL) return anims;
+
+    anims = LoadModelAnimations(fileName, animCount);
+    if ((anims != NULL) && (*animCount > 0)) SaveAnimationsCache(path, sourceHash, anims, *animCount);
+    return anims;
+#else
+    return LoadModelAnimations(fileName, animCount);
+#endif
+}
@@ -0,0 +1,16 @@
+// Baked binary cache for glTF models and animations
+// The first load of a .glb goes through raylib's glTF loader and writes the result (vertex/index
+// streams, materials with their texture pixels, skeleton and the baked animation frame poses)
+// into resources/cache/. Later launches map the cache file and rebuild the model from it without
+// parsing glTF. Each cache file stores a hash of its source file, an edited source (or a cache
+// written by an older MODEL_CACHE_VERSION) is detected and rebaked automatically.
+
+#ifndef MODEL_CACHE_H
+#define MODEL_CACHE_H
+
+#include "raylib.h"
+
+Model LoadModelCached(const char *fileName);                                     // Load a model from its baked cache, baking it on a miss (main thread, uses the GPU)
+ModelAnimation *LoadModelAnimationsCached(const char *fileName, int *animCount); // Load animations from their baked cache, baking them on a miss (any thread)
+
+#endif // MODEL_CACHE_H
@@ -0,0 +1,183 @@
+#include "profiler.h"
+#include "trace_capture.h"
+
+#include <stdio.h>
+
+#define PROFILE_GRAPH_WIDTH (PROFILER_OVERLAY_WIDTH - 20)
+#define PROFILE_GRAPH_HEIGHT 60
+#define PROFILE_GRAPH_MAX_MS 33.3f    // Top of the graph, taller bars are clipped
+#define PROFILE_TARGET_MS 16.7f       // Reference line drawn over the graph (60 fps)
+
+// One stored frame, times in milliseconds
+typedef struct {
+    float frameTime;
+    float zoneTimes[PROFILE_ZONE_COUNT];
+} ProfileFrame;
+
+static ProfileFrame history[PROFILE_HISTORY_FRAMES] = { 0 };
+static int historyHead = 0;                          // Slot the next frame is written to
+static int historyCount = 0;
+static unsigned int framesRecorded = 0;              // Total frames stored, used as the CSV frame number
+
+static ProfileFrame currentFrame = { 0 };
+static double frameStartTime = -1.0;
+static double zoneStartTime[PROFILE_ZONE_COUNT] = { 0 };
+
+// Zones drawn indented below their parent in the overlay
+static bool IsNestedZone(ProfileZone zone) {
+    return (zone != PROFILE_ZONE_UPDATE) && (zone != PROFILE_ZONE_DRAW) && (zone != PROFILE_ZONE_PRESENT);
+}
+
+// Get a stored frame, 0 is the oldest
+static const ProfileFrame *GetHistoryFrame(int index) {
+    int slot = (historyHead - historyCount + index + PROFILE_HISTORY_FRAMES)%PROFILE_HISTORY_FRAMES;
+    return &history[slot];
+}
+
+// Store the previous frame and start a new one
+void BeginProfileFrame(void) {
+    double now = GetTime();
+
+    if (frameStartTime >= 0.0) {
+        if (IsTraceCapturing()) TraceSpan("Frame", "frame", frameStartTime, now);
+
+        currentFrame.frameTime = (float)((now - frameStartTime)*1000.0);
+        history[historyHead] = currentFrame;
+        historyHead = (historyHead + 1)%PROFILE_HISTORY_FRAMES;
+        if (historyCount < PROFILE_HISTORY_FRAMES) historyCount++;
+        framesRecorded++;
+    }
+
+    currentFrame = (ProfileFrame){ 0 };
+    frameStartTime = now;
+}
+
+// Start timing a zone
+void BeginProfileZone(ProfileZone zone) {
+    zoneStartTime[zone] = GetTime();
+}
+
+// Stop timing a zone, adds to its total for the frame
+void EndProfileZone(ProfileZone zone) {
+    double now = GetTime();
+    currentFrame.zoneTimes[zone] += (float)((now - zoneStartTime[zone])*1000.0);
+
+    if (IsTraceCapturing()) TraceSpan(GetProfileZoneName(zone), "frame", zoneStartTime[zone], now);
+}
+
+// Get a display name for a zone
+const char *GetProfileZoneName(ProfileZone zone) {
+    switch (zone) {
+        case PROFILE_ZONE_UPDATE: return "Update";
+        case PROFILE_ZONE_CAMERA: return "Camera";
+        case PROFILE_ZONE_SOUNDS: return "Animal sounds";
+        case PROFILE_ZONE_TERRAIN_LOD: return "Terrain chunks";
+        case PROFILE_ZONE_ANIMALS: return "Animals";
+        case PROFILE_ZONE_HUMAN: return "Human";
+        case PROFILE_ZONE_INTERACTION: return "Interaction";
+        case PROFILE_ZONE_PRODUCTION: return "Hunger/production";
+        case PROFILE_ZONE_DRAW: return "Draw";
+        case PROFILE_ZONE_DRAW_SKY: return "Sky";
+        case PROFILE_ZONE_DRAW_TERRAIN: return "Terrain";
+        case PROFILE_ZONE_DRAW_ROADS: return "Roads";
+        case PROFILE_ZONE_DRAW_BUILDINGS: return "Buildings";
+        case PROFILE_ZONE_DRAW_PLANTS: return "Plants";
+        case PROFILE_ZONE_DRAW_ANIMALS: return "Animals";
+        case PROFILE_ZONE_DRAW_HUMAN: return "Human";
+        case PROFILE_ZONE_DRAW_CLOUDS: return "Clouds";
+        case PROFILE_ZONE_DRAW_HUD: return "HUD";
+        case PROFILE_ZONE_DRAW_MENUS: return "Menus";
+        case PROFILE_ZONE_PRESENT: return "Present";
+        default: return "Unknown";
+    }
+}
+
+// Draw the per-zone min/avg/max table and the frame time graph
+void DrawProfilerOverlay(int posX, int posY) {
+    const int lineHeight = 12;
+    const int tableHeight = (PROFILE_ZONE_COUNT + 3)*lineHeight;
+    const int height = tableHeight + PROFILE_GRAPH_HEIGHT + 25;
+
+    DrawRectangle(posX, posY, PROFILER_OVERLAY_WIDTH, height, Fade(BLACK, 0.6f));
+    if (historyCount == 0) return;
+
+    // Frame time summary
+    float frameMin = GetHistoryFrame(0)->frameTime, frameMax = 0.0f, frameSum = 0.0f;
+    for (int i = 0; i < historyCount; i++) {
+        float t = GetHistoryFrame(i)->frameTime;
+        if (t < frameMin) frameMin = t;
+        if (t > frameMax) frameMax = t;
+        frameSum += t;
+    }
+
+    int y = posY + 5;
+    DrawText(TextFormat("ms, last %d frames", historyCount), posX + 10, y, 10, GRAY);
+    DrawText("   min    avg    max", posX + 150, y, 10, GRAY);
+    y += lineHeight;
+    DrawText("Frame", posX + 10, y, 10, WHITE);
+    DrawText(TextFormat("%6.2f %6.2f %6.2f", frameMin, frameSum/historyCount, frameMax), posX + 150, y, 10, WHITE);
+    y += lineHeight + 4;
+
+    // Per-zone table
+    for (int z = 0; z < PROFILE_ZONE_COUNT; z++) {
+        float zoneMin = GetHistoryFrame(0)->zoneTimes[z], zoneMax = 0.0f, zoneSum = 0.0f;
+        for (int i = 0; i < historyCount; i++) {
+            float t = GetHistoryFrame(i)->zoneTimes[z];
+            if (t < zoneMin) zoneMin = t;
+            if (t > zoneMax) zoneMax = t;
+            zoneSum += t;
+        }
+
+        int indent = IsNestedZone((ProfileZone)z) ? 20 : 10;
+        DrawText(GetProfileZoneName((ProfileZone)z), posX + indent, y, 10, IsNestedZone((ProfileZone)z) ? LIGHTGRAY : WHITE);
+        DrawText(TextFormat("%6.2f %6.2f %6.2f", zoneMin, zoneSum/historyCount, zoneMax), posX + 150, y, 10, LIGHTGRAY);
+        y += lineHeight;
+    }
+
+    // Frame time graph, newest frame on the right
+    int graphX = posX + 10;
+    int graphY = y + 5;
+    DrawRectangleLines(graphX, graphY, PROFILE_GRAPH_WIDTH, PROFILE_GRAPH_HEIGHT, GRAY);
+
+    float barWidth = (float)PROFILE_GRAPH_WIDTH/PROFILE_HISTORY_FRAMES;
+    int firstBar = PROFILE_HISTORY_FRAMES - historyCount;
+    for (int i = 0; i < historyCount; i++) {
+        float t = GetHistoryFrame(i)->frameTime;
+        float barHeight = (t < PROFILE_GRAPH_MAX_MS) ? t/PROFILE_GRAPH_MAX_MS*PROFILE_GRAPH_HEIGHT : (float)PROFILE_GRAPH_HEIGHT;
+        Color color = (t <= PROFILE_TARGET_MS) ? GREEN : ((t <= PROFILE_GRAPH_MAX_MS) ? YELLOW : RED);
+        DrawRectangleRec((Rectangle){ graphX + (firstBar + i)*barWidth, graphY + PROFILE_GRAPH_HEIGHT - barHeight, barWidth, barHeight }, color);
+    }
+
+    int targetY = graphY + PROFILE_GRAPH_HEIGHT - (int)(PROFILE_TARGET_MS/PROFILE_GRAPH_MAX_MS*PROFILE_GRAPH_HEIGHT);
+    DrawLine(graphX, targetY, graphX + PROFILE_GRAPH_WIDTH, targetY, SKYBLUE);
+    DrawText("16.7 ms", graphX + PROFILE_GRAPH_WIDTH - 45, targetY - 11, 10, SKYBLUE);
+}
+
+// Write the stored frames (oldest first) as CSV, times in ms
+bool ExportProfilerCsv(const char *fileName) {
+    FILE *file = fopen(fileName, "w");
+    if (file == NULL) {
+        TraceLog(LOG_WARNING, "PROFILER: [%s] Failed to open file for writing", fileName);
+        return false;
+    }
+
+    fprintf(file, "frame,frame_ms");
+    for (int z = 0; z < PROFILE_ZONE_COUNT; z++) {
+        // Nested zone names are not unique ("Animals"), prefix them with their phase
+        const char *phase = (z > PROFILE_ZONE_DRAW && z < PROFILE_ZONE_PRESENT) ? "draw_" : "";
+        fprintf(file, ",%s%s", phase, GetProfileZoneName((ProfileZone)z));
+    }
+    fprintf(file, "\n");
+
+    unsigned int firstFrame = framesRecorded - (unsigned int)historyCount;
+    for (int i = 0; i < historyCount; i++) {
+        const ProfileFrame *frame = GetHistoryFrame(i);
+        fprintf(file, "%u,%.3f", firstFrame + i, frame->frameTime);
+        for (int z = 0; z < PROFILE_ZONE_COUNT; z++) fprintf(file, ",%.3f", frame->zoneTimes[z]);
+        fprintf(file, "\n");
+    }
+
+    fclose(file);
+    TraceLog(LOG_INFO, "PROFILER: [%s] Exported %d frames", fileName, historyCount);
+    return true;
+}
@@ -0,0 +1,49 @@
+// CPU frame profiler
+// Main-loop phases are wrapped in Begin/EndProfileZone() pairs (zones may nest and may be
+// entered several times per frame, their times add up). Every frame the zone totals are pushed
+// into a ring buffer of the last PROFILE_HISTORY_FRAMES frames, which the overlay summarizes
+// (min/avg/max per zone plus a frame time graph) and the CSV export writes out.
+// Zones and frames are also recorded as spans while a trace capture runs (see trace_capture.h).
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "raylib.h"
+
+#define PROFILE_HISTORY_FRAMES 300
+#define PROFILER_OVERLAY_WIDTH 320   // Width of DrawProfilerOverlay() in pixels
+
+// Profiled main-loop phases, the overlay lists them in this order
+typedef enum {
+    PROFILE_ZONE_UPDATE,
+    PROFILE_ZONE_CAMERA,
+    PROFILE_ZONE_SOUNDS,
+    PROFILE_ZONE_TERRAIN_LOD,
+    PROFILE_ZONE_ANIMALS,
+    PROFILE_ZONE_HUMAN,
+    PROFILE_ZONE_INTERACTION,
+    PROFILE_ZONE_PRODUCTION,
+    PROFILE_ZONE_DRAW,
+    PROFILE_ZONE_DRAW_SKY,
+    PROFILE_ZONE_DRAW_TERRAIN,
+    PROFILE_ZONE_DRAW_ROADS,
+    PROFILE_ZONE_DRAW_BUILDINGS,
+    PROFILE_ZONE_DRAW_PLANTS,
+    PROFILE_ZONE_DRAW_ANIMALS,
+    PROFILE_ZONE_DRAW_HUMAN,
+    PROFILE_ZONE_DRAW_CLOUDS,
+    PROFILE_ZONE_DRAW_HUD,
+    PROFILE_ZONE_DRAW_MENUS,
+    PROFILE_ZONE_PRESENT,        // EndDrawing(): buffer swap and frame limiter wait
+    PROFILE_ZONE_COUNT
+} ProfileZone;
+
+void BeginProfileFrame(void);                       // Store the previous frame and start a new one, call at the top of the main loop
+void BeginProfileZone(ProfileZone zone);            // Start timing a zone
+void EndProfileZone(ProfileZone zone);              // Stop timing a zone, adds to its total for the frame
+
+const char *GetProfileZoneName(ProfileZone zone);   // Get a display name for a zone
+void DrawProfilerOverlay(int posX, int posY);       // Draw the per-zone min/avg/max table and the frame time graph
+bool ExportProfilerCsv(const char *fileName);       // Write the stored frames (oldest first) as CSV, times in ms
+
+#endif // PROFILER_H
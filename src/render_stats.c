@@ -0,0 +1,109 @@
+#include "render_stats.h"
+
+#include <stddef.h>
+
+// Same condition rlgl uses to load desktop GL through glad (rlgl defaults to OpenGL 3.3)
+#if !defined(PLATFORM_WEB) && !defined(GRAPHICS_API_OPENGL_11) && !defined(GRAPHICS_API_OPENGL_ES2) && !defined(GRAPHICS_API_OPENGL_ES3)
+    #define RENDER_STATS_GLAD 1
+    #include "external/glad.h"      // Declarations only, rlgl holds the implementation
+#else
+    #define RENDER_STATS_GLAD 0
+#endif
+
+static int drawCalls = 0;
+static long long triangles = 0;
+
+#if RENDER_STATS_GLAD
+static PFNGLDRAWARRAYSPROC drawArrays = NULL;
+static PFNGLDRAWELEMENTSPROC drawElements = NULL;
+static PFNGLDRAWARRAYSINSTANCEDPROC drawArraysInstanced = NULL;
+static PFNGLDRAWELEMENTSINSTANCEDPROC drawElementsInstanced = NULL;
+
+// Triangles drawn by a primitive of count vertices (lines and points are not counted)
+static long long GetPrimitiveTriangles(GLenum mode, GLsizei count) {
+    switch (mode) {
+        case GL_TRIANGLES: return count/3;
+        case GL_TRIANGLE_STRIP:
+        case GL_TRIANGLE_FAN: return (count > 2) ? count - 2 : 0;
+        default: return 0;
+    }
+}
+
+static void GLAD_API_PTR CountDrawArrays(GLenum mode, GLint first, GLsizei count) {
+    drawCalls++;
+    triangles += GetPrimitiveTriangles(mode, count);
+    drawArrays(mode, first, count);
+}
+
+static void GLAD_API_PTR CountDrawElements(GLenum mode, GLsizei count, GLenum type, const void *indices) {
+    drawCalls++;
+    triangles += GetPrimitiveTriangles(mode, count);
+    drawElements(mode, count, type, indices);
+}
+
+static void GLAD_API_PTR CountDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instanceCount) {
+    drawCalls++;
+    triangles += GetPrimitiveTriangles(mode, count)*instanceCount;
+    drawArraysInstanced(mode, first, count, instanceCount);
+}
+
+static void GLAD_API_PTR CountDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instanceCount) {
+    drawCalls++;
+    triangles += GetPrimitiveTriangles(mode, count)*instanceCount;
+    drawElementsInstanced(mode, count, type, indices, instanceCount);
+}
+#endif
+
+// Start counting GL draws, call after InitWindow()
+void InitRenderStats(void) {
+#if RENDER_STATS_GLAD
+    if (drawArrays != NULL) return;     // Already wrapped
+
+    if ((glad_glDrawArrays == NULL) || (glad_glDrawElements == NULL)) {
+        TraceLog(LOG_WARNING, "RENDER: GL not loaded, draw calls are not counted");
+        return;
+    }
+
+    drawArrays = glad_glDrawArrays;
+    drawElements = glad_glDrawElements;
+    glad_glDrawArrays = CountDrawArrays;
+    glad_glDrawElements = CountDrawElements;
+
+    // Instanced entry points are optional (OpenGL 2.1 without the extension)
+    if (glad_glDrawArraysInstanced != NULL) {
+        drawArraysInstanced = glad_glDrawArraysInstanced;
+        glad_glDrawArraysInstanced = CountDrawArraysInstanced;
+    }
+    if (glad_glDrawElementsInstanced != NULL) {
+        drawElementsInstanced = glad_glDrawElementsInstanced;
+        glad_glDrawElementsInstanced = CountDrawElementsInstanced;
+    }
+
+    TraceLog(LOG_INFO, "RENDER: Counting draw calls on %s", GetRenderDeviceName());
+#endif
+}
+
+// Zero the counters, call once per frame
+void ResetRenderStats(void) {
+    drawCalls = 0;
+    triangles = 0;
+}
+
+// Get the draw calls since the last reset
+int GetRenderDrawCalls(void) {
+    return drawCalls;
+}
+
+// Get the triangles submitted since the last reset (instances included)
+long long GetRenderTriangles(void) {
+    return triangles;
+}
+
+// Get the GL renderer string ("llvmpipe (LLVM ...)" under Mesa's software driver)
+const char *GetRenderDeviceName(void) {
+#if RENDER_STATS_GLAD
+    const GLubyte *renderer = (glad_glGetString != NULL) ? glad_glGetString(GL_RENDERER) : NULL;
+    if (renderer != NULL) return (const char *)renderer;
+#endif
+    return "unknown";
+}
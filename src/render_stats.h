@@ -0,0 +1,18 @@
+// Draw call and triangle counters
+// Wraps the GL draw entry points rlgl calls through (the glad function pointers), so every draw
+// is counted: batched 2D/3D shapes, DrawMesh(), instanced vegetation, text and the HUD.
+// Counting starts with InitRenderStats() after InitWindow(). Web and OpenGL 1.1 builds don't
+// load GL through glad and always report zero.
+
+#ifndef RENDER_STATS_H
+#define RENDER_STATS_H
+
+#include "raylib.h"
+
+void InitRenderStats(void);              // Start counting GL draws, call after InitWindow()
+void ResetRenderStats(void);             // Zero the counters, call once per frame
+int GetRenderDrawCalls(void);            // Get the draw calls since the last reset
+long long GetRenderTriangles(void);      // Get the triangles submitted since the last reset (instances included)
+const char *GetRenderDeviceName(void);   // Get the GL renderer string ("llvmpipe (LLVM ...)" under Mesa's software driver)
+
+#endif // RENDER_STATS_H
@@ -0,0 +1,208 @@
+#include "road_grid.h"
+#include "raymath.h"
+
+#include <float.h>
+#include <stddef.h>
+#include <math.h>
+
+// Road segment as stored by the grid
+typedef struct {
+    Vector3 p1;
+    Vector3 p2;
+    int roadId;          // -1 once the road has been rebinned or removed
+    int segmentIndex;
+} RoadGridSegment;
+
+// Segments binned into one cell
+typedef struct {
+    int *segments;
+    int count;
+    int capacity;
+} RoadGridCell;
+
+static RoadGridSegment *gridSegments = NULL;
+static int gridSegmentCount = 0;
+static int gridSegmentCapacity = 0;
+
+static RoadGridCell *gridCells = NULL;
+static int gridCellsPerSide = 0;
+static float gridCellSize = 1.0f;
+static float gridOrigin = 0.0f;         // Min X and Z of the grid
+static float gridMaxDistance = 0.0f;    // Queries up to this distance are answered from a single cell
+
+// Get the closest point of a segment to a position (same projection the game code used)
+static float GetSegmentDistance(Vector3 position, Vector3 p1, Vector3 p2) {
+    Vector3 segmentVec = Vector3Subtract(p2, p1);
+    float segmentLengthSq = Vector3LengthSqr(segmentVec);
+    if (segmentLengthSq == 0.0f) return FLT_MAX; // Zero length segments never match
+
+    float t = Vector3DotProduct(Vector3Subtract(position, p1), segmentVec)/segmentLengthSq;
+    t = Clamp(t, 0.0f, 1.0f);
+
+    return Vector3Distance(position, Vector3Add(p1, Vector3Scale(segmentVec, t)));
+}
+
+// Get the XZ distance from a point to a segment
+static float GetSegmentDistanceXZ(Vector2 position, Vector2 p1, Vector2 p2) {
+    Vector2 segmentVec = Vector2Subtract(p2, p1);
+    float segmentLengthSq = Vector2LengthSqr(segmentVec);
+    float t = (segmentLengthSq > 0.0f) ? Clamp(Vector2DotProduct(Vector2Subtract(position, p1), segmentVec)/segmentLengthSq, 0.0f, 1.0f) : 0.0f;
+
+    return Vector2Distance(position, Vector2Add(p1, Vector2Scale(segmentVec, t)));
+}
+
+// Get the cell coordinate of a world coordinate (may be outside the grid)
+static int GetCellCoord(float value) {
+    return (int)floorf((value - gridOrigin)/gridCellSize);
+}
+
+// Add a segment to a cell list
+static void AddToCell(RoadGridCell *cell, int segment) {
+    if (cell->count == cell->capacity) {
+        int newCapacity = (cell->capacity > 0) ? cell->capacity*2 : 4;
+        int *segments = (int *)MemRealloc(cell->segments, newCapacity*sizeof(int));
+        if (segments == NULL) return;
+        cell->segments = segments;
+        cell->capacity = newCapacity;
+    }
+    cell->segments[cell->count++] = segment;
+}
+
+// Bin a stored segment into every cell within gridMaxDistance of it, or unbin it from them
+static void BinSegment(int segment, bool add) {
+    RoadGridSegment *s = &gridSegments[segment];
+    Vector2 p1 = { s->p1.x, s->p1.z };
+    Vector2 p2 = { s->p2.x, s->p2.z };
+    float halfDiagonal = gridCellSize*0.7072f;
+
+    int minX = GetCellCoord(fminf(p1.x, p2.x) - gridMaxDistance), maxX = GetCellCoord(fmaxf(p1.x, p2.x) + gridMaxDistance);
+    int minZ = GetCellCoord(fminf(p1.y, p2.y) - gridMaxDistance), maxZ = GetCellCoord(fmaxf(p1.y, p2.y) + gridMaxDistance);
+    if (minX < 0) minX = 0;
+    if (minZ < 0) minZ = 0;
+    if (maxX >= gridCellsPerSide) maxX = gridCellsPerSide - 1;
+    if (maxZ >= gridCellsPerSide) maxZ = gridCellsPerSide - 1;
+
+    for (int z = minZ; z <= maxZ; z++) {
+        for (int x = minX; x <= maxX; x++) {
+            RoadGridCell *cell = &gridCells[z*gridCellsPerSide + x];
+
+            if (!add) {
+                for (int k = 0; k < cell->count; k++) {
+                    if (cell->segments[k] == segment) cell->segments[k--] = cell->segments[--cell->count];
+                }
+                continue;
+            }
+
+            // Conservative: any point of the cell may be within gridMaxDistance of the segment
+            Vector2 cellCenter = { gridOrigin + (x + 0.5f)*gridCellSize, gridOrigin + (z + 0.5f)*gridCellSize };
+            if (GetSegmentDistanceXZ(cellCenter, p1, p2) > gridMaxDistance + halfDiagonal) continue;
+            AddToCell(cell, segment);
+        }
+    }
+}
+
+// Create the grid centered at the origin
+void InitRoadGrid(float worldSize, float cellSize, float maxQueryDistance) {
+    UnloadRoadGrid();
+
+    gridCellSize = cellSize;
+    gridCellsPerSide = (int)ceilf(worldSize/cellSize);
+    gridOrigin = -gridCellsPerSide*cellSize/2.0f;
+    gridMaxDistance = maxQueryDistance;
+    gridCells = (RoadGridCell *)MemAlloc(gridCellsPerSide*gridCellsPerSide*sizeof(RoadGridCell));
+}
+
+// Free the grid memory
+void UnloadRoadGrid(void) {
+    for (int i = 0; i < gridCellsPerSide*gridCellsPerSide; i++) MemFree(gridCells[i].segments);
+    MemFree(gridCells);
+    MemFree(gridSegments);
+
+    gridCells = NULL;
+    gridCellsPerSide = 0;
+    gridSegments = NULL;
+    gridSegmentCount = 0;
+    gridSegmentCapacity = 0;
+}
+
+// (Re)bin the segments of one road, numPoints < 2 removes it
+void SetRoadGridRoad(int roadId, const Vector3 *points, int numPoints) {
+    // Drop the previous segments of this road, only the cells they were binned in are touched
+    for (int i = 0; i < gridSegmentCount; i++) {
+        if (gridSegments[i].roadId != roadId) continue;
+        BinSegment(i, false);
+        gridSegments[i].roadId = -1;
+    }
+
+    for (int j = 0; j < numPoints - 1; j++) {
+        if (gridSegmentCount == gridSegmentCapacity) {
+            int newCapacity = (gridSegmentCapacity > 0) ? gridSegmentCapacity*2 : 64;
+            RoadGridSegment *segments = (RoadGridSegment *)MemRealloc(gridSegments, newCapacity*sizeof(RoadGridSegment));
+            if (segments == NULL) {
+                TraceLog(LOG_ERROR, "ROADGRID: Failed to grow segment storage to %d segments", newCapacity);
+                return;
+            }
+            gridSegments = segments;
+            gridSegmentCapacity = newCapacity;
+        }
+
+        gridSegments[gridSegmentCount] = (RoadGridSegment){ points[j], points[j + 1], roadId, j };
+        BinSegment(gridSegmentCount, true);
+        gridSegmentCount++;
+    }
+}
+
+// Get the closest segment within maxDistance (roadId -1 checks every road)
+RoadQuery QueryRoadGrid(Vector3 position, float maxDistance, int roadId) {
+    RoadQuery result = { FLT_MAX, -1, -1 };
+
+    // Large radii or positions outside the grid fall back to checking every segment
+    int cellX = GetCellCoord(position.x);
+    int cellZ = GetCellCoord(position.z);
+    bool useCell = (maxDistance <= gridMaxDistance) && (cellX >= 0) && (cellZ >= 0) && (cellX < gridCellsPerSide) && (cellZ < gridCellsPerSide);
+    const RoadGridCell *cell = useCell ? &gridCells[cellZ*gridCellsPerSide + cellX] : NULL;
+    int candidateCount = useCell ? cell->count : gridSegmentCount;
+
+    for (int k = 0; k < candidateCount; k++) {
+        const RoadGridSegment *segment = &gridSegments[useCell ? cell->segments[k] : k];
+        if (segment->roadId == -1 || (roadId != -1 && segment->roadId != roadId)) continue;
+
+        float distance = GetSegmentDistance(position, segment->p1, segment->p2);
+        if (distance < result.distance) {
+            result.distance = distance;
+            result.roadId = segment->roadId;
+            result.segmentIndex = segment->segmentIndex;
+        }
+    }
+
+    if (result.distance >= maxDistance) {
+        result.roadId = -1;
+        result.segmentIndex = -1;
+    }
+
+    return result;
+}
+
+// Count the roads with a control point closer than threshold
+int CountRoadsNearPoint(Vector3 position, float threshold) {
+    int cellX = GetCellCoord(position.x);
+    int cellZ = GetCellCoord(position.z);
+    bool useCell = (threshold <= gridMaxDistance) && (cellX >= 0) && (cellZ >= 0) && (cellX < gridCellsPerSide) && (cellZ < gridCellsPerSide);
+    const RoadGridCell *cell = useCell ? &gridCells[cellZ*gridCellsPerSide + cellX] : NULL;
+    int candidateCount = useCell ? cell->count : gridSegmentCount;
+
+    // Control points are segment endpoints, so any road with one close enough has a segment in this cell
+    unsigned int roadMask = 0;
+    int roadCount = 0;
+    for (int k = 0; k < candidateCount; k++) {
+        const RoadGridSegment *segment = &gridSegments[useCell ? cell->segments[k] : k];
+        if (segment->roadId < 0 || segment->roadId >= 32 || (roadMask & (1u << segment->roadId))) continue;
+
+        if ((Vector3Distance(position, segment->p1) < threshold) || (Vector3Distance(position, segment->p2) < threshold)) {
+            roadMask |= (1u << segment->roadId);
+            roadCount++;
+        }
+    }
+
+    return roadCount;
+}
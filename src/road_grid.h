@@ -0,0 +1,25 @@
+// Segment-binned grid over the XZ plane for constant time road queries
+// Every road segment is binned into the cells within RoadGrid's max query distance of it, so a
+// query only projects the point onto the few segments stored in its own cell. Roads are
+// (re)binned one at a time when they are generated.
+
+#ifndef ROAD_GRID_H
+#define ROAD_GRID_H
+
+#include "raylib.h"
+
+// Result of a road query
+typedef struct {
+    float distance;      // Distance to the closest segment centerline (only exact when below the query distance)
+    int roadId;          // Road of the closest segment, -1 if no segment is within the query distance
+    int segmentIndex;    // Index of the closest segment inside its road
+} RoadQuery;
+
+void InitRoadGrid(float worldSize, float cellSize, float maxQueryDistance); // Create the grid centered at the origin
+void UnloadRoadGrid(void);                                                   // Free the grid memory
+void SetRoadGridRoad(int roadId, const Vector3 *points, int numPoints);     // (Re)bin the segments of one road, numPoints < 2 removes it
+
+RoadQuery QueryRoadGrid(Vector3 position, float maxDistance, int roadId);   // Get the closest segment within maxDistance (roadId -1 checks every road)
+int CountRoadsNearPoint(Vector3 position, float threshold);                 // Count the roads with a control point closer than threshold
+
+#endif // ROAD_GRID_H
@@ -0,0 +1,106 @@
+#include "scenario.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// Load a scenario file (empty "default" scenario on failure)
+Scenario LoadScenario(const char *fileName) {
+    Scenario scenario = { 0 };
+    snprintf(scenario.name, sizeof(scenario.name), "%s", "default");
+
+    char *text = LoadFileText(fileName);
+    if (text == NULL) {
+        TraceLog(LOG_WARNING, "SCENARIO: [%s] Failed to load scenario, using the default counts", fileName);
+        return scenario;
+    }
+    snprintf(scenario.name, sizeof(scenario.name), "%s", GetFileNameWithoutExt(fileName));
+
+    int lineNumber = 1;
+    char *line = text;
+    while ((line != NULL) && (*line != '\0')) {
+        char *next = strchr(line, '\n');
+        if (next != NULL) *next++ = '\0';
+        if (!SetScenarioLine(&scenario, line)) TraceLog(LOG_WARNING, "SCENARIO: [%s] Line %d ignored: %s", fileName, lineNumber, line);
+        line = next;
+        lineNumber++;
+    }
+    UnloadFileText(text);
+
+    TraceLog(LOG_INFO, "SCENARIO: [%s] Scenario '%s' loaded, %d counts, %d ramps", fileName, scenario.name,
+             scenario.countCount, scenario.rampCount);
+    return scenario;
+}
+
+// Apply one scenario line, returns false if it can't be parsed.
+// Empty lines and comments are accepted, a later count of the same key replaces the earlier one.
+bool SetScenarioLine(Scenario *scenario, const char *line) {
+    char key[SCENARIO_KEY_LENGTH] = { 0 };
+    char value[64] = { 0 };
+    char *comment = strchr(line, '#');
+    int length = (comment != NULL) ? (int)(comment - line) : (int)strlen(line);
+    char text[256] = { 0 };
+    snprintf(text, sizeof(text), "%.*s", length, line);
+
+    int fields = sscanf(text, "%31s %63s", key, value);
+    if (fields <= 0) return true;
+    if (fields != 2) return false;
+
+    if (strcmp(key, "name") == 0) {
+        snprintf(scenario->name, sizeof(scenario->name), "%s", value);
+        return true;
+    }
+
+    if (strcmp(key, "seed") == 0) return (sscanf(value, "%u", &scenario->seed) == 1);
+
+    if (strcmp(key, "ramp") == 0) {
+        ScenarioRamp ramp = { 0 };
+        ramp.limit = SCENARIO_DEFAULT_RAMP_LIMIT;
+        if (sscanf(text, "%*s %31s %d %f %d", ramp.key, &ramp.amount, &ramp.interval, &ramp.limit) < 3) return false;
+        if ((ramp.amount <= 0) || (ramp.interval <= 0.0f) || (ramp.limit < 0)) return false;
+        if (scenario->rampCount >= SCENARIO_MAX_RAMPS) return false;
+        scenario->ramps[scenario->rampCount++] = ramp;
+        return true;
+    }
+
+    int count = 0;
+    if ((sscanf(value, "%d", &count) != 1) || (count < 0)) return false;
+    for (int i = 0; i < scenario->countCount; i++) {
+        if (strcmp(scenario->counts[i].key, key) == 0) {
+            scenario->counts[i].value = count;
+            return true;
+        }
+    }
+    if (scenario->countCount >= SCENARIO_MAX_COUNTS) return false;
+    ScenarioCount *entry = &scenario->counts[scenario->countCount++];
+    snprintf(entry->key, sizeof(entry->key), "%s", key);
+    entry->value = count;
+    return true;
+}
+
+// Get the startup count of a key
+int GetScenarioCount(const Scenario *scenario, const char *key, int defaultValue) {
+    for (int i = 0; i < scenario->countCount; i++) {
+        if (strcmp(scenario->counts[i].key, key) == 0) return scenario->counts[i].value;
+    }
+    return defaultValue;
+}
+
+// Get the startup count plus every ramp limit of a key, the most entities the scenario asks for
+int GetScenarioMaxCount(const Scenario *scenario, const char *key, int defaultValue) {
+    int count = GetScenarioCount(scenario, key, defaultValue);
+    for (int i = 0; i < scenario->rampCount; i++) {
+        if (strcmp(scenario->ramps[i].key, key) == 0) count += scenario->ramps[i].limit;
+    }
+    return count;
+}
+
+// Get the entities a ramp adds at a simulated time, counts them as added.
+// A ramp steps at interval, 2*interval, ... so a late call catches up on every step it missed.
+int UpdateScenarioRamp(ScenarioRamp *ramp, double time) {
+    long long due = (long long)(time/ramp->interval)*ramp->amount;
+    if (due > ramp->limit) due = ramp->limit;
+    int count = (int)due - ramp->added;
+    if (count <= 0) return 0;
+    ramp->added += count;
+    return count;
+}
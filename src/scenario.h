@@ -0,0 +1,55 @@
+// Stress scenarios
+// A scenario overrides the entity counts spawned at startup and can ramp them up while the game
+// runs, to find where each subsystem stops scaling without recompiling. Scenarios are text files
+// of "key value" lines ('#' comments), single lines can also be given on the command line:
+//
+//     name chicken_ramp
+//     seed 42                       # Random seed of the spawns
+//     chicken 500                   # Startup count of an entity
+//     tree 2000
+//     ramp chicken 100 10 5000      # Add 100 every 10 simulated seconds, 5000 more at most
+//
+// The keys are left to the game (see the scenario section of main.c), this module only stores
+// them. Ramps are driven by simulated time so a run with a fixed timestep spawns identically.
+
+#ifndef SCENARIO_H
+#define SCENARIO_H
+
+#include "raylib.h"
+
+#define SCENARIO_MAX_COUNTS 32
+#define SCENARIO_MAX_RAMPS 16
+#define SCENARIO_KEY_LENGTH 32
+#define SCENARIO_DEFAULT_RAMP_LIMIT 10000   // Entities a ramp adds at most when no limit is given
+
+// Startup count of one entity key
+typedef struct {
+    char key[SCENARIO_KEY_LENGTH];
+    int value;
+} ScenarioCount;
+
+// Periodic spawn of one entity key
+typedef struct {
+    char key[SCENARIO_KEY_LENGTH];
+    int amount;            // Entities added every interval
+    float interval;        // Simulated seconds between steps
+    int limit;             // Entities the ramp adds in total
+    int added;             // Entities handed out so far
+} ScenarioRamp;
+
+typedef struct {
+    char name[64];
+    unsigned int seed;     // 0 keeps the current random state
+    ScenarioCount counts[SCENARIO_MAX_COUNTS];
+    int countCount;
+    ScenarioRamp ramps[SCENARIO_MAX_RAMPS];
+    int rampCount;
+} Scenario;
+
+Scenario LoadScenario(const char *fileName);                                 // Load a scenario file (empty "default" scenario on failure)
+bool SetScenarioLine(Scenario *scenario, const char *line);                  // Apply one scenario line, returns false if it can't be parsed
+int GetScenarioCount(const Scenario *scenario, const char *key, int defaultValue); // Get the startup count of a key
+int GetScenarioMaxCount(const Scenario *scenario, const char *key, int defaultValue); // Get the startup count plus every ramp limit of a key
+int UpdateScenarioRamp(ScenarioRamp *ramp, double time);                     // Get the entities a ramp adds at a simulated time, counts them as added
+
+#endif // SCENARIO_H
@@ -0,0 +1,169 @@
+#include "spatial_hash.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+// Get the bucket of a cell
+static int GetBucketIndex(const SpatialHash *hash, int cellX, int cellZ) {
+    unsigned int h = ((unsigned int)cellX*73856093u) ^ ((unsigned int)cellZ*19349663u);
+    return (int)(h & (unsigned int)(hash->bucketCount - 1));
+}
+
+// Get the cell containing a world coordinate
+static int GetCellCoord(const SpatialHash *hash, float value) {
+    return (int)floorf(value/hash->cellSize);
+}
+
+// Take an entry from the pool, growing it if needed
+static int AllocEntry(SpatialHash *hash) {
+    if (hash->freeEntry != -1) {
+        int entry = hash->freeEntry;
+        hash->freeEntry = hash->entries[entry].next;
+        return entry;
+    }
+
+    if (hash->entryCount == hash->entryCapacity) {
+        int newCapacity = hash->entryCapacity*2;
+        SpatialHashEntry *entries = (SpatialHashEntry *)MemRealloc(hash->entries, newCapacity*sizeof(SpatialHashEntry));
+        if (entries == NULL) {
+            TraceLog(LOG_ERROR, "SPATIAL: Failed to grow entry pool to %d entries", newCapacity);
+            return -1;
+        }
+        hash->entries = entries;
+        hash->entryCapacity = newCapacity;
+    }
+
+    return hash->entryCount++;
+}
+
+// Link an entry at the head of its cell bucket
+static void LinkEntry(SpatialHash *hash, int entry) {
+    int bucket = GetBucketIndex(hash, hash->entries[entry].cellX, hash->entries[entry].cellZ);
+    hash->entries[entry].prev = -1;
+    hash->entries[entry].next = hash->buckets[bucket];
+    if (hash->buckets[bucket] != -1) hash->entries[hash->buckets[bucket]].prev = entry;
+    hash->buckets[bucket] = entry;
+}
+
+// Unlink an entry from its cell bucket
+static void UnlinkEntry(SpatialHash *hash, int entry) {
+    SpatialHashEntry *e = &hash->entries[entry];
+    if (e->prev != -1) hash->entries[e->prev].next = e->next;
+    else hash->buckets[GetBucketIndex(hash, e->cellX, e->cellZ)] = e->next;
+    if (e->next != -1) hash->entries[e->next].prev = e->prev;
+}
+
+// Add an entry for an id in a cell
+static int AddEntry(SpatialHash *hash, int id, int cellX, int cellZ) {
+    int entry = AllocEntry(hash);
+    if (entry == -1) return -1;
+
+    hash->entries[entry].id = id;
+    hash->entries[entry].cellX = cellX;
+    hash->entries[entry].cellZ = cellZ;
+    LinkEntry(hash, entry);
+
+    return entry;
+}
+
+// Compare function for sorting query results
+static int CompareIds(const void *a, const void *b) {
+    return *(const int *)a - *(const int *)b;
+}
+
+// Create an empty hash (bucketCount is rounded up to a power of two)
+SpatialHash LoadSpatialHash(float cellSize, int bucketCount, int entryCapacity) {
+    SpatialHash hash = { 0 };
+    hash.cellSize = cellSize;
+    hash.bucketCount = 1;
+    while (hash.bucketCount < bucketCount) hash.bucketCount *= 2;
+    hash.buckets = (int *)MemAlloc(hash.bucketCount*sizeof(int));
+    hash.entryCapacity = (entryCapacity > 0) ? entryCapacity : 1;
+    hash.entries = (SpatialHashEntry *)MemAlloc(hash.entryCapacity*sizeof(SpatialHashEntry));
+    ClearSpatialHash(&hash);
+
+    return hash;
+}
+
+// Free the hash memory
+void UnloadSpatialHash(SpatialHash *hash) {
+    MemFree(hash->buckets);
+    MemFree(hash->entries);
+    *hash = (SpatialHash){ 0 };
+}
+
+// Remove every entry
+void ClearSpatialHash(SpatialHash *hash) {
+    for (int i = 0; i < hash->bucketCount; i++) hash->buckets[i] = -1;
+    hash->entryCount = 0;
+    hash->freeEntry = -1;
+}
+
+// Register a point, returns its entry handle
+int SpatialHashInsert(SpatialHash *hash, int id, Vector3 position) {
+    return AddEntry(hash, id, GetCellCoord(hash, position.x), GetCellCoord(hash, position.z));
+}
+
+// Register a static circle in every cell it covers
+void SpatialHashInsertCircle(SpatialHash *hash, int id, Vector3 position, float radius) {
+    int minX = GetCellCoord(hash, position.x - radius), maxX = GetCellCoord(hash, position.x + radius);
+    int minZ = GetCellCoord(hash, position.z - radius), maxZ = GetCellCoord(hash, position.z + radius);
+
+    for (int z = minZ; z <= maxZ; z++) {
+        for (int x = minX; x <= maxX; x++) AddEntry(hash, id, x, z);
+    }
+}
+
+// Move a point entry, only relinks when the cell changes
+void SpatialHashMove(SpatialHash *hash, int entry, Vector3 position) {
+    if (entry < 0) return;
+
+    int cellX = GetCellCoord(hash, position.x);
+    int cellZ = GetCellCoord(hash, position.z);
+    if ((cellX == hash->entries[entry].cellX) && (cellZ == hash->entries[entry].cellZ)) return;
+
+    UnlinkEntry(hash, entry);
+    hash->entries[entry].cellX = cellX;
+    hash->entries[entry].cellZ = cellZ;
+    LinkEntry(hash, entry);
+}
+
+// Unregister an entry
+void SpatialHashRemove(SpatialHash *hash, int entry) {
+    if (entry < 0) return;
+
+    UnlinkEntry(hash, entry);
+    hash->entries[entry].next = hash->freeEntry;
+    hash->freeEntry = entry;
+}
+
+// Get the ids in the cells overlapping a circle (sorted, no duplicates).
+// Returns the number of ids written. When the cells hold more than maxIds entries nothing usable is
+// written and the entry count is returned instead (more than maxIds), the buffer size that fits them.
+int SpatialHashQuery(const SpatialHash *hash, Vector3 position, float radius, int *ids, int maxIds) {
+    int minX = GetCellCoord(hash, position.x - radius), maxX = GetCellCoord(hash, position.x + radius);
+    int minZ = GetCellCoord(hash, position.z - radius), maxZ = GetCellCoord(hash, position.z + radius);
+
+    int count = 0;
+    for (int z = minZ; z <= maxZ; z++) {
+        for (int x = minX; x <= maxX; x++) {
+            for (int e = hash->buckets[GetBucketIndex(hash, x, z)]; e != -1; e = hash->entries[e].next) {
+                if ((hash->entries[e].cellX != x) || (hash->entries[e].cellZ != z)) continue; // Other cell in the same bucket
+                if (count < maxIds) ids[count] = hash->entries[e].id;
+                count++;
+            }
+        }
+    }
+
+    // Too many for the buffer: only count them, the caller retries with a larger one
+    if (count > maxIds) return count;
+
+    // Callers rely on index order (first hit wins), static circles may appear in several cells
+    qsort(ids, count, sizeof(int), CompareIds);
+    int unique = 0;
+    for (int i = 0; i < count; i++) {
+        if ((unique == 0) || (ids[unique - 1] != ids[i])) ids[unique++] = ids[i];
+    }
+
+    return unique;
+}
@@ -0,0 +1,40 @@
+// Uniform spatial hash over the XZ plane
+// Objects are referenced by the caller's index (id). Moving objects are registered as points and
+// moved incrementally, static objects are registered in every cell their collision circle covers.
+// Queries return the ids found in the cells overlapping a circle, the caller does the exact test.
+
+#ifndef SPATIAL_HASH_H
+#define SPATIAL_HASH_H
+
+#include "raylib.h"
+
+typedef struct {
+    int id;              // Caller's object index
+    int cellX;
+    int cellZ;
+    int prev;            // Previous entry in the bucket, -1 if first
+    int next;            // Next entry in the bucket (or in the free list), -1 if last
+} SpatialHashEntry;
+
+typedef struct {
+    float cellSize;
+    int bucketCount;            // Power of two
+    int *buckets;               // First entry of each bucket, -1 if empty
+    SpatialHashEntry *entries;  // Entry pool, grows as needed
+    int entryCapacity;
+    int entryCount;             // Entries ever taken from the pool
+    int freeEntry;              // First released entry, -1 if none
+} SpatialHash;
+
+SpatialHash LoadSpatialHash(float cellSize, int bucketCount, int entryCapacity); // Create an empty hash (bucketCount is rounded up to a power of two)
+void UnloadSpatialHash(SpatialHash *hash);                                        // Free the hash memory
+void ClearSpatialHash(SpatialHash *hash);                                         // Remove every entry
+
+int SpatialHashInsert(SpatialHash *hash, int id, Vector3 position);               // Register a point, returns its entry handle
+void SpatialHashInsertCircle(SpatialHash *hash, int id, Vector3 position, float radius); // Register a static circle in every cell it covers
+void SpatialHashMove(SpatialHash *hash, int entry, Vector3 position);             // Move a point entry, only relinks when the cell changes
+void SpatialHashRemove(SpatialHash *hash, int entry);                             // Unregister an entry
+
+int SpatialHashQuery(const SpatialHash *hash, Vector3 position, float radius, int *ids, int maxIds); // Get the ids in the cells overlapping a circle (sorted, no duplicates), more than maxIds: the size needed
+
+#endif // SPATIAL_HASH_H
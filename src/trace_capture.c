@@ -0,0 +1,168 @@
+#include "trace_capture.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+    #define TRACE_THREAD_LOCAL __declspec(thread)
+#else
+    #define TRACE_THREAD_LOCAL _Thread_local
+#endif
+
+#define TRACE_NAME_LENGTH 64
+#define TRACE_MAX_THREADS 32
+
+// Recorded event, the name is copied so callers may pass temporary strings (file names, TextFormat())
+typedef struct {
+    char name[TRACE_NAME_LENGTH];
+    const char *category;        // Static string
+    char phase;                  // 'X' span, 'i' instant
+    int threadId;
+    double startTime;            // Seconds, GetTime()
+    double duration;
+} TraceEvent;
+
+static TraceEvent *events = NULL;
+static volatile long eventCount = 0;             // Slots claimed, may exceed TRACE_MAX_EVENTS (the rest is dropped)
+static volatile long capturing = 0;
+static double captureStartTime = 0.0;
+
+static const char *threadNames[TRACE_MAX_THREADS] = { 0 };
+static volatile long threadCount = 0;
+static TRACE_THREAD_LOCAL int traceThreadId = -1;
+
+//----------------------------------------------------------------------------------
+// Atomics
+//----------------------------------------------------------------------------------
+#if defined(_MSC_VER)
+static long AtomicLoad(volatile long *ptr) { return _InterlockedOr(ptr, 0); }
+static void AtomicStore(volatile long *ptr, long value) { _InterlockedExchange(ptr, value); }
+static long AtomicFetchAdd(volatile long *ptr) { return _InterlockedIncrement(ptr) - 1; }
+#else
+static long AtomicLoad(volatile long *ptr) { return __atomic_load_n(ptr, __ATOMIC_ACQUIRE); }
+static void AtomicStore(volatile long *ptr, long value) { __atomic_store_n(ptr, value, __ATOMIC_RELEASE); }
+static long AtomicFetchAdd(volatile long *ptr) { return __atomic_fetch_add(ptr, 1, __ATOMIC_RELAXED); }
+#endif
+
+// Get the trace thread id of the calling thread, assigned on first use
+static int GetTraceThreadId(void) {
+    if (traceThreadId == -1) traceThreadId = (int)AtomicFetchAdd(&threadCount);
+    return traceThreadId;
+}
+
+// Claim an event slot, NULL when not capturing or the buffer is full
+static TraceEvent *ClaimEvent(void) {
+    if (!AtomicLoad(&capturing)) return NULL;
+
+    long index = AtomicFetchAdd(&eventCount);
+    return (index < TRACE_MAX_EVENTS) ? &events[index] : NULL;
+}
+
+// Write a string as a JSON string literal
+static void WriteJsonString(FILE *file, const char *text) {
+    fputc('"', file);
+    for (const char *c = text; *c != '\0'; c++) {
+        if ((*c == '"') || (*c == '\\')) fputc('\\', file);
+        if ((unsigned char)*c >= 0x20) fputc(*c, file);
+    }
+    fputc('"', file);
+}
+
+// Start recording events into memory
+void StartTraceCapture(void) {
+    if (AtomicLoad(&capturing)) return;
+
+    if (events == NULL) events = (TraceEvent *)MemAlloc(TRACE_MAX_EVENTS*sizeof(TraceEvent));
+    if (events == NULL) {
+        TraceLog(LOG_WARNING, "TRACE: Failed to allocate the event buffer");
+        return;
+    }
+
+    AtomicStore(&eventCount, 0);
+    captureStartTime = GetTime();
+    AtomicStore(&capturing, 1);
+    TraceLog(LOG_INFO, "TRACE: Capture started");
+}
+
+// Stop recording and write the JSON trace (call when no other thread records)
+void StopTraceCapture(const char *fileName) {
+    if (!AtomicLoad(&capturing)) return;
+    AtomicStore(&capturing, 0);
+
+    long claimed = AtomicLoad(&eventCount);
+    int count = (claimed < TRACE_MAX_EVENTS) ? (int)claimed : TRACE_MAX_EVENTS;
+    double captureDuration = GetTime() - captureStartTime;
+
+    FILE *file = fopen(fileName, "w");
+    if (file == NULL) TraceLog(LOG_WARNING, "TRACE: [%s] Failed to open file for writing", fileName);
+    else {
+        fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+        int threads = (int)AtomicLoad(&threadCount);
+        if (threads > TRACE_MAX_THREADS) threads = TRACE_MAX_THREADS;
+        for (int t = 0; t < threads; t++) {
+            fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":", t);
+            WriteJsonString(file, (threadNames[t] != NULL) ? threadNames[t] : TextFormat("Thread %d", t));
+            fprintf(file, "}},\n");
+        }
+
+        // Timestamps in microseconds from the start of the capture
+        for (int i = 0; i < count; i++) {
+            const TraceEvent *event = &events[i];
+            fprintf(file, "{\"name\":");
+            WriteJsonString(file, event->name);
+            fprintf(file, ",\"cat\":\"%s\",\"ph\":\"%c\",\"pid\":1,\"tid\":%d,\"ts\":%.3f", event->category, event->phase,
+                    event->threadId, (event->startTime - captureStartTime)*1e6);
+            if (event->phase == 'X') fprintf(file, ",\"dur\":%.3f}", event->duration*1e6);
+            else fprintf(file, ",\"s\":\"g\"}");
+            fprintf(file, "%s\n", (i < count - 1) ? "," : "");
+        }
+
+        fprintf(file, "]}\n");
+        fclose(file);
+        TraceLog(LOG_INFO, "TRACE: [%s] Wrote %d events covering %.2f s", fileName, count, captureDuration);
+    }
+
+    if (claimed > TRACE_MAX_EVENTS) TraceLog(LOG_WARNING, "TRACE: Buffer full, %ld events dropped", claimed - TRACE_MAX_EVENTS);
+
+    MemFree(events);
+    events = NULL;
+}
+
+// Check if a capture is running
+bool IsTraceCapturing(void) {
+    return (AtomicLoad(&capturing) != 0);
+}
+
+// Name the calling thread in captured traces (name must stay valid)
+void SetTraceThreadName(const char *name) {
+    int id = GetTraceThreadId();
+    if (id < TRACE_MAX_THREADS) threadNames[id] = name;
+}
+
+// Record a span, times from GetTime()
+void TraceSpan(const char *name, const char *category, double startTime, double endTime) {
+    TraceEvent *event = ClaimEvent();
+    if (event == NULL) return;
+
+    snprintf(event->name, sizeof(event->name), "%s", name);
+    event->category = category;
+    event->phase = 'X';
+    event->threadId = GetTraceThreadId();
+    event->startTime = startTime;
+    event->duration = endTime - startTime;
+}
+
+// Record an instant event at the current time
+void TraceMarker(const char *name, const char *category) {
+    TraceEvent *event = ClaimEvent();
+    if (event == NULL) return;
+
+    snprintf(event->name, sizeof(event->name), "%s", name);
+    event->category = category;
+    event->phase = 'i';
+    event->threadId = GetTraceThreadId();
+    event->startTime = GetTime();
+    event->duration = 0.0;
+}
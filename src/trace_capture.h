@@ -0,0 +1,24 @@
+// Chrome trace event capture
+// While a capture runs, spans (profiler zones, asset loads) and instant markers (game events)
+// are appended to a preallocated in-memory buffer from any thread. Nothing touches the disk
+// until StopTraceCapture() writes the buffer as a JSON trace that chrome://tracing and
+// ui.perfetto.dev can open.
+
+#ifndef TRACE_CAPTURE_H
+#define TRACE_CAPTURE_H
+
+#include "raylib.h"
+
+#define TRACE_MAX_EVENTS 131072      // Events per capture, later events are dropped and counted
+
+void StartTraceCapture(void);                        // Start recording events into memory
+void StopTraceCapture(const char *fileName);         // Stop recording and write the JSON trace (call when no other thread records)
+bool IsTraceCapturing(void);                         // Check if a capture is running
+
+void SetTraceThreadName(const char *name);           // Name the calling thread in captured traces (name must stay valid)
+
+// Names are copied, categories must be static strings
+void TraceSpan(const char *name, const char *category, double startTime, double endTime); // Record a span, times from GetTime()
+void TraceMarker(const char *name, const char *category); // Record an instant event at the current time
+
+#endif // TRACE_CAPTURE_H